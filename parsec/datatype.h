@@ -107,6 +107,35 @@ int parsec_type_create_resized(parsec_datatype_t oldtype,
                                ptrdiff_t lb,
                                ptrdiff_t extent,
                                parsec_datatype_t *newtype);
+int parsec_type_create_hindexed(int count,
+                                const int array_of_blocklengths[],
+                                const ptrdiff_t array_of_displacements[],
+                                parsec_datatype_t oldtype,
+                                parsec_datatype_t *newtype);
+
+/**
+ * A contiguous block of memory, described by its displacement (in bytes)
+ * from the beginning of a datatype and its length (in bytes).
+ */
+typedef struct parsec_iovec_s {
+    ptrdiff_t displ;
+    size_t    length;
+} parsec_iovec_t;
+
+/**
+ * Flatten count consecutive instances of a datatype into the list of the
+ * contiguous memory blocks it spans, in the order in which they appear in
+ * the packed representation of the data. Adjacent blocks are merged.
+ * @param[in] parsec_datatype_t datatype
+ * @param[in] int count
+ * @param[out] parsec_iovec_t** the array of blocks, allocated with malloc and
+ *             to be released by the caller.
+ * @param[out] int* the number of blocks
+ * @return PARSEC_SUCCESS, or PARSEC_ERR_NOT_SUPPORTED if the datatype
+ *         cannot be flattened.
+ */
+int parsec_type_flatten(parsec_datatype_t type, int count,
+                        parsec_iovec_t **iov, int *niov);
 
 /**
  * Routine to check if two datatypes represent the same data extraction.
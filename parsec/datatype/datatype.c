@@ -5,6 +5,7 @@
  */
 #include "parsec/runtime.h"
 #include "parsec/datatype.h"
+#include <stdlib.h>
 
 /**
  * Map the datatype creation to the well designed and well known MPI datatype
@@ -139,6 +140,33 @@ int parsec_type_create_resized(parsec_datatype_t oldtype,
     return PARSEC_SUCCESS;
 }
 
+int parsec_type_create_hindexed(int count,
+                               const int array_of_blocklengths[],
+                               const ptrdiff_t array_of_displacements[],
+                               parsec_datatype_t oldtype,
+                               parsec_datatype_t *newtype)
+{
+    /* Used to describe slices of the memory, which requires a real datatype engine */
+    *newtype = PARSEC_DATATYPE_NULL;
+    (void)count; (void)array_of_blocklengths; (void)array_of_displacements; (void)oldtype;
+    return PARSEC_ERR_NOT_IMPLEMENTED;
+}
+
+int parsec_type_flatten(parsec_datatype_t type, int count,
+                        parsec_iovec_t **iov, int *niov)
+{
+    int size, rc;
+
+    /* Without MPI only the basic types exist, and they are all contiguous */
+    rc = parsec_type_size(type, &size);
+    if( PARSEC_SUCCESS != rc ) return rc;
+    *iov = (parsec_iovec_t*)malloc(sizeof(parsec_iovec_t));
+    (*iov)->displ  = 0;
+    (*iov)->length = (size_t)size * count;
+    *niov = 1;
+    return PARSEC_SUCCESS;
+}
+
 int parsec_type_match(parsec_datatype_t dtt1,
                       parsec_datatype_t dtt2){
     (void)dtt1; (void)dtt2;
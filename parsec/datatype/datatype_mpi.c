@@ -6,6 +6,7 @@
 
 #include "parsec/parsec_config.h"
 #include "parsec/datatype.h"
+#include <stdlib.h>
 
 #if !defined(PARSEC_HAVE_MPI)
 #error __FILE__ should only be used when MPI support is enabled.
@@ -146,6 +147,163 @@ parsec_type_create_resized( parsec_datatype_t oldtype,
     return (MPI_SUCCESS == rc ? PARSEC_SUCCESS : PARSEC_ERROR);
 }
 
+int
+parsec_type_create_hindexed( int count,
+                             const int array_of_blocklengths[],
+                             const ptrdiff_t array_of_displacements[],
+                             parsec_datatype_t oldtype,
+                             parsec_datatype_t *newtype )
+{
+    MPI_Aint* displs = (MPI_Aint*)malloc(count * sizeof(MPI_Aint));
+    int rc;
+
+    for( int i = 0; i < count; i++ )
+        displs[i] = array_of_displacements[i];
+    rc = MPI_Type_create_hindexed( count, array_of_blocklengths, displs,
+                                   oldtype, newtype );
+    free(displs);
+    if( MPI_SUCCESS != rc ) return PARSEC_ERROR;
+    rc = MPI_Type_commit(newtype);
+    return (MPI_SUCCESS == rc ? PARSEC_SUCCESS : PARSEC_ERROR);
+}
+
+typedef struct parsec_iovec_list_s {
+    parsec_iovec_t *iov;
+    int             niov;
+    int             size;
+} parsec_iovec_list_t;
+
+static void
+parsec_iovec_list_append(parsec_iovec_list_t* list, ptrdiff_t displ, size_t length)
+{
+    if( 0 == length ) return;
+    if( (0 != list->niov) &&
+        (list->iov[list->niov-1].displ + (ptrdiff_t)list->iov[list->niov-1].length == displ) ) {
+        list->iov[list->niov-1].length += length;
+        return;
+    }
+    if( list->niov == list->size ) {
+        list->size = (0 == list->size) ? 16 : 2 * list->size;
+        list->iov = (parsec_iovec_t*)realloc(list->iov, list->size * sizeof(parsec_iovec_t));
+    }
+    list->iov[list->niov].displ  = displ;
+    list->iov[list->niov].length = length;
+    list->niov++;
+}
+
+static int
+parsec_type_flatten_rec(MPI_Datatype type, ptrdiff_t displ, int count,
+                        parsec_iovec_list_t* list);
+
+/* Decode one instance of a derived datatype starting at displ */
+static int
+parsec_type_flatten_one(MPI_Datatype type, ptrdiff_t displ,
+                        parsec_iovec_list_t* list)
+{
+    int ni, na, nd, combiner, rc = PARSEC_SUCCESS;
+    int *ints;
+    MPI_Aint *addrs;
+    MPI_Datatype *types;
+    ptrdiff_t lb, extent;
+
+    MPI_Type_get_envelope(type, &ni, &na, &nd, &combiner);
+    if( MPI_COMBINER_NAMED == combiner )  /* a predefined type with holes */
+        return PARSEC_ERR_NOT_SUPPORTED;
+    ints  = (int*)malloc((ni + 1) * sizeof(int));
+    addrs = (MPI_Aint*)malloc((na + 1) * sizeof(MPI_Aint));
+    types = (MPI_Datatype*)malloc((nd + 1) * sizeof(MPI_Datatype));
+    MPI_Type_get_contents(type, ni, na, nd, ints, addrs, types);
+    if( nd > 0 ) parsec_type_extent(types[0], &lb, &extent);
+
+    switch( combiner ) {
+    case MPI_COMBINER_DUP:
+        rc = parsec_type_flatten_rec(types[0], displ, 1, list);
+        break;
+    case MPI_COMBINER_CONTIGUOUS:
+        rc = parsec_type_flatten_rec(types[0], displ, ints[0], list);
+        break;
+    case MPI_COMBINER_VECTOR:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + (ptrdiff_t)i * ints[2] * extent, ints[1], list);
+        break;
+    case MPI_COMBINER_HVECTOR:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + (ptrdiff_t)i * addrs[0], ints[1], list);
+        break;
+    case MPI_COMBINER_INDEXED:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + (ptrdiff_t)ints[1 + ints[0] + i] * extent, ints[1 + i], list);
+        break;
+    case MPI_COMBINER_HINDEXED:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + addrs[i], ints[1 + i], list);
+        break;
+    case MPI_COMBINER_INDEXED_BLOCK:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + (ptrdiff_t)ints[2 + i] * extent, ints[1], list);
+        break;
+#if defined(PARSEC_HAVE_MPI_30)
+    case MPI_COMBINER_HINDEXED_BLOCK:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[0], displ + addrs[i], ints[1], list);
+        break;
+#endif  /* defined(PARSEC_HAVE_MPI_30) */
+    case MPI_COMBINER_STRUCT:
+        for( int i = 0; (PARSEC_SUCCESS == rc) && (i < ints[0]); i++ )
+            rc = parsec_type_flatten_rec(types[i], displ + addrs[i], ints[1 + i], list);
+        break;
+    case MPI_COMBINER_RESIZED:
+        rc = parsec_type_flatten_rec(types[0], displ, 1, list);
+        break;
+    default:
+        rc = PARSEC_ERR_NOT_SUPPORTED;
+    }
+
+    for( int i = 0; i < nd; i++ ) {
+        int dni, dna, dnd, dcombiner;
+        MPI_Type_get_envelope(types[i], &dni, &dna, &dnd, &dcombiner);
+        if( MPI_COMBINER_NAMED != dcombiner )
+            MPI_Type_free(&types[i]);
+    }
+    free(ints); free(addrs); free(types);
+    return rc;
+}
+
+static int
+parsec_type_flatten_rec(MPI_Datatype type, ptrdiff_t displ, int count,
+                        parsec_iovec_list_t* list)
+{
+    ptrdiff_t lb, extent;
+    int size, rc = PARSEC_SUCCESS;
+
+    parsec_type_size(type, &size);
+    parsec_type_extent(type, &lb, &extent);
+    /* Dense datatypes, including all the predefined ones, are a single block */
+    if( (0 == lb) && ((ptrdiff_t)size == extent) ) {
+        parsec_iovec_list_append(list, displ, (size_t)size * count);
+        return PARSEC_SUCCESS;
+    }
+    for( int i = 0; (PARSEC_SUCCESS == rc) && (i < count); i++ )
+        rc = parsec_type_flatten_one(type, displ + (ptrdiff_t)i * extent, list);
+    return rc;
+}
+
+int
+parsec_type_flatten( parsec_datatype_t type, int count,
+                     parsec_iovec_t **iov, int *niov )
+{
+    parsec_iovec_list_t list = { .iov = NULL, .niov = 0, .size = 0 };
+    int rc = parsec_type_flatten_rec(type, 0, count, &list);
+
+    if( PARSEC_SUCCESS != rc ) {
+        free(list.iov);
+        return rc;
+    }
+    *iov  = list.iov;
+    *niov = list.niov;
+    return PARSEC_SUCCESS;
+}
+
 int parsec_type_match(parsec_datatype_t dtt1,
                       parsec_datatype_t dtt2)
 {
@@ -57,18 +57,27 @@
 #include "parsec/utils/debug.h"
 #include "parsec/data_distribution.h"
 #include "parsec/utils/backoff.h"
+#include "parsec/include/parsec/os-spec-timing.h"
 
 /* This allows DTD to have a separate stream for debug verbose output */
 int parsec_dtd_debug_output;
 static int parsec_dtd_debug_verbose = -1;
 
-static int parsec_dtd_profile_verbose = 0;
+int parsec_dtd_profile_verbose = 0;
 
 static parsec_dc_key_t parsec_dtd_dc_id = 0;
 int32_t __parsec_dtd_is_initialized = 0; /**< Indicates init of dtd environment is completed */
 
 int parsec_dtd_window_size             = 8000;   /**< Default window size */
 int parsec_dtd_threshold_size          = 4000;   /**< Default threshold size of tasks for master thread to wait on */
+int parsec_dtd_window_adaptive         = 0;      /**< Adapt the window size to the runtime behavior */
+int parsec_dtd_window_min_size         = 64;     /**< Smallest size of an adaptive window */
+int parsec_dtd_window_max_memory       = 0;      /**< Memory of the local tasks in flight, in MB, above which
+                                                  *   an adaptive window shrinks (0: unbounded) */
+int parsec_dtd_inline_max_duration    = 0;      /**< Longest measured body duration (ns) of the ready tasks
+                                                  *   the inserter executes itself (0: none) */
+int parsec_dtd_flush_batch_size        = 0;      /**< Tiles flushed together by parsec_dtd_data_flush_all()
+                                                  *   (0: each tile separately) */
 static int parsec_dtd_task_hash_table_size = 1<<16; /**< Default task hash table size */
 static int parsec_dtd_tile_hash_table_size = 1<<16; /**< Default tile hash table size */
 
@@ -290,6 +299,19 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_task_t, parsec_task_t,
 PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_tile_t, parsec_list_item_t,
                           NULL, NULL);
 
+static void
+parsec_dtd_tile_table_construct(parsec_dtd_tile_table_t *table)
+{
+    table->nb_removals = 0;
+    memset(table->caches, 0, sizeof(table->caches));
+}
+
+/* To create object of class parsec_dtd_tile_table_t that inherits
+ * parsec_hash_table_t class
+ */
+PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_tile_table_t, parsec_hash_table_t,
+                          parsec_dtd_tile_table_construct, NULL);
+
 /***************************************************************************//**
  *
  * Constructor of PaRSEC's DTD taskpool.
@@ -423,6 +445,8 @@ parsec_dtd_taskpool_destructor(parsec_dtd_taskpool_t *tp)
 
     parsec_hash_table_fini(tp->function_h_table);
     PARSEC_OBJ_RELEASE(tp->function_h_table);
+
+    free(tp->tracked_ranks);
 }
 
 /* To create object of class parsec_dtd_taskpool_t that inherits parsec_taskpool_t
@@ -460,6 +484,20 @@ PARSEC_OBJ_CLASS_INSTANCE(parsec_dtd_taskpool_t, parsec_taskpool_t,
  *                                          thread will wait before going
  *                                          back and inserting task into the
  *                                          engine.
+ *  - dtd_window_adaptive (default=0 off):  Adapts the window size between
+ *                                          dtd_window_min_size and
+ *                                          parsec_dtd_window_size, from the
+ *                                          ready tasks, the idle time and
+ *                                          the memory in flight.
+ *  - dtd_window_max_memory (default=0):    The memory of the local tasks in
+ *                                          flight (in MB) above which the
+ *                                          adaptive window shrinks.
+ *  - dtd_inline_max_duration (default=0):  The ready tasks whose bodies last
+ *                                          at most this many ns (on average)
+ *                                          are executed by their inserter.
+ *  - dtd_flush_batch_size (default=0):     The tiles flushed together by
+ *                                          parsec_dtd_data_flush_all(), with
+ *                                          one task per rank involved.
  * @ingroup DTD_INTERFACE
  */
 static void
@@ -495,6 +533,29 @@ parsec_dtd_lazy_init(void)
                                         "Registers the supplied size overriding the default size of threshold size",
                                         false, false, parsec_dtd_threshold_size, &parsec_dtd_threshold_size);
 
+    /* Registering mca params for the adaptive window */
+    (void)parsec_mca_param_reg_int_name("dtd", "window_adaptive",
+                                        "Adapts the window size to the ready tasks, the idle time and the memory in flight",
+                                        false, false, parsec_dtd_window_adaptive, &parsec_dtd_window_adaptive);
+    (void)parsec_mca_param_reg_int_name("dtd", "window_min_size",
+                                        "Smallest size of an adaptive window",
+                                        false, false, parsec_dtd_window_min_size, &parsec_dtd_window_min_size);
+    (void)parsec_mca_param_reg_int_name("dtd", "window_max_memory",
+                                        "Memory of the local tasks in flight (in MB) above which an adaptive window shrinks (0: unbounded)",
+                                        false, false, parsec_dtd_window_max_memory, &parsec_dtd_window_max_memory);
+
+    /* Registering mca param for the inline execution of small tasks */
+    (void)parsec_mca_param_reg_int_name("dtd", "inline_max_duration",
+                                        "The ready tasks whose bodies last at most this many ns on average are executed by "
+                                        "the thread inserting them, instead of going through the scheduler (0: never)",
+                                        false, false, parsec_dtd_inline_max_duration, &parsec_dtd_inline_max_duration);
+
+    /* Registering mca param for the batched flushes */
+    (void)parsec_mca_param_reg_int_name("dtd", "flush_batch_size",
+                                        "Number of tiles parsec_dtd_data_flush_all() writes back to their owner with a "
+                                        "single pair of tasks (0: each tile separately)",
+                                        false, false, parsec_dtd_flush_batch_size, &parsec_dtd_flush_batch_size);
+
     /* Registering mca param for threshold size */
     (void)parsec_mca_param_reg_int_name("dtd", "profile_verbose",
                                         "This param turns events that profiles task insertion and other dtd overheads",
@@ -563,22 +624,42 @@ extern int __parsec_task_progress(parsec_execution_stream_t *es,
  *
  * @param[in]   tp
  *                  PaRSEC dtd taskpool
+ * @param[in]   task_threshold_count
+ *                  Number of pending tasks to reach
+ * @param[out]  idle_permille
+ *                  If not NULL, the part (per mille) of the time spent
+ *                  without a task to execute
  *
  * @ingroup     DTD_INTERFACE_INTERNAL
  */
-void
-parsec_execute_and_come_back(parsec_taskpool_t *tp,
-                             int task_threshold_count)
+static void
+__parsec_execute_and_come_back(parsec_taskpool_t *tp,
+                               int task_threshold_count,
+                               int *idle_permille)
 {
     uint64_t misses_in_a_row;
     parsec_execution_stream_t *es = parsec_my_execution_stream();
     parsec_task_t *task;
     int rc, distance;
     struct timespec rqtp;
+    parsec_time_t start = take_time(), idle_start = start;
+    uint64_t idle = 0;
+    int idling = 0;
 
     rqtp.tv_sec = 0;
     misses_in_a_row = 1;
 
+    if( NULL == es->scheduler_object ) {
+        /* An application thread has no scheduler to execute tasks from, it
+         * waits for the PaRSEC threads to execute them. The context must
+         * have been started by the thread that initialized PaRSEC. */
+        while(tp->nb_tasks > task_threshold_count) {
+            rqtp.tv_nsec = parsec_exponential_backoff(es, misses_in_a_row++);
+            nanosleep(&rqtp, NULL);
+        }
+        return;
+    }
+
     /* Checking if the context has been started or not */
     /* The master thread might not have to trigger the barrier if the other
      * threads have been activated by a previous start.
@@ -609,12 +690,166 @@ parsec_execute_and_come_back(parsec_taskpool_t *tp,
         }
 
         if( task != NULL) {
+            if( idling ) {
+                idle += diff_time(idle_start, take_time());
+                idling = 0;
+            }
             misses_in_a_row = 0;  /* reset the misses counter */
 
             rc = __parsec_task_progress(es, task, distance);
             (void)rc;
+        } else if( NULL != idle_permille && !idling ) {
+            /* no task to execute, until the next one is found */
+            idle_start = take_time();
+            idling = 1;
+        }
+    }
+
+    if( NULL != idle_permille ) {
+        parsec_time_t end = take_time();
+        uint64_t total = diff_time(start, end);
+        if( idling ) {
+            idle += diff_time(idle_start, end);
         }
+        *idle_permille = (0 == total) ? 0 : (int)((1000 * idle) / total);
+    }
+}
+
+void
+parsec_execute_and_come_back(parsec_taskpool_t *tp,
+                             int task_threshold_count)
+{
+    __parsec_execute_and_come_back(tp, task_threshold_count, NULL);
+}
+
+/* **************************************************************************** */
+/**
+ * Lets a thread that is not a PaRSEC thread insert tasks.
+ *
+ * Such a thread borrows app_es as its execution stream until
+ * parsec_dtd_return_execution_stream(). Like the execution stream of the
+ * communication thread, app_es has no scheduler: the ready tasks are
+ * given to the first execution stream of the virtual process, the tasks
+ * are never executed inline, and the thread waits instead of executing
+ * tasks at the end of a window. PaRSEC threads keep their own stream.
+ *
+ * @param[in]   tp
+ *                  PaRSEC dtd taskpool, enqueued in a context
+ * @param[out]  app_es
+ *                  The stream to borrow, valid until it is returned
+ * @return
+ *                  1 if app_es is borrowed, 0 if the calling thread has
+ *                  a stream
+ *
+ * @ingroup     DTD_INTERFACE_INTERNAL
+ */
+int
+parsec_dtd_borrow_execution_stream(parsec_dtd_taskpool_t *tp,
+                                   parsec_execution_stream_t *app_es)
+{
+    parsec_vp_t *vp;
+
+    if( NULL != parsec_my_execution_stream() ) {
+        return 0;
+    }
+    vp = tp->super.context->virtual_processes[0];
+    memset(app_es, 0, sizeof(parsec_execution_stream_t));
+    app_es->th_id            = 0;  /* Pretend to be the master thread */
+    app_es->core_id          = -1;
+    app_es->socket_id        = -1;
+    app_es->pthread_id       = pthread_self();
+    app_es->rand_seed        = (unsigned int)(uintptr_t)app_es;
+    app_es->virtual_process  = vp;
+    app_es->scheduler_object = NULL;
+    app_es->next_task        = (parsec_task_t*)0xdeadbeef;  /* should not be NULL, but it should also never be used */
+    app_es->context_mempool  = &vp->context_mempool.thread_mempools[0];
+    for(int pi = 0; pi <= MAX_PARAM_COUNT; pi++) {
+        app_es->datarepo_mempools[pi] = &vp->datarepo_mempools[pi].thread_mempools[0];
+    }
+    app_es->dependencies_mempool = &vp->dependencies_mempool.thread_mempools[0];
+    parsec_set_my_execution_stream(app_es);
+    return 1;
+}
+
+void
+parsec_dtd_return_execution_stream(int borrowed)
+{
+    if( borrowed ) {
+        parsec_set_my_execution_stream(NULL);
+    }
+}
+
+/**
+ * Schedules a ring of ready tasks from the stream of the calling thread,
+ * on the first stream of its virtual process if it has no scheduler.
+ */
+int
+parsec_dtd_schedule(parsec_execution_stream_t *es, parsec_task_t *tasks_ring)
+{
+    if( NULL == es->scheduler_object ) {
+        return __parsec_schedule(es->virtual_process->execution_streams[0], tasks_ring, 0);
+    }
+    return __parsec_schedule(es, tasks_ring, 0);
+}
+
+/**
+ * With several processes, the tasks must be created and linked in the
+ * same order by all the processes: a single thread (and the tasks it
+ * executes meanwhile) can insert tasks at a time. The tasks inserted by
+ * a second thread would be numbered differently on each process, so it
+ * is a fatal error.
+ */
+static inline void
+parsec_dtd_inserter_enter(parsec_dtd_taskpool_t *dtd_tp, parsec_execution_stream_t *es)
+{
+    if( 1 == dtd_tp->super.context->nb_nodes ) {
+        return;
+    }
+    if( es != dtd_tp->inserter &&
+        !parsec_atomic_cas_ptr(&dtd_tp->inserter, NULL, es) ) {
+        parsec_fatal("Several threads insert tasks concurrently in DTD taskpool %d with %d processes. The tasks "
+                     "must be inserted in the same order by all processes, hence by one thread at a time\n",
+                     dtd_tp->super.taskpool_id, dtd_tp->super.context->nb_nodes);
+    }
+    dtd_tp->inserter_depth++;
+}
+
+static inline void
+parsec_dtd_inserter_leave(parsec_dtd_taskpool_t *dtd_tp)
+{
+    if( 1 == dtd_tp->super.context->nb_nodes ) {
+        return;
     }
+    if( 0 == --dtd_tp->inserter_depth ) {
+        parsec_atomic_wmb();
+        dtd_tp->inserter = NULL;
+    }
+}
+
+/**
+ * Each tile orders its tasks as their insertions reach it. The tasks
+ * linking several tiles take a ticket, and link all their tiles before the
+ * next one: two tasks can not be ordered differently on two tiles, which
+ * would make them wait for each other. The tasks with a single tile do not
+ * need a ticket. The ticket holder must not wait for the window or execute
+ * tasks until it is done, these tasks could wait for the ticket.
+ */
+void
+parsec_dtd_link_alone_begin(parsec_dtd_taskpool_t *dtd_tp, parsec_execution_stream_t *es)
+{
+    int32_t ticket = parsec_atomic_fetch_inc_int32(&dtd_tp->link_ticket_next);
+
+    while( ticket != dtd_tp->link_ticket_served ) /* nothing */;
+    parsec_atomic_rmb();
+    dtd_tp->link_holder = es;
+}
+
+void
+parsec_dtd_link_alone_end(parsec_dtd_taskpool_t *dtd_tp)
+{
+    dtd_tp->link_holder = NULL;
+    parsec_atomic_wmb();
+    dtd_tp->link_ticket_served++;
 }
 
 /* **************************************************************************** */
@@ -655,7 +890,8 @@ parsec_dtd_unpack_args(parsec_task_t *this_task, ...)
             *tmp_ref = current_param->pointer_to_tile;
         } else if((current_param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
                   (current_param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-                  (current_param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+                  (current_param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+                  (current_param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
             tmp_ref = va_arg(arguments, void**);
             *tmp_ref = PARSEC_DATA_COPY_GET_PTR(this_task->data[data_idx].data_in);
             data_idx++;
@@ -1063,7 +1299,8 @@ parsec_dtd_find_task_class_internal(parsec_dtd_taskpool_t *tp,
 {
     parsec_hash_table_t *hash_table = tp->function_h_table;
 
-    return parsec_hash_table_nolock_find(hash_table, (parsec_key_t)key);
+    /* task classes can be created concurrently by other inserting threads */
+    return parsec_hash_table_find(hash_table, (parsec_key_t)key);
 }
 
 /* **************************************************************************** */
@@ -1146,9 +1383,11 @@ parsec_dtd_tile_insert(uint64_t key,
 void
 parsec_dtd_tile_remove(parsec_data_collection_t *dc, uint64_t key)
 {
-    parsec_hash_table_t *hash_table = (parsec_hash_table_t *)dc->tile_h_table;
+    parsec_dtd_tile_table_t *table = (parsec_dtd_tile_table_t *)dc->tile_h_table;
 
-    parsec_hash_table_remove(hash_table, (parsec_key_t)key);
+    parsec_hash_table_remove(&table->super, (parsec_key_t)key);
+    /* The tile can still be in the caches of the execution streams */
+    (void)parsec_atomic_fetch_inc_int32(&table->nb_removals);
 }
 
 /* **************************************************************************** */
@@ -1218,7 +1457,7 @@ parsec_dtd_data_collection_init(parsec_data_collection_t *dc)
 {
     int nb;
 
-    dc->tile_h_table = PARSEC_OBJ_NEW(parsec_hash_table_t);
+    dc->tile_h_table = (parsec_hash_table_t *)PARSEC_OBJ_NEW(parsec_dtd_tile_table_t);
     for( nb = 1; nb < 16 && (1 << nb) < parsec_dtd_tile_hash_table_size; nb++ ) /* nothing */;
     parsec_hash_table_init(dc->tile_h_table,
                            offsetof(parsec_dtd_tile_t, ht_item),
@@ -1238,6 +1477,38 @@ parsec_dtd_data_collection_fini(parsec_data_collection_t *dc)
     parsec_dc_unregister_id(dc->dc_id);
 }
 
+/**
+ * Returns the tile cache of the calling execution stream in a tile table,
+ * or NULL if it has none. The caches are indexed by the rank of the
+ * execution stream among all the virtual processes, so each cache is only
+ * used by one thread.
+ */
+static inline parsec_dtd_tile_cache_t *
+parsec_dtd_tile_cache_of(parsec_dtd_tile_table_t *table)
+{
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+    parsec_context_t *context;
+    int vp, id;
+
+    if( NULL == es || NULL == es->virtual_process ) {
+        return NULL;
+    }
+    /* The communication thread and the application threads inserting
+     * tasks pretend to be the master thread, they have no scheduler */
+    if( NULL == es->scheduler_object ) {
+        return NULL;
+    }
+    context = es->virtual_process->parsec_context;
+    id = es->th_id;
+    for( vp = 0; vp < es->virtual_process->vp_id; vp++ ) {
+        id += context->virtual_processes[vp]->nb_cores;
+    }
+    if( id >= PARSEC_DTD_TILE_CACHE_NB_ES ) {
+        return NULL;
+    }
+    return &table->caches[id];
+}
+
 /* **************************************************************************** */
 /**
  * Function to recover tiles inserted by insert_task()
@@ -1259,7 +1530,32 @@ parsec_dtd_data_collection_fini(parsec_data_collection_t *dc)
 parsec_dtd_tile_t *
 parsec_dtd_tile_of(parsec_data_collection_t *dc, parsec_data_key_t key)
 {
-    parsec_dtd_tile_t *tile = parsec_dtd_tile_find(dc, (uint64_t)key);
+    parsec_dtd_tile_table_t *table = (parsec_dtd_tile_table_t *)dc->tile_h_table;
+    parsec_hash_table_t *hash_table = &table->super;
+    parsec_dtd_tile_cache_t *cache = parsec_dtd_tile_cache_of(table);
+    parsec_dtd_tile_t **cached = NULL;
+    parsec_key_handle_t kh;
+
+    if( NULL != cache ) {
+        /* The tiles removed since the cache was filled can be reused for
+         * other data, forget them all */
+        int32_t nb_removals = table->nb_removals;
+        parsec_atomic_rmb();
+        if( cache->nb_removals != nb_removals ) {
+            memset(cache->tiles, 0, sizeof(cache->tiles));
+            cache->nb_removals = nb_removals;
+        }
+        cached = &cache->tiles[(uint64_t)key & (PARSEC_DTD_TILE_CACHE_SIZE - 1)];
+        if( NULL != *cached && (*cached)->key == (uint64_t)key && (*cached)->dc == dc &&
+            NOT_FLUSHED == (*cached)->flushed ) {
+            return *cached;
+        }
+    }
+
+    /* Several threads can look up the same tile concurrently, the tile
+     * is created under the lock of its bucket */
+    parsec_hash_table_lock_bucket_handle(hash_table, (parsec_key_t)key, &kh);
+    parsec_dtd_tile_t *tile = (parsec_dtd_tile_t *)parsec_hash_table_nolock_find_handle(hash_table, &kh);
     if( NULL == tile ) {
         /* Creating Tile object */
         tile = (parsec_dtd_tile_t *)parsec_thread_mempool_allocate(parsec_dtd_tile_mempool->thread_mempools);
@@ -1277,7 +1573,12 @@ parsec_dtd_tile_of(parsec_data_collection_t *dc, parsec_data_key_t key)
         }
 
         SET_LAST_ACCESSOR(tile);
-        parsec_dtd_tile_insert(tile->key, tile, dc);
+        tile->ht_item.key = (parsec_key_t)tile->key;
+        parsec_hash_table_nolock_insert_handle(hash_table, &kh, &tile->ht_item);
+    }
+    parsec_hash_table_unlock_bucket_handle(hash_table, &kh);
+    if( NULL != cached ) {
+        *cached = tile;
     }
     assert(tile->flushed == NOT_FLUSHED);
 #if defined(PARSEC_DEBUG_PARANOID)
@@ -1413,6 +1714,21 @@ parsec_dtd_taskpool_new(void)
     __tp->local_task_inserted = 0;
     __tp->enqueue_flag = 0;
     __tp->new_tile_keys = 0;
+    __tp->graph_recording = NULL;
+    __tp->tracked_ranks = NULL;
+    __tp->nb_pruned_tasks = 0;
+    __tp->flush_batch_tc = NULL;
+    __tp->window_adaptive = parsec_dtd_window_adaptive;
+    __tp->ready_tasks = 0;
+    __tp->memory_in_flight = 0;
+    __tp->window_idle_permille = 0;
+    __tp->window_memory_shrink = -parsec_dtd_window_size; /* the first halving is not delayed */
+    parsec_atomic_lock_init(&__tp->task_class_lock);
+    __tp->link_ticket_next = 0;
+    __tp->link_ticket_served = 0;
+    __tp->link_holder = NULL;
+    __tp->inserter = NULL;
+    __tp->inserter_depth = 0;
 
     (void)parsec_taskpool_reserve_id((parsec_taskpool_t *)__tp);
     if( 0 > asprintf(&__tp->super.taskpool_name, "DTD Taskpool %d",
@@ -1443,6 +1759,56 @@ parsec_dtd_taskpool_new(void)
     return (parsec_taskpool_t *)__tp;
 }
 
+/* **************************************************************************** */
+/**
+ * Declares the neighbors of this rank, the tasks accessing only tiles of
+ * other ranks are then pruned at insertion
+ *
+ * @param[in,out]   tp
+ *                      DTD taskpool
+ * @param[in]       nb_neighbors
+ *                      Number of neighbors
+ * @param[in]       neighbors
+ *                      Ranks of the neighbors
+ * @return
+ *                  PARSEC_SUCCESS, or an error if the neighbors cannot be set
+ *
+ * @ingroup     DTD_INTERFACE
+ */
+int
+parsec_dtd_taskpool_set_neighbors(parsec_taskpool_t *tp, int nb_neighbors,
+                                  const int *neighbors)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    int i;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+    if( NULL == tp->context ) {
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    /* The tiles already used are tracked with their tasks */
+    if( 0 != dtd_tp->task_id ) {
+        return PARSEC_ERR_NOT_SUPPORTED;
+    }
+    for( i = 0; i < nb_neighbors; i++ ) {
+        if( neighbors[i] < 0 || neighbors[i] >= tp->context->nb_nodes ) {
+            return PARSEC_ERR_BAD_PARAM;
+        }
+    }
+
+    if( NULL == dtd_tp->tracked_ranks ) {
+        dtd_tp->tracked_ranks = (uint8_t *)malloc(tp->context->nb_nodes * sizeof(uint8_t));
+    }
+    memset(dtd_tp->tracked_ranks, 0, tp->context->nb_nodes * sizeof(uint8_t));
+    dtd_tp->tracked_ranks[tp->context->my_rank] = 1;
+    for( i = 0; i < nb_neighbors; i++ ) {
+        dtd_tp->tracked_ranks[neighbors[i]] = 1;
+    }
+    return PARSEC_SUCCESS;
+}
+
 /* **************************************************************************** */
 /**
  * This function only registers the taskpool with the different devices, and
@@ -1616,6 +1982,9 @@ dtd_release_dep_fct(parsec_execution_stream_t *es,
 #endif
         if( !not_ready ) {
             assert(parsec_dtd_task_is_local(current_task));
+            if( ((parsec_dtd_taskpool_t *)current_task->super.taskpool)->window_adaptive ) {
+                parsec_dtd_window_task_ready((parsec_dtd_taskpool_t *)current_task->super.taskpool);
+            }
 #if defined(PARSEC_DEBUG_NOISIER)
             PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
                                  "------\ntask Ready: %s \t %" PRIu64 "\nTotal flow: %d  flow_count:"
@@ -1780,6 +2149,77 @@ parsec_dtd_release_deps(parsec_execution_stream_t *es,
     return 0;
 }
 
+/* **************************************************************************** */
+/**
+ * Check if a flow of a task is the first one updating its tile with
+ * PARSEC_ATOMIC_WRITE, the one that owns the atomic_write_lock of the tile
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static inline int
+parsec_dtd_atomic_write_owns_lock(parsec_dtd_task_t *this_task, int flow_index)
+{
+    parsec_dtd_flow_info_t *flow = FLOW_OF(this_task, flow_index);
+    int i;
+
+    if( PARSEC_ATOMIC_WRITE != (flow->op_type & PARSEC_GET_OP_TYPE) || NULL == flow->tile ) {
+        return 0;
+    }
+    for( i = 0; i < flow_index; i++ ) {
+        if( FLOW_OF(this_task, i)->tile == flow->tile &&
+            PARSEC_ATOMIC_WRITE == (FLOW_OF(this_task, i)->op_type & PARSEC_GET_OP_TYPE) ) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* **************************************************************************** */
+/**
+ * Release the atomic_write_lock of the tiles updated with PARSEC_ATOMIC_WRITE
+ * by the first nb_flows flows of a task
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static void
+parsec_dtd_atomic_write_unlock(parsec_dtd_task_t *this_task, int nb_flows)
+{
+    int i;
+
+    for( i = 0; i < nb_flows; i++ ) {
+        if( parsec_dtd_atomic_write_owns_lock(this_task, i) ) {
+            parsec_atomic_unlock(&FLOW_OF(this_task, i)->tile->atomic_write_lock);
+        }
+    }
+}
+
+/* **************************************************************************** */
+/**
+ * Acquire the atomic_write_lock of all the tiles updated with
+ * PARSEC_ATOMIC_WRITE by a task, or none of them
+ *
+ * @return
+ *              1 if the task can execute, 0 if it has to try again later
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_atomic_write_trylock(parsec_dtd_task_t *this_task)
+{
+    int i;
+
+    for( i = 0; i < this_task->super.task_class->nb_flows; i++ ) {
+        if( !parsec_dtd_atomic_write_owns_lock(this_task, i) ) {
+            continue;
+        }
+        if( !parsec_atomic_trylock(&FLOW_OF(this_task, i)->tile->atomic_write_lock) ) {
+            parsec_dtd_atomic_write_unlock(this_task, i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /* **************************************************************************** */
 /**
  * This function is called internally by PaRSEC once a task is done
@@ -1836,6 +2276,13 @@ complete_hook_of_dtd(parsec_execution_stream_t *es,
         }
     }
 
+    /* Let the next PARSEC_ATOMIC_WRITE task of the tiles we updated proceed */
+    parsec_dtd_atomic_write_unlock(this_dtd_task, this_dtd_task->super.task_class->nb_flows);
+
+    if( ((parsec_dtd_taskpool_t *)this_task->taskpool)->window_adaptive ) {
+        parsec_dtd_window_task_completed((parsec_dtd_taskpool_t *)this_task->taskpool, this_dtd_task);
+    }
+
     this_task->task_class->release_deps(es, this_task, action_mask |
                                                        PARSEC_ACTION_RELEASE_LOCAL_DEPS |
                                                        PARSEC_ACTION_SEND_REMOTE_DEPS |
@@ -1864,8 +2311,7 @@ parsec_dtd_release_local_task(parsec_dtd_task_t *this_task)
                     parsec_dtd_release_data_copy(this_task->super.data[current_flow].data_in);
                 }
             }
-            if( PARSEC_DTD_FLUSH_TC_ID == this_task->super.task_class->task_class_id ) {
-                assert(current_flow == 0);
+            if( parsec_dtd_task_holds_tiles(this_task) ) {
                 parsec_dtd_tile_release(tile);
             }
         }
@@ -1910,8 +2356,7 @@ parsec_dtd_remote_task_release(parsec_dtd_task_t *this_task)
 
             parsec_dtd_tile_t *tile = (FLOW_OF(this_task, current_flow))->tile;
             if( tile == NULL) continue;
-            if( PARSEC_DTD_FLUSH_TC_ID == this_task->super.task_class->task_class_id ) {
-                assert(current_flow == 0);
+            if( parsec_dtd_task_holds_tiles(this_task) ) {
                 parsec_dtd_tile_release(tile);
             }
         }
@@ -1960,6 +2405,12 @@ data_lookup_of_dtd_task(parsec_execution_stream_t *es,
         }
     }
 
+    /* The PARSEC_ATOMIC_WRITE tasks of a tile are all ready together, only
+     * one of them at a time is allowed to proceed */
+    if( !parsec_dtd_atomic_write_trylock(current_task) ) {
+        return PARSEC_HOOK_RETURN_AGAIN;
+    }
+
     return PARSEC_HOOK_RETURN_DONE;
 }
 
@@ -2050,19 +2501,20 @@ set_dependencies_for_function(parsec_taskpool_t *tp,
      * intialize the flow structures of the task classes accordingly.
      */
 
+    /* The flows are shared by all the tasks of the class, which can be inserted concurrently */
     if( NULL == desc_tc && NULL != parent_tc ) { /* Data is not going to any other task */
         parsec_flow_t *parent_out = (parsec_flow_t *)(parent_tc->out[parent_flow_index]);
-        parent_out->flow_datatype_mask |= (1U << parent_flow_index);
+        (void)parsec_atomic_fetch_or_int32((int32_t *)&parent_out->flow_datatype_mask, (int32_t)(1U << parent_flow_index));
     } else if( NULL == parent_tc && NULL != desc_tc ) {
         parsec_flow_t *desc_in = (parsec_flow_t *)(desc_tc->in[desc_flow_index]);
-        desc_in->flow_datatype_mask |= (1U << desc_flow_index);
+        (void)parsec_atomic_fetch_or_int32((int32_t *)&desc_in->flow_datatype_mask, (int32_t)(1U << desc_flow_index));
     } else {
         /* In this case it means we have both parent and child task_class */
         parsec_flow_t *parent_out = (parsec_flow_t *)(parent_tc->out[parent_flow_index]);
-        parent_out->flow_datatype_mask |= (1U << parent_flow_index);
+        (void)parsec_atomic_fetch_or_int32((int32_t *)&parent_out->flow_datatype_mask, (int32_t)(1U << parent_flow_index));
 
         parsec_flow_t *desc_in = (parsec_flow_t *)(desc_tc->in[desc_flow_index]);
-        desc_in->flow_datatype_mask |= (1U << desc_flow_index);
+        (void)parsec_atomic_fetch_or_int32((int32_t *)&desc_in->flow_datatype_mask, (int32_t)(1U << desc_flow_index));
     }
 }
 
@@ -2088,15 +2540,29 @@ parsec_dtd_create_task_classv(const char *name,
     } else {
         dtd_tc->params = NULL;
     }
+    dtd_tc->affinity_param = -1;
     for(int i = 0; i < nb_params; i++) {
+        int op_type = params[i].op & PARSEC_GET_OP_TYPE;
         if( params[i].size == PASSED_BY_REF ) {
-            assert( (params[i].op & PARSEC_GET_OP_TYPE) != PARSEC_VALUE &&
-                    (params[i].op & PARSEC_GET_OP_TYPE) != PARSEC_SCRATCH &&
-                    (params[i].op & PARSEC_GET_OP_TYPE) != PARSEC_REF );
+            assert( op_type != PARSEC_VALUE &&
+                    op_type != PARSEC_SCRATCH &&
+                    op_type != PARSEC_REF );
             flow_count++;
+            dtd_tc->flow_params |= (uint64_t)1 << i;
+            if( !(params[i].op & PARSEC_DONT_TRACK) ) {
+                if( PARSEC_INOUT == op_type || PARSEC_OUTPUT == op_type ) {
+                    dtd_tc->write_params |= (uint64_t)1 << i;
+                } else if( PARSEC_ATOMIC_WRITE == op_type ) {
+                    dtd_tc->atomic_write_params |= (uint64_t)1 << i;
+                }
+            }
         } else {
             total_size_of_param += params[i].size;
         }
+        if( (params[i].op & PARSEC_AFFINITY) && -1 == dtd_tc->affinity_param &&
+            (params[i].size == PASSED_BY_REF || PARSEC_VALUE == op_type) ) {
+            dtd_tc->affinity_param = i;
+        }
     }
     dtd_tc->ref_count = 1;
 
@@ -2108,10 +2574,15 @@ parsec_dtd_create_task_classv(const char *name,
             (nb_params * sizeof(parsec_dtd_task_param_t)) +
             total_size_of_param);
 
+    /* One mempool per thread of the virtual process, the application
+     * threads inserting tasks use the first one */
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+    int nb_threads = (NULL != es) ? es->virtual_process->nb_cores : vpmap_get_nb_threads_in_vp(0);
+
     parsec_mempool_construct(&dtd_tc->context_mempool,
                              PARSEC_OBJ_CLASS(parsec_dtd_task_t), total_size,
                              offsetof(parsec_dtd_task_t, mempool_owner),
-                             parsec_my_execution_stream()->virtual_process->nb_cores);
+                             nb_threads);
 
     int total_size_remote_task = (int)(sizeof(parsec_dtd_task_t) +
             (flow_count * sizeof(parsec_dtd_parent_info_t)) +
@@ -2121,7 +2592,7 @@ parsec_dtd_create_task_classv(const char *name,
     parsec_mempool_construct(&dtd_tc->remote_task_mempool,
                              PARSEC_OBJ_CLASS(parsec_dtd_task_t), total_size_remote_task,
                              offsetof(parsec_dtd_task_t, mempool_owner),
-                             parsec_my_execution_stream()->virtual_process->nb_cores);
+                             nb_threads);
 
     /*
      To bypass const in function structure.
@@ -2308,6 +2779,54 @@ static parsec_hook_return_t parsec_dtd_gpu_task_submit(parsec_execution_stream_t
 #endif
 }
 
+/**
+ * Current time in nanoseconds. The durations of the bodies are compared
+ * with dtd_inline_max_duration, the unit of take_time() depends on the
+ * platform (cycles on some of them).
+ */
+static inline int64_t
+parsec_dtd_time_ns(void)
+{
+#if defined(PARSEC_HAVE_CLOCK_GETTIME)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + (int64_t)ts.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000000 + (int64_t)tv.tv_usec * 1000;
+#endif  /* defined(PARSEC_HAVE_CLOCK_GETTIME) */
+}
+
+/**
+ * Execute the CPU body of a DTD task. Its duration is measured when the
+ * small tasks can be executed by their inserter.
+ */
+static parsec_hook_return_t
+parsec_dtd_cpu_task_body(parsec_execution_stream_t *es, parsec_task_t *this_task)
+{
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)this_task->task_class;
+    parsec_hook_return_t rc;
+    int64_t start, duration;
+
+    if( 0 == parsec_dtd_inline_max_duration ) {
+        return dtd_tc->cpu_func_ptr(es, this_task);
+    }
+    start = parsec_dtd_time_ns();
+    rc = dtd_tc->cpu_func_ptr(es, this_task);
+    if( PARSEC_HOOK_RETURN_DONE == rc ) {
+        duration = parsec_dtd_time_ns() - start;
+        /* Concurrent executions can lose a measure, the average is only a hint */
+        if( 0 == dtd_tc->nb_body_durations ) {
+            dtd_tc->body_duration = duration;
+        } else {
+            dtd_tc->body_duration += (duration - dtd_tc->body_duration) / 8;
+        }
+        dtd_tc->nb_body_durations++;
+    }
+    return rc;
+}
+
 static parsec_hook_return_t parsec_dtd_cpu_task_submit(parsec_execution_stream_t *es, parsec_task_t *this_task)
 {
     parsec_dtd_task_t *dtd_task = (parsec_dtd_task_t *)this_task;
@@ -2316,6 +2835,11 @@ static parsec_hook_return_t parsec_dtd_cpu_task_submit(parsec_execution_stream_t
         if(NULL == this_task->data[i].data_in)
             continue;
         parsec_dtd_flow_info_t *flow = FLOW_OF(dtd_task, i);
+        if( PARSEC_ATOMIC_WRITE == (flow->op_type & PARSEC_GET_OP_TYPE) ) {
+            /* updated in place, under the atomic_write_lock of the tile */
+            this_task->data[i].data_in->version++;
+            continue;
+        }
         if(  PARSEC_INOUT == (flow->op_type & PARSEC_GET_OP_TYPE) ||
              PARSEC_OUTPUT == (flow->op_type & PARSEC_GET_OP_TYPE)) {
             this_task->data[i].data_in->version++;
@@ -2333,7 +2857,19 @@ static parsec_hook_return_t parsec_dtd_cpu_task_submit(parsec_execution_stream_t
             }
         }
     }
-    return dtd_tc->cpu_func_ptr(es, this_task);
+    return parsec_dtd_cpu_task_body(es, this_task);
+}
+
+int
+parsec_dtd_task_class_set_inline(parsec_task_class_t *tc, parsec_dtd_inline_hint_t hint)
+{
+    if( tc->task_class_type != PARSEC_TASK_CLASS_TYPE_DTD ) {
+        parsec_warning("Called parsec_dtd_task_class_set_inline on a non-DTD task class '%s'\n",
+                       tc->name);
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    ((parsec_dtd_task_class_t *)tc)->inline_hint = (int8_t)hint;
+    return PARSEC_SUCCESS;
 }
 
 int parsec_dtd_task_class_add_chore(parsec_taskpool_t *tp,
@@ -2480,10 +3016,10 @@ parsec_dtd_set_flow_in_function(parsec_dtd_taskpool_t *dtd_tp,
 
     if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
         flow->flow_flags = PARSEC_FLOW_ACCESS_READ;
-    } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
-              (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
+    } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
         flow->flow_flags = PARSEC_FLOW_ACCESS_WRITE;
-    } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ) {
+    } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+              (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
         flow->flow_flags = PARSEC_FLOW_ACCESS_RW;
     }
 
@@ -2617,6 +3153,7 @@ parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
 {
     int i;
     parsec_dtd_task_t *this_task;
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
     assert(NULL != dtd_tp);
     assert(NULL != tc);
 
@@ -2627,15 +3164,16 @@ parsec_dtd_create_and_initialize_task(parsec_dtd_taskpool_t *dtd_tp,
     } else {
         dtd_task_mempool = &((parsec_dtd_task_class_t *)tc)->remote_task_mempool;
     }
+    /* The application threads (without a core) share the first mempool */
     this_task = (parsec_dtd_task_t *)parsec_thread_mempool_allocate(
-            dtd_task_mempool->thread_mempools + parsec_my_execution_stream()->core_id);
+            dtd_task_mempool->thread_mempools + (es->core_id < 0 ? 0 : es->core_id));
 
     assert(this_task->super.super.super.obj_reference_count == 1);
 
     PARSEC_OBJ_CONSTRUCT(&this_task->super, parsec_task_t);
     this_task->orig_task = NULL;
     this_task->super.taskpool = (parsec_taskpool_t *)dtd_tp;
-    this_task->ht_item.key = (parsec_key_t)(uintptr_t)(dtd_tp->task_id++);
+    this_task->ht_item.key = (parsec_key_t)(uintptr_t)parsec_atomic_fetch_inc_int32(&dtd_tp->task_id);
     /* this is needed for grapher to work properly */
     this_task->super.locals[0].value = (int)(uintptr_t)this_task->ht_item.key;
     assert((uintptr_t)this_task->super.locals[0].value == (uintptr_t)this_task->ht_item.key);
@@ -2745,32 +3283,267 @@ fake_first_out_body(parsec_execution_stream_t *es, parsec_task_t *this_task)
     return PARSEC_HOOK_RETURN_DONE;
 }
 
-int
-parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_task,
-                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid)
+/* **************************************************************************** */
+/**
+ * Body of fake task we insert to order a sequence of PARSEC_ATOMIC_WRITE
+ * tasks with the readers of the same data, or with a writer executing on
+ * another process. As a writer, it waits for all the tasks of the sequence
+ * (tracked as readers of the data) before releasing its successors.
+ *
+ * @param   context, this_task
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static int
+fake_atomic_write_fence_body(parsec_execution_stream_t *es, parsec_task_t *this_task)
 {
-    /* Building list of initial ready task */
-    if( satisfied_flow == parsec_atomic_fetch_sub_int32(&this_task->flow_count, satisfied_flow)) {
-        PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
-                             "------\ntask Ready: %s \t %lld\nTotal flow: %d  flow_count:"
-                             "%d\n-----\n", this_task->super.task_class->name, this_task->ht_item.key,
-                             this_task->super.task_class->nb_flows, this_task->flow_count);
+    (void)es;
+    (void)this_task;
+    return PARSEC_HOOK_RETURN_DONE;
+}
 
-        PARSEC_LIST_ITEM_SINGLETON(this_task);
-        __parsec_schedule(parsec_my_execution_stream(), (parsec_task_t *)this_task, 0);
-        *vpid = (*vpid + 1) % dtd_tp->super.context->nb_vp;
-        return 1; /* Indicating local task was ready */
+/* **************************************************************************** */
+/**
+ * Check if an access to a tile needs a fence after the previous accesses
+ *
+ * The PARSEC_ATOMIC_WRITE tasks are chained as readers, so they need to be
+ * separated from the actual readers, and from the writers executing on another
+ * process (which would otherwise receive the data before all the updates).
+ * The last_op_type of the tile is updated on all ranks, so they all insert
+ * the same fences.
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static inline int
+parsec_dtd_atomic_write_needs_fence(parsec_dtd_tile_t *tile, parsec_dtd_task_t *this_task,
+                                    int tile_op_type, int holder_rank)
+{
+    tile_op_type &= PARSEC_GET_OP_TYPE;
+    if( PARSEC_ATOMIC_WRITE == tile->last_op_type ) {
+        return (PARSEC_INPUT == tile_op_type) ||
+               ((PARSEC_ATOMIC_WRITE != tile_op_type) && (this_task->rank != holder_rank));
+    }
+    if( PARSEC_INPUT == tile->last_op_type ) {
+        return PARSEC_ATOMIC_WRITE == tile_op_type;
     }
     return 0;
 }
 
-int
-parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_threshold)
+/**
+ * A task can be executed by its inserter if it can only execute on a CPU
+ * and if its task class says so, or the bodies of its task class were
+ * measured to be small enough.
+ */
+static inline int
+parsec_dtd_task_is_inlinable(parsec_dtd_task_t *this_task)
 {
-    if((dtd_tp->local_task_inserted % dtd_tp->task_window_size) == 0 ) {
-        if( dtd_tp->task_window_size < parsec_dtd_window_size ) {
-            dtd_tp->task_window_size *= 2;
-        } else {
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)this_task->super.task_class;
+    const __parsec_chore_t *incarnations = dtd_tc->super.incarnations;
+    int i;
+
+    if( PARSEC_DTD_INLINE_ALWAYS != dtd_tc->inline_hint ) {
+        if( PARSEC_DTD_INLINE_NEVER == dtd_tc->inline_hint || 0 == parsec_dtd_inline_max_duration ||
+            dtd_tc->nb_body_durations < PARSEC_DTD_INLINE_MIN_MEASURES ||
+            dtd_tc->body_duration > parsec_dtd_inline_max_duration ) {
+            return 0;
+        }
+    }
+    for( i = 0; NULL != incarnations[i].hook; i++ ) {
+        if( (this_task->super.chore_mask & (1 << i)) && PARSEC_DEV_CPU != incarnations[i].type ) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int
+parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_task,
+                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid,
+                                  parsec_task_t **ready_ring)
+{
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+
+    /* Building list of initial ready task */
+    if( satisfied_flow == parsec_atomic_fetch_sub_int32(&this_task->flow_count, satisfied_flow)) {
+        PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
+                             "------\ntask Ready: %s \t %lld\nTotal flow: %d  flow_count:"
+                             "%d\n-----\n", this_task->super.task_class->name, this_task->ht_item.key,
+                             this_task->super.task_class->nb_flows, this_task->flow_count);
+
+        if( dtd_tp->window_adaptive ) {
+            parsec_dtd_window_task_ready(dtd_tp);
+        }
+        PARSEC_LIST_ITEM_SINGLETON(this_task);
+        if( NULL == ready_ring && NULL != es->scheduler_object && es != dtd_tp->link_holder &&
+            parsec_dtd_task_is_inlinable(this_task) ) {
+            /* A small task skips the round trip through the scheduler */
+            (void)__parsec_task_progress(es, &this_task->super, 0);
+            return 1;
+        }
+        if( NULL != ready_ring ) {
+            /* The caller schedules all the ready tasks at once */
+            *ready_ring = (parsec_task_t *)
+                    parsec_list_item_ring_push_sorted((parsec_list_item_t *)*ready_ring,
+                                                      &this_task->super.super,
+                                                      parsec_execution_context_priority_comparator);
+            return 1;
+        }
+        parsec_dtd_schedule(es, (parsec_task_t *)this_task);
+        *vpid = (*vpid + 1) % dtd_tp->super.context->nb_vp;
+        return 1; /* Indicating local task was ready */
+    }
+    return 0;
+}
+
+/* **************************************************************************** */
+/**
+ * Estimated memory of a local task in flight: its descriptor, and the data
+ * the runtime allocates for the flows on tiles of other ranks.
+ */
+static int64_t
+parsec_dtd_task_footprint(parsec_dtd_task_t *this_task)
+{
+    const parsec_task_class_t *tc = this_task->super.task_class;
+    int64_t footprint = (int64_t)((parsec_dtd_task_class_t *)tc)->context_mempool.elt_size;
+    parsec_arena_datatype_t *adt;
+    parsec_dtd_flow_info_t *flow;
+    int flow_index;
+
+    for( flow_index = 0; flow_index < tc->nb_flows; flow_index++ ) {
+        flow = FLOW_OF(this_task, flow_index);
+        if( NULL == flow->tile || flow->tile->rank == this_task->rank || flow->arena_index < 0 ) {
+            continue;
+        }
+        adt = parsec_dtd_get_arena_datatype(this_task->super.taskpool->context, flow->arena_index);
+        if( NULL != adt && NULL != adt->arena ) {
+            footprint += (int64_t)adt->arena->elem_size;
+        }
+    }
+    return footprint;
+}
+
+void
+parsec_dtd_window_task_inserted(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task)
+{
+    (void)parsec_atomic_fetch_add_int64(&dtd_tp->memory_in_flight, parsec_dtd_task_footprint(this_task));
+}
+
+void
+parsec_dtd_window_task_ready(parsec_dtd_taskpool_t *dtd_tp)
+{
+    (void)parsec_atomic_fetch_inc_int32(&dtd_tp->ready_tasks);
+}
+
+void
+parsec_dtd_window_task_completed(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task)
+{
+    (void)parsec_atomic_fetch_dec_int32(&dtd_tp->ready_tasks);
+    (void)parsec_atomic_fetch_sub_int64(&dtd_tp->memory_in_flight, parsec_dtd_task_footprint(this_task));
+}
+
+/* **************************************************************************** */
+/**
+ * Adapt the size of the window of task insertion
+ *
+ * The window grows when the workers lack ready tasks (fewer ready tasks
+ * than workers, or idle time while the inserter drained the last window),
+ * and shrinks when the memory of the tasks in flight exceeds
+ * dtd_window_max_memory or when half the window is already ready to
+ * execute. Its size remains between dtd_window_min_size and
+ * parsec_dtd_window_size, the threshold keeps the ratio of
+ * parsec_dtd_threshold_size to parsec_dtd_window_size. The decisions are
+ * traced on the DTD output stream, at verbosity 20. The window is also
+ * adapted, within a window, as soon as the memory in flight exceeds the
+ * bound: the inserter drains the tasks in flight every time, but the window
+ * is only halved once per window of insertions, the tasks already in
+ * flight do not reflect the previous halving yet.
+ *
+ * @return
+ *              1 if the inserter blocked on the window, 0 otherwise
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_window_adapt(parsec_dtd_taskpool_t *dtd_tp, int32_t window_size)
+{
+    int32_t new_size = window_size, ready = dtd_tp->ready_tasks;
+    int32_t in_flight = dtd_tp->super.nb_tasks, threshold;
+    int64_t memory = dtd_tp->memory_in_flight;
+    int64_t max_memory = (int64_t)parsec_dtd_window_max_memory << 20;
+    int nb_workers = 0, vp, idle = dtd_tp->window_idle_permille;
+    const char *reason = NULL;
+
+    /* Slow start, up to the smallest window */
+    if( window_size < parsec_dtd_window_min_size ) {
+        (void)parsec_atomic_cas_int32(&dtd_tp->task_window_size, window_size, 2 * window_size);
+        return 0;
+    }
+
+    for( vp = 0; vp < dtd_tp->super.context->nb_vp; vp++ ) {
+        nb_workers += dtd_tp->super.context->virtual_processes[vp]->nb_cores;
+    }
+
+    if( 0 != max_memory && memory > max_memory ) {
+        if( dtd_tp->local_task_inserted - dtd_tp->window_memory_shrink >= window_size ) {
+            new_size = window_size / 2;
+            reason = "memory in flight";
+        }
+    } else if( in_flight >= window_size && (ready < nb_workers || idle > 100) &&
+               (0 == max_memory || 2 * memory <= max_memory) ) {
+        new_size = 2 * window_size;
+        reason = (ready < nb_workers) ? "starving workers" : "idle workers";
+    } else if( ready > window_size / 2 && idle == 0 ) {
+        new_size = window_size / 2;
+        reason = "deep ready queue";
+    }
+    if( new_size > parsec_dtd_window_size ) new_size = parsec_dtd_window_size;
+    if( new_size < parsec_dtd_window_min_size ) new_size = parsec_dtd_window_min_size;
+
+    if( new_size != window_size &&
+        parsec_atomic_cas_int32(&dtd_tp->task_window_size, window_size, new_size) ) {
+        parsec_output_verbose(20, parsec_dtd_debug_output,
+                              "DTD window of taskpool %d: %d -> %d (%s): %d tasks in flight, %d ready, "
+                              "%d workers, %d permille idle, %" PRId64 " bytes in flight\n",
+                              dtd_tp->super.taskpool_id, window_size, new_size, reason,
+                              in_flight, ready, nb_workers, idle, memory);
+        if( new_size < window_size ) {
+            dtd_tp->window_memory_shrink = dtd_tp->local_task_inserted;
+        }
+    } else {
+        new_size = window_size;
+    }
+
+    threshold = (int32_t)(((int64_t)new_size * parsec_dtd_threshold_size) / parsec_dtd_window_size);
+    if( in_flight <= threshold ) {
+        return 0;
+    }
+    __parsec_execute_and_come_back(&dtd_tp->super, threshold, &dtd_tp->window_idle_permille);
+    return 1; /* Indicating we blocked */
+}
+
+/**
+ * Grow the window, adapt it, or drain it down to the threshold, when the
+ * inserter reached the end of a window (or exceeded the memory bound of an
+ * adaptive window).
+ */
+static int
+parsec_dtd_window_reached(parsec_dtd_taskpool_t *dtd_tp, int32_t window_size,
+                          int end_of_window, int task_threshold)
+{
+    if( dtd_tp->window_adaptive ) {
+        /* Do not wait for the end of the window to bound the memory */
+        if( end_of_window ||
+           (0 != parsec_dtd_window_max_memory &&
+            dtd_tp->memory_in_flight > ((int64_t)parsec_dtd_window_max_memory << 20)) ) {
+            return parsec_dtd_window_adapt(dtd_tp, window_size);
+        }
+        return 0;
+    }
+    if( end_of_window ) {
+        if( window_size < parsec_dtd_window_size ) {
+            /* a single one of the concurrent inserters grows the window */
+            (void)parsec_atomic_cas_int32(&dtd_tp->task_window_size, window_size, 2 * window_size);
+        } else {
             parsec_execute_and_come_back(&dtd_tp->super,
                                          task_threshold);
             return 1; /* Indicating we blocked */
@@ -2779,33 +3552,203 @@ parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_th
     return 0;
 }
 
+/**
+ * Check the window after the insertion of nb_new local tasks, nb_inserted
+ * being the count of local tasks returned by the atomic increment. Several
+ * threads insert concurrently, only the one whose tasks cross the end of
+ * the window handles it.
+ */
+int
+parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int32_t nb_inserted,
+                                      int32_t nb_new, int task_threshold)
+{
+    int32_t window_size = dtd_tp->task_window_size;
+
+    return parsec_dtd_window_reached(dtd_tp, window_size,
+                                     (nb_inserted / window_size) != ((nb_inserted + nb_new) / window_size),
+                                     task_threshold);
+}
+
 /* **************************************************************************** */
 /**
- * Function to insert dtd task in PaRSEC
+ * Sets the flows of the task class of this_task from the flows of this
+ * first task of the class. Several threads can insert the first tasks of a
+ * class concurrently, the flows are set once, before any of these tasks
+ * is linked with others.
+ */
+void
+parsec_dtd_set_flows_of_task_class(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task)
+{
+    const parsec_task_class_t *tc = this_task->super.task_class;
+    int flow_index;
+
+    parsec_atomic_lock(&dtd_tp->task_class_lock);
+    if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+        for( flow_index = 0; flow_index < tc->nb_flows; flow_index++ ) {
+            /* Setting flow in function structure */
+            parsec_dtd_set_flow_in_function(dtd_tp, this_task,
+                                            (FLOW_OF(this_task, flow_index))->op_type, flow_index);
+        }
+        parsec_atomic_wmb();
+        dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+    }
+    parsec_atomic_unlock(&dtd_tp->task_class_lock);
+}
+
+static void
+__parsec_insert_dtd_task(parsec_task_t *__this_task, parsec_task_t **ready_ring);
+
+/* **************************************************************************** */
+/**
+ * Track the access of a remote task to a tile pruned by this rank
  *
- * In this function we track all the dependencies and create the DAG
+ * The tasks accessing a pruned tile are not kept, only the rank of the last
+ * writer of the tile and the key of its last user, to insert the same
+ * Fake_FIRST_OUT and fence tasks as the other ranks, following the same
+ * rules as __parsec_insert_dtd_task(). These tasks are remote and pruned
+ * in turn, so the task ids remain the same on all ranks.
  *
+ * @ingroup DTD_INTERFACE_INTERNAL
  */
-void
-parsec_insert_dtd_task(parsec_task_t *__this_task)
+static void
+parsec_dtd_pruned_tile_access(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *tile, int tile_op_type,
+                              parsec_task_t **ready_ring)
 {
-    if( PARSEC_TASKPOOL_TYPE_DTD != __this_task->taskpool->taskpool_type ) {
-        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    parsec_key_t key = this_task->ht_item.key;
+
+    parsec_dtd_last_user_lock(&(tile->last_user));
+
+    if( -1 == tile->pruned_writer_rank &&
+        (this_task->rank != tile->rank || (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+         (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE)) {
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+        parsec_dtd_insert_fake_first_out((parsec_dtd_taskpool_t *)this_task->super.taskpool,
+                                         tile, tile_op_type, ready_ring);
+        parsec_dtd_last_user_lock(&(tile->last_user));
     }
 
+    if( PARSEC_ATOMIC_WRITE == (tile_op_type & PARSEC_GET_OP_TYPE) &&
+        (tile->pruned_last_user == key || this_task->rank != tile->pruned_writer_rank) ) {
+        tile_op_type = (tile_op_type & ~PARSEC_GET_OP_TYPE) | PARSEC_INOUT;
+    }
+
+    if( -1 != tile->pruned_writer_rank && tile->pruned_last_user != key &&
+        parsec_dtd_atomic_write_needs_fence(tile, this_task, tile_op_type, tile->pruned_writer_rank) ) {
+        int holder_rank = tile->pruned_writer_rank;
+
+        tile->last_op_type = PARSEC_INOUT;
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+        __parsec_insert_dtd_task(parsec_dtd_create_task(this_task->super.taskpool,
+                                                 &fake_atomic_write_fence_body, 0, PARSEC_DEV_CPU, "Fake_ATOMIC_WRITE_FENCE",
+                                                 sizeof(int), &holder_rank, PARSEC_VALUE | PARSEC_AFFINITY,
+                                                 PASSED_BY_REF, tile, PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO),
+                                                 PARSEC_DTD_ARG_END),
+                                 ready_ring);
+        parsec_dtd_last_user_lock(&(tile->last_user));
+    }
+
+    /* All the writers of a pruned tile are remote, so only the writers are
+     * chained as last users */
+    if( PARSEC_INOUT == (tile_op_type & PARSEC_GET_OP_TYPE) ||
+        PARSEC_OUTPUT == (tile_op_type & PARSEC_GET_OP_TYPE)) {
+        tile->pruned_writer_rank = this_task->rank;
+        tile->pruned_last_user = key;
+    }
+    tile->last_op_type = tile_op_type & PARSEC_GET_OP_TYPE;
+
+    parsec_dtd_last_user_unlock(&(tile->last_user));
+}
+
+/* **************************************************************************** */
+/**
+ * Prune a remote task if all the tiles it accesses are pruned by this rank
+ *
+ * @return
+ *              1 if the task was pruned and released, 0 if it has to be inserted
+ *
+ * @ingroup DTD_INTERFACE_INTERNAL
+ */
+static int
+parsec_dtd_prune_remote_task(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task,
+                             parsec_task_t **ready_ring)
+{
+    const parsec_task_class_t *tc = this_task->super.task_class;
+    parsec_dtd_flow_info_t *flow;
+    int flow_index;
+
+    for( flow_index = 0; flow_index < tc->nb_flows; flow_index++ ) {
+        flow = FLOW_OF(this_task, flow_index);
+        if( NULL != flow->tile && !(flow->op_type & PARSEC_DONT_TRACK) &&
+            !parsec_dtd_tile_is_pruned(dtd_tp, flow->tile) ) {
+            return 0;
+        }
+    }
+
+    for( flow_index = 0; flow_index < tc->nb_flows; flow_index++ ) {
+        flow = FLOW_OF(this_task, flow_index);
+        if( NULL != flow->tile && !(flow->op_type & PARSEC_DONT_TRACK) ) {
+            parsec_dtd_pruned_tile_access(this_task, flow->tile, flow->op_type, ready_ring);
+        }
+    }
+
+    PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
+                         "Task pruned -> %s %d rank %d\n", tc->name, this_task->ht_item.key, this_task->rank);
+    (void)parsec_atomic_fetch_inc_int32(&dtd_tp->nb_pruned_tasks);
+    /* The task was never retained, it goes back to its mempool */
+    parsec_thread_mempool_free(this_task->mempool_owner, this_task);
+    return 1;
+}
+
+/* **************************************************************************** */
+/**
+ * Function to insert dtd task in PaRSEC
+ *
+ * In this function we track all the dependencies and create the DAG
+ *
+ */
+static void
+__parsec_insert_dtd_task(parsec_task_t *__this_task, parsec_task_t **ready_ring)
+{
     parsec_dtd_task_t *this_task = (parsec_dtd_task_t *)__this_task;
     const parsec_task_class_t *tc = this_task->super.task_class;
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)this_task->super.taskpool;
 
     int flow_index, satisfied_flow = 0, tile_op_type = 0, put_in_chain = 1;
+    int32_t nb_inserted = 0, nb_new = 0;
     static int vpid = 0;
     parsec_dtd_tile_t *tile = NULL;
+    parsec_execution_stream_t *es = parsec_my_execution_stream();
+    int nb_tiles = 0, linking_alone = 0;
+
+    if( NULL != dtd_tp->tracked_ranks && parsec_dtd_task_is_remote(this_task) &&
+        parsec_dtd_prune_remote_task(dtd_tp, this_task, ready_ring) ) {
+        return;
+    }
 
     /* Retaining every remote_task */
     if( parsec_dtd_task_is_remote(this_task)) {
         parsec_dtd_remote_task_retain(this_task);
     }
 
+    if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
+        parsec_dtd_set_flows_of_task_class(dtd_tp, this_task);
+    }
+
+    parsec_dtd_inserter_enter(dtd_tp, es);
+
+    /* The tasks with several tiles link them alone. The tasks the runtime
+     * inserts while linking (first writers and fences) have a single tile. */
+    for( flow_index = 0; flow_index < tc->nb_flows && nb_tiles < 2; flow_index++ ) {
+        tile = (FLOW_OF(this_task, flow_index))->tile;
+        if( NULL != tile && !((FLOW_OF(this_task, flow_index))->op_type & PARSEC_DONT_TRACK) ) {
+            nb_tiles++;
+        }
+    }
+    if( nb_tiles > 1 ) {
+        parsec_dtd_link_alone_begin(dtd_tp, es);
+        linking_alone = 1;
+    }
+
     /* In the next segment we resolve the dependencies of each flow */
     for( flow_index = 0, tile = NULL, tile_op_type = 0; flow_index < tc->nb_flows; flow_index++ ) {
         parsec_dtd_tile_user_t last_user, last_writer;
@@ -2813,11 +3756,6 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         tile_op_type = (FLOW_OF(this_task, flow_index))->op_type;
         put_in_chain = 1;
 
-        if( 0 == dtd_tp->flow_set_flag[tc->task_class_id] ) {
-            /* Setting flow in function structure */
-            parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
-        }
-
         if( NULL == tile ) {
             satisfied_flow++;
             continue;
@@ -2830,6 +3768,17 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
             continue;
         }
 
+        /* No other task of this rank uses this data */
+        if( parsec_dtd_tile_is_pruned(dtd_tp, tile) ) {
+            if( parsec_dtd_task_is_local(this_task) ) {
+                parsec_fatal("Task %s accesses a data of rank %d, which is not a neighbor of this rank "
+                             "(see parsec_dtd_taskpool_set_neighbors)\n", tc->name, tile->rank);
+            }
+            parsec_dtd_pruned_tile_access(this_task, tile, tile_op_type, ready_ring);
+            satisfied_flow++;
+            continue;
+        }
+
         if( tile->arena_index == -1 ) {
             tile->arena_index = (tile_op_type & PARSEC_GET_REGION_INFO);
         }
@@ -2842,16 +3791,12 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         READ_FROM_TILE(last_writer, tile->last_writer);
 
         if( NULL == last_user.task &&
-            (this_task->rank != tile->rank || (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT)) {
+            (this_task->rank != tile->rank || (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+             (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE)) {
             parsec_dtd_last_user_unlock(&(tile->last_user));
 
             /* parentless */
-            /* Create Fake output_task */
-            parsec_dtd_insert_task(this_task->super.taskpool,
-                                   &fake_first_out_body, 0, PARSEC_DEV_CPU,"Fake_FIRST_OUT",
-                                   PASSED_BY_REF, tile,
-                                            PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO) | PARSEC_AFFINITY,
-                                   PARSEC_DTD_ARG_END);
+            parsec_dtd_insert_fake_first_out(dtd_tp, tile, tile_op_type, ready_ring);
 
             parsec_dtd_last_user_lock(&(tile->last_user));
 
@@ -2861,6 +3806,39 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
             assert((last_user.task == NULL) || ((FLOW_OF(last_writer.task, last_writer.flow_index))->tile == tile));
         }
 
+        if( PARSEC_ATOMIC_WRITE == (tile_op_type & PARSEC_GET_OP_TYPE) &&
+            (last_user.task == this_task || this_task->rank != last_writer.task->rank) ) {
+            /* The updates are only unordered between different tasks executing
+             * where the data is: otherwise we order this one like an INOUT */
+            tile_op_type = (tile_op_type & ~PARSEC_GET_OP_TYPE) | PARSEC_INOUT;
+            (FLOW_OF(this_task, flow_index))->op_type = tile_op_type;
+            if( parsec_dtd_task_is_local(this_task) ) {
+                /* retaining the local task for this additional write flow */
+                (void)parsec_atomic_fetch_inc_int32(&this_task->super.super.super.obj_reference_count);
+            }
+        }
+
+        if( NULL != last_writer.task && last_user.task != this_task &&
+            parsec_dtd_atomic_write_needs_fence(tile, this_task, tile_op_type, last_writer.task->rank) ) {
+            int holder_rank = last_writer.task->rank;
+
+            /* the fence itself is a writer that does not need to be fenced */
+            tile->last_op_type = PARSEC_INOUT;
+            parsec_dtd_last_user_unlock(&(tile->last_user));
+
+            __parsec_insert_dtd_task(parsec_dtd_create_task(this_task->super.taskpool,
+                                                     &fake_atomic_write_fence_body, 0, PARSEC_DEV_CPU, "Fake_ATOMIC_WRITE_FENCE",
+                                                     sizeof(int), &holder_rank, PARSEC_VALUE | PARSEC_AFFINITY,
+                                                     PASSED_BY_REF, tile, PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO),
+                                                     PARSEC_DTD_ARG_END),
+                                     ready_ring);
+
+            parsec_dtd_last_user_lock(&(tile->last_user));
+
+            READ_FROM_TILE(last_user, tile->last_user);
+            READ_FROM_TILE(last_writer, tile->last_writer);
+        }
+
         if( PARSEC_INOUT == (tile_op_type & PARSEC_GET_OP_TYPE) ||
             PARSEC_OUTPUT == (tile_op_type & PARSEC_GET_OP_TYPE)) {
 #if defined(PARSEC_PROF_TRACE)
@@ -2910,6 +3888,7 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
             tile->last_user.op_type = tile_op_type;
             tile->last_user.alive = TASK_IS_ALIVE;
         }
+        tile->last_op_type = tile_op_type & PARSEC_GET_OP_TYPE;
 
         /* Unlocking the last_user of the tile */
         parsec_dtd_last_user_unlock(&(tile->last_user));
@@ -2957,7 +3936,8 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
                         (last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT)
                        && ((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT)) {
                         FLOW_OF(this_task, flow_index)->flags |= RELEASE_OWNERSHIP_SPECIAL;
-                    } else if((last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT &&
+                    } else if(((last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+                               (last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE) &&
                               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
                         /* we unset flag for previous flow and set it for last one */
                         FLOW_OF(last_user.task, last_user.flow_index)->flags &= ~RELEASE_OWNERSHIP_SPECIAL;
@@ -2966,7 +3946,8 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 
                     if(((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
                         (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT)
-                       && (last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
+                       && ((last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+                           (last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE) ) {
 
                         /* clearing bit set to track special release of ownership */
                         FLOW_OF(last_user.task, last_user.flow_index)->flags &= ~RELEASE_OWNERSHIP_SPECIAL;
@@ -3013,7 +3994,8 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
                  * cases.
                  */
                 if( last_user.task == this_task ) {
-                    if((last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
+                    if((last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+                       (last_user.op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
                         if( this_task->super.data[last_user.flow_index].data_in != NULL) {
 /* #if defined(PARSEC_HAVE_DEV_CUDA_SUPPORT) */
 /*                            parsec_atomic_lock(&this_task->super.data[last_user.flow_index].data_in->original->lock); */
@@ -3059,7 +4041,8 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
                             parsec_dtd_release_local_task(parent_task);
                         }
                     } else {
-                        if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
+                        if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+                           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
                             parsec_dtd_last_user_lock(&(tile->last_user));
                             tile->last_user.alive = TASK_IS_NOT_ALIVE;
                             parsec_dtd_last_user_unlock(&(tile->last_user));
@@ -3093,11 +4076,18 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
         }
     }
 
-    dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+    if( linking_alone ) {
+        parsec_dtd_link_alone_end(dtd_tp);
+    }
+    parsec_dtd_inserter_leave(dtd_tp);
 
     if( parsec_dtd_task_is_local(this_task) ) {/* Task is local */
         dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, 1);
-        dtd_tp->local_task_inserted++;
+        nb_inserted = parsec_atomic_fetch_inc_int32(&dtd_tp->local_task_inserted);
+        nb_new = 1;
+        if( dtd_tp->window_adaptive ) {
+            parsec_dtd_window_task_inserted(dtd_tp, this_task);
+        }
         PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
                              "Task generated -> %s %d rank %d\n", this_task->super.task_class->name,
                              this_task->ht_item.key, this_task->rank);
@@ -3119,10 +4109,98 @@ parsec_insert_dtd_task(parsec_task_t *__this_task)
 
     if( parsec_dtd_task_is_local(this_task)) {
         parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task,
-                                          dtd_tp, &vpid);
+                                          dtd_tp, &vpid, ready_ring);
     }
 
-    parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    /* The ready tasks of a batch must be scheduled before the inserter
+     * waits on the window, and the tasks executed while waiting could
+     * wait for the ticket of the task being linked */
+    if( NULL == ready_ring && es != dtd_tp->link_holder ) {
+        parsec_dtd_block_if_threshold_reached(dtd_tp, nb_inserted, nb_new, parsec_dtd_threshold_size);
+    }
+}
+
+/**
+ * Insert the task writing the initial content of a tile, for a first access
+ * that has to read it.
+ */
+void
+parsec_dtd_insert_fake_first_out(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_tile_t *tile,
+                                 int tile_op_type, parsec_task_t **ready_ring)
+{
+    __parsec_insert_dtd_task(parsec_dtd_create_task(&dtd_tp->super,
+                                             &fake_first_out_body, 0, PARSEC_DEV_CPU,"Fake_FIRST_OUT",
+                                             PASSED_BY_REF, tile,
+                                             PARSEC_INOUT | (tile_op_type & PARSEC_GET_REGION_INFO) | PARSEC_AFFINITY,
+                                             PARSEC_DTD_ARG_END),
+                             ready_ring);
+}
+
+void
+parsec_insert_dtd_task(parsec_task_t *__this_task)
+{
+    if( PARSEC_TASKPOOL_TYPE_DTD != __this_task->taskpool->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)__this_task->taskpool;
+    parsec_dtd_graph_t *graph = dtd_tp->graph_recording;
+    parsec_execution_stream_t app_es;
+    int borrowed = parsec_dtd_borrow_execution_stream(dtd_tp, &app_es);
+
+    if( NULL == graph ) {
+        __parsec_insert_dtd_task(__this_task, NULL);
+        parsec_dtd_return_execution_stream(borrowed);
+        return;
+    }
+    /* The task must be recorded before it is inserted, as it can complete
+     * during the insertion. The tasks the runtime inserts on behalf of this
+     * one are not recorded, they will be inserted again by the replay. */
+    parsec_dtd_graph_record_task(graph, (parsec_dtd_task_t *)__this_task);
+    dtd_tp->graph_recording = NULL;
+    __parsec_insert_dtd_task(__this_task, NULL);
+    dtd_tp->graph_recording = graph;
+    parsec_dtd_return_execution_stream(borrowed);
+}
+
+void
+parsec_insert_dtd_tasks(parsec_task_t **tasks, int nb_tasks)
+{
+    parsec_dtd_taskpool_t *dtd_tp;
+    parsec_dtd_graph_t *graph;
+    parsec_task_t *ready_ring = NULL;
+    parsec_execution_stream_t app_es;
+    int32_t window_size, nb_inserted;
+    int i, borrowed;
+
+    if( nb_tasks <= 0 ) return;
+    if( PARSEC_TASKPOOL_TYPE_DTD != tasks[0]->taskpool->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+    dtd_tp = (parsec_dtd_taskpool_t *)tasks[0]->taskpool;
+    borrowed = parsec_dtd_borrow_execution_stream(dtd_tp, &app_es);
+    graph = dtd_tp->graph_recording;
+    window_size = dtd_tp->task_window_size;
+    nb_inserted = dtd_tp->local_task_inserted;
+
+    dtd_tp->graph_recording = NULL;
+    for( i = 0; i < nb_tasks; i++ ) {
+        assert(tasks[i]->taskpool == &dtd_tp->super);
+        if( NULL != graph ) {
+            parsec_dtd_graph_record_task(graph, (parsec_dtd_task_t *)tasks[i]);
+        }
+        __parsec_insert_dtd_task(tasks[i], &ready_ring);
+    }
+    dtd_tp->graph_recording = graph;
+
+    if( NULL != ready_ring ) {
+        parsec_dtd_schedule(parsec_my_execution_stream(), ready_ring);
+    }
+    /* The window is checked once for the whole batch */
+    parsec_dtd_window_reached(dtd_tp, window_size,
+                              (nb_inserted / window_size) != (dtd_tp->local_task_inserted / window_size),
+                              parsec_dtd_threshold_size);
+    parsec_dtd_return_execution_stream(borrowed);
 }
 
 static inline parsec_task_t *
@@ -3133,11 +4211,14 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
     parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
     int rank = -1;
     int write_flow_count = 1;
+    int atomic_write_flow_count = 0;
     int flow_count_of_tc = 0;
     int flow_index = 0;
     parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t*)tc;
     int nb_params = 0;
     parsec_dtd_param_t params[PARSEC_DTD_MAX_PARAMS];
+    parsec_execution_stream_t app_es;
+    int borrowed;
 
     if( dtd_tp == NULL) {
         parsec_fatal("You need to pass a correct parsec taskpool in order to insert task. "
@@ -3151,6 +4232,9 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
                      " you try inserting task in PaRSEC\n");
     }
 
+    borrowed = parsec_dtd_borrow_execution_stream(dtd_tp, &app_es);
+    parsec_dtd_inserter_enter(dtd_tp, parsec_my_execution_stream());
+
 #if defined(PARSEC_PROF_TRACE)
     if( parsec_dtd_profile_verbose )
         parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
@@ -3183,7 +4267,8 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
             if( rank == -1 ) {
                 if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
                    (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+                   (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
                     rank = ((parsec_dtd_tile_t *)tile)->rank;
                 } else if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
                     rank = *(int *)tile;
@@ -3203,13 +4288,17 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
 
         if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
            (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+           (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
             flow_count_of_tc++;
             if( NULL != tile ) {
                 if( !(tile_op_type & PARSEC_DONT_TRACK)) {
                     if( PARSEC_INOUT == (tile_op_type & PARSEC_GET_OP_TYPE) ||
                         PARSEC_OUTPUT == (tile_op_type & PARSEC_GET_OP_TYPE)) {
                         write_flow_count++;
+                    } else if( PARSEC_ATOMIC_WRITE == (tile_op_type & PARSEC_GET_OP_TYPE) ) {
+                        /* the task is only retained for this flow if it is ordered as INOUT */
+                        atomic_write_flow_count++;
                     }
                 }
             }
@@ -3233,7 +4322,7 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
 #if defined(DISTRIBUTED)
     /* Safeguard: check that the rank has been set by affinity if it is needed */
     if( tp->context->nb_nodes > 1 ) {
-        if((-1 == rank) && (write_flow_count > 1)) {
+        if((-1 == rank) && (write_flow_count + atomic_write_flow_count > 1)) {
             parsec_fatal("You inserted a task without indicating where the task should be executed (using\n"
                          "PARSEC_AFFINITY flag). This will result in executing this task on all nodes and the outcome\n"
                          "might be not be what you want. So we are exiting for now. Please see the usage of\n"
@@ -3256,26 +4345,33 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
         tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
 
         if( NULL == tc ) {
-            dtd_tc = parsec_dtd_create_task_classv(name_of_kernel, nb_params, params);
-            tc = &dtd_tc->super;
-
-            __parsec_chore_t **incarnations = (__parsec_chore_t **)&tc->incarnations;
-            (*incarnations)[0].type = device_type;
-            if( device_type == PARSEC_DEV_CUDA ) {
-                /* Special case for CUDA: we need an intermediate */
-                (*incarnations)[0].hook = parsec_dtd_gpu_task_submit;
-                dtd_tc->gpu_func_ptr = (parsec_advance_task_function_t)fpointer;
-            }
-            else {
-                /* Default case: the user-provided function is directly the hook to call */
-                (*incarnations)[0].hook = fpointer; // We can directly call the CPU hook
-                dtd_tc->cpu_func_ptr = fpointer;
-            }
-            (*incarnations)[1].type = PARSEC_DEV_NONE;
+            /* Another thread might be creating the same task class */
+            parsec_atomic_lock(&dtd_tp->task_class_lock);
+            tc = (parsec_task_class_t *)parsec_dtd_find_task_class(dtd_tp, fkey);
+            if( NULL == tc ) {
+                dtd_tc = parsec_dtd_create_task_classv(name_of_kernel, nb_params, params);
+                tc = &dtd_tc->super;
+
+                __parsec_chore_t **incarnations = (__parsec_chore_t **)&tc->incarnations;
+                (*incarnations)[0].type = device_type;
+                if( device_type == PARSEC_DEV_CUDA ) {
+                    /* Special case for CUDA: we need an intermediate */
+                    (*incarnations)[0].hook = parsec_dtd_gpu_task_submit;
+                    dtd_tc->gpu_func_ptr = (parsec_advance_task_function_t)fpointer;
+                }
+                else {
+                    /* Default case: the user-provided function is directly the hook to call,
+                     * unless the durations of the bodies are measured */
+                    (*incarnations)[0].hook = (0 == parsec_dtd_inline_max_duration) ? fpointer : parsec_dtd_cpu_task_body;
+                    dtd_tc->cpu_func_ptr = fpointer;
+                }
+                (*incarnations)[1].type = PARSEC_DEV_NONE;
 
-            /* Bookkeeping of the task class */
-            parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
-            parsec_dtd_insert_task_class(dtd_tp, dtd_tc);
+                /* Bookkeeping of the task class */
+                parsec_dtd_insert_task_class(dtd_tp, dtd_tc);
+                parsec_dtd_register_task_class(&dtd_tp->super, fkey, tc);
+            }
+            parsec_atomic_unlock(&dtd_tp->task_class_lock);
         }
     }
 
@@ -3346,7 +4442,8 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
 
             if((tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
                (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
-               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ) {
+               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+               (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) {
                 parsec_dtd_set_params_of_task(this_task, tile, tile_op_type,
                                               &flow_index, NULL,
                                               NULL, arg_size);
@@ -3359,6 +4456,139 @@ __parsec_dtd_taskpool_create_task(parsec_taskpool_t *tp,
     assert(this_task->rank != -1);
 #endif
 
+    parsec_dtd_inserter_leave(dtd_tp);
+    parsec_dtd_return_execution_stream(borrowed);
+    return (parsec_task_t *)this_task;
+}
+
+/* **************************************************************************** */
+/**
+ * Create a task of a task class from an array of arguments
+ *
+ * The layout of the arguments was compiled with the task class: the
+ * access modes, the sizes of the values and the placement of the task come
+ * from the task class, only the tiles and the values are read here.
+ *
+ * @param[in]   tp
+ *                  The DTD taskpool
+ * @param[in]   tc
+ *                  A task class created with parsec_dtd_create_task_class()
+ * @param[in]   priority
+ *                  The priority of the task
+ * @param[in]   device_type
+ *                  The devices the task can execute on
+ * @param[in]   args
+ *                  One argument per parameter of the task class
+ * @return
+ *                  The task, not inserted yet
+ *
+ * @ingroup     DTD_INTERFACE_INTERNAL
+ */
+static inline parsec_task_t *
+__parsec_dtd_taskpool_create_task_with_args(parsec_taskpool_t *tp, parsec_task_class_t *tc,
+                                            int32_t priority, uint8_t device_type,
+                                            void * const *args)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)tc;
+    int rank = -1, write_flow_count = 1, atomic_write_flow_count = 0;
+    int flow_index = 0, i;
+    parsec_execution_stream_t app_es;
+    int borrowed;
+
+    if( tp->context == NULL) {
+        parsec_fatal("Sorry! You can not insert task without enqueuing the taskpool to parsec_context"
+                     " first. Please make sure you call parsec_context_add_taskpool(parsec_context, taskpool) before"
+                     " you try inserting task in PaRSEC\n");
+    }
+
+    borrowed = parsec_dtd_borrow_execution_stream(dtd_tp, &app_es);
+    parsec_dtd_inserter_enter(dtd_tp, parsec_my_execution_stream());
+
+#if defined(PARSEC_PROF_TRACE)
+    if( parsec_dtd_profile_verbose )
+        parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+
+    /* Only the tiles of the write flows need to be looked at */
+    for( i = 0; i < dtd_tc->count_of_params; i++ ) {
+        if( NULL == args[i] ) continue;
+        if( dtd_tc->write_params & ((uint64_t)1 << i) ) {
+            write_flow_count++;
+        } else if( dtd_tc->atomic_write_params & ((uint64_t)1 << i) ) {
+            atomic_write_flow_count++;
+        }
+    }
+
+    if( -1 != dtd_tc->affinity_param ) {
+        if( dtd_tc->flow_params & ((uint64_t)1 << dtd_tc->affinity_param) ) {
+            rank = ((parsec_dtd_tile_t *)args[dtd_tc->affinity_param])->rank;
+        } else {
+            rank = *(int *)args[dtd_tc->affinity_param];
+            if( rank < 0 || rank >= dtd_tp->super.context->nb_nodes ) {
+                parsec_warning("/!\\ Rank information passed to task is invalid,"
+                               " placing task in rank 0 /!\\\n");
+            }
+        }
+    }
+
+#if defined(DISTRIBUTED)
+    /* Safeguard: check that the rank has been set by affinity if it is needed */
+    if( tp->context->nb_nodes > 1 ) {
+        if((-1 == rank) && (write_flow_count + atomic_write_flow_count > 1)) {
+            parsec_fatal("You inserted a task of class '%s' without indicating where the task should be executed\n"
+                         "(using the PARSEC_AFFINITY flag in the task class).\n", tc->name);
+        } else if( rank == -1 && write_flow_count == 1 ) {
+            /* we have tasks with no real data as parameter so we are safe to execute it in each process */
+            rank = tp->context->my_rank;
+        }
+    } else {
+        rank = 0;
+    }
+#else
+    rank = 0;
+#endif
+
+    parsec_dtd_task_t *this_task = parsec_dtd_create_and_initialize_task(dtd_tp, tc, rank);
+
+    this_task->super.priority = priority;
+    this_task->super.chore_mask = 0;
+    /* We take only the chores that are defined and that allowed by the user */
+    for( i = 0; NULL != tc->incarnations[i].hook; i++ ) {
+        if( tc->incarnations[i].type & device_type ) {
+            this_task->super.chore_mask |= (1<<i);
+        }
+    }
+    assert(0 != this_task->super.chore_mask);
+
+    if( parsec_dtd_task_is_local(this_task)) {
+        parsec_object_t *object = (parsec_object_t *)this_task;
+        /* retaining the local task as many write flows as
+         * it has and one to indicate when we have executed the task */
+        (void)parsec_atomic_fetch_add_int32(&object->obj_reference_count, write_flow_count);
+
+        parsec_dtd_task_param_t *current_param = GET_HEAD_OF_PARAM_LIST(this_task);
+        void *current_val = GET_VALUE_BLOCK(current_param, dtd_tc->count_of_params);
+
+        for( i = 0; i < dtd_tc->count_of_params; i++ ) {
+            parsec_dtd_set_params_of_task(this_task, args[i], (int)dtd_tc->params[i].op,
+                                          &flow_index, &current_val,
+                                          current_param, (int)dtd_tc->params[i].size);
+            current_param->arg_size = (int)dtd_tc->params[i].size;
+            current_param->op_type = dtd_tc->params[i].op;
+            current_param = current_param + 1;
+        }
+    } else {
+        for( i = 0; i < dtd_tc->count_of_params; i++ ) {
+            if( !(dtd_tc->flow_params & ((uint64_t)1 << i)) ) continue;
+            parsec_dtd_set_params_of_task(this_task, args[i], (int)dtd_tc->params[i].op,
+                                          &flow_index, NULL,
+                                          NULL, PASSED_BY_REF);
+        }
+    }
+
+    parsec_dtd_inserter_leave(dtd_tp);
+    parsec_dtd_return_execution_stream(borrowed);
     return (parsec_task_t *)this_task;
 }
 
@@ -3430,6 +4660,52 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
     }
 }
 
+void
+parsec_dtd_insert_task_with_args(parsec_taskpool_t *tp,
+                                 parsec_task_class_t *tc, int priority,
+                                 int device_type,
+                                 void * const *args)
+{
+    parsec_task_t *this_task = __parsec_dtd_taskpool_create_task_with_args(tp, tc, priority,
+                                                                           device_type, args);
+
+    if( NULL != this_task ) {
+        parsec_insert_dtd_task(this_task);
+    } else {
+        parsec_fatal("Unknown Error! Could not create task\n");
+    }
+}
+
+parsec_task_t *
+parsec_dtd_create_task_with_args(parsec_taskpool_t *tp,
+                                 parsec_task_class_t *tc, int priority,
+                                 int device_type,
+                                 void * const *args)
+{
+    return __parsec_dtd_taskpool_create_task_with_args(tp, tc, priority, device_type, args);
+}
+
+void
+parsec_dtd_insert_tasks_with_args(parsec_taskpool_t *tp,
+                                  parsec_task_class_t *tc, int priority,
+                                  int device_type, int nb_tasks,
+                                  void * const *args)
+{
+    parsec_task_t *tasks[PARSEC_DTD_BATCH_SIZE];
+    int nb_params = ((parsec_dtd_task_class_t *)tc)->count_of_params;
+    int i, j;
+
+    /* The tasks are inserted in batches of bounded size, to bound the
+     * tasks that are ready but not scheduled yet */
+    for( i = 0; i < nb_tasks; i += j ) {
+        for( j = 0; j < PARSEC_DTD_BATCH_SIZE && i + j < nb_tasks; j++ ) {
+            tasks[j] = __parsec_dtd_taskpool_create_task_with_args(tp, tc, priority, device_type,
+                                                                   args + (size_t)(i + j) * nb_params);
+        }
+        parsec_insert_dtd_tasks(tasks, j);
+    }
+}
+
 parsec_task_t *
 parsec_dtd_create_task(parsec_taskpool_t *tp,
                        parsec_dtd_funcptr_t *fpointer, int priority,
@@ -30,11 +30,11 @@ BEGIN_C_DECLS
  *  PARSEC_INPUT:        Data is used in read-only mode, no modification is done.
  *  PARSEC_OUTPUT:       Data is used in write-only, written only, not read.
  *  PARSEC_INOUT:        Data is read and written both.
- *  PARSEC_ATOMIC_WRITE: Data is used like OUTPUT but the ordering of the tasks having this flag is not maintained
- *                       by the scheduler.
- *                       It is the responsibility of the user to make sure data is written atomically.
- *                       Treated like PARSEC_INPUT by the scheduler.
- *                       This flag is not currently VALID, please refrain from using it.
+ *  PARSEC_ATOMIC_WRITE: Data is read and written like INOUT, but the updates are commutative: consecutive
+ *                       tasks using this flag on the same data are released together and executed in any
+ *                       order, one at a time (the runtime serializes them with a per-data lock). Readers and
+ *                       writers inserted before or after such a sequence are ordered with it as usual.
+ *                       Tasks using this flag on a data held by another process are ordered like INOUT.
  *  PARSEC_SCRATCH:      Will be used by the task as scratch pad, does not effect the DAG, tells the runtime
  *                       to allocate memory specified by the user.
  *                       This flag can also be used to pass pointer of any variable. Please look at the usage below.
@@ -53,7 +53,7 @@ BEGIN_C_DECLS
 typedef enum { PARSEC_INPUT =      0x100000,
                PARSEC_OUTPUT =     0x200000,
                PARSEC_INOUT =      0x300000,
-               PARSEC_ATOMIC_WRITE=0x400000, /* DO NOT USE ,Iterate_successors do not support this at this point */
+               PARSEC_ATOMIC_WRITE=0x400000, /* Commutative (unordered, mutually exclusive) updates */
                PARSEC_SCRATCH =    0x500000,
                PARSEC_VALUE =      0x600000,
                PARSEC_REF =        0x700000,
@@ -134,9 +134,33 @@ int parsec_dtd_destroy_arena_datatype(parsec_context_t *ctx, int id);
  * The parsec_dtd_threshold_size indicates the number of tasks, reaching which
  * the main thread will resume inserting tasks again.
  * The threshold should always be smaller than the window size.
+ *
+ * With "--mca dtd_window_adaptive 1" the window size becomes an upper
+ * bound: each taskpool starts with a small window, grows it while the
+ * workers starve and shrinks it when the ready tasks pile up or when the
+ * memory held by the tasks in flight exceeds dtd_window_max_memory (in MB,
+ * 0 for no bound). The window never gets below dtd_window_min_size tasks.
  */
 extern int parsec_dtd_window_size;
 extern int parsec_dtd_threshold_size;
+extern int parsec_dtd_window_adaptive;
+extern int parsec_dtd_window_min_size;
+extern int parsec_dtd_window_max_memory;
+
+/**
+ * With "--mca dtd_inline_max_duration <ns>" the durations of the CPU bodies
+ * of the DTD tasks are measured, and the tasks whose bodies last at most
+ * that long on average are executed by their inserter when they are ready
+ * at insertion (see parsec_dtd_task_class_set_inline()).
+ */
+extern int parsec_dtd_inline_max_duration;
+
+/**
+ * With "--mca dtd_flush_batch_size <n>" parsec_dtd_data_flush_all() groups
+ * the tiles by last writer and owner, and writes back up to n of them
+ * (at most MAX_PARAM_COUNT) with a single task on each of the two ranks.
+ */
+extern int parsec_dtd_flush_batch_size;
 
 
 typedef struct parsec_dtd_tile_s         parsec_dtd_tile_t;
@@ -276,6 +300,17 @@ parsec_dtd_tile_t * parsec_dtd_tile_new(parsec_taskpool_t *dtd_tp, int rank);
  *      *******  THIS PARAMETER MUST BE PROVIDED *******
  *      4. "0" indicates the end of parameter list. This should always be the last parameter.
  *
+ *    Tasks can be inserted concurrently in the same taskpool by several threads: the
+ *    threads of the application, the thread that initialized PaRSEC and tasks inserting
+ *    tasks. The tasks using the same data are ordered as their insertions reach that data,
+ *    the application must order the insertions of the tasks sharing a data (e.g. insert
+ *    them from the same thread). The tasks using several data are linked to them one task
+ *    at a time, so two tasks are ordered the same way on all the data they share. The
+ *    threads of the application do not execute tasks: the context must have been started
+ *    (parsec_context_start()), and they wait for the PaRSEC threads at the end of a window.
+ *    With several processes the tasks must be inserted in the same order by all processes,
+ *    hence by a single thread at a time: concurrent insertions are a fatal error.
+ *
  */
 void
 parsec_dtd_insert_task(parsec_taskpool_t  *tp,
@@ -308,6 +343,15 @@ parsec_dtd_create_task(parsec_taskpool_t  *tp,
 void
 parsec_insert_dtd_task(parsec_task_t *this_task);
 
+/**
+ * This function inserts nb_tasks properly formed DTD tasks of the same
+ * taskpool in PaRSEC, in order. The tasks that are ready at insertion are
+ * scheduled together once all the tasks are inserted, and the window of
+ * task insertion is only checked at the end of the batch.
+ */
+void
+parsec_insert_dtd_tasks(parsec_task_t **tasks, int nb_tasks);
+
 /**
  * This function should be called anytime users
  * are using data in their parsec-dtd runs.
@@ -354,7 +398,8 @@ parsec_dtd_data_flush( parsec_taskpool_t   *tp,
 /**
  * This function flushes all the data of a dc(data collection).
  * This function must be called for all dc(s) before
- * parsec_context_wait() is called.
+ * parsec_context_wait() is called. The tiles are written back
+ * in batches if parsec_dtd_flush_batch_size is set.
  */
 int
 parsec_dtd_data_flush_all( parsec_taskpool_t *tp,
@@ -397,11 +442,165 @@ parsec_dtd_insert_task_with_task_class(parsec_taskpool_t *tp,
                                        int device_type,
                                        ...);
 
+/**
+ * Insert a task of a task class created with parsec_dtd_create_task_class()
+ * without going through a variadic list of arguments. The layout of the
+ * parameters is compiled once in the task class: the access modes, the
+ * arenas, the sizes of the values and the placement of the tasks
+ * (PARSEC_AFFINITY) are all taken from the task class, and cannot be
+ * changed per task.
+ * args holds one entry per parameter of the task class, in order:
+ *  - the tile (parsec_dtd_tile_t *) of a PASSED_BY_REF parameter, or NULL;
+ *  - the address of the value of a PARSEC_VALUE parameter, which is copied;
+ *  - the pointer of a PARSEC_REF parameter;
+ *  - NULL or the memory of a PARSEC_SCRATCH parameter.
+ * The array can be reused as soon as the call returns.
+ */
+void
+parsec_dtd_insert_task_with_args(parsec_taskpool_t *tp,
+                                 parsec_task_class_t *tc, int priority,
+                                 int device_type,
+                                 void * const *args);
+
+/**
+ * Same as parsec_dtd_insert_task_with_args(), but the task is only
+ * created. It has to be inserted with parsec_insert_dtd_task().
+ */
+parsec_task_t *
+parsec_dtd_create_task_with_args(parsec_taskpool_t *tp,
+                                 parsec_task_class_t *tc, int priority,
+                                 int device_type,
+                                 void * const *args);
+
+/**
+ * Insert nb_tasks tasks of the task class tc, as with
+ * parsec_dtd_insert_task_with_args(). args holds the arguments of the
+ * tasks one after the other, count of parameters of tc entries per task.
+ * The tasks are inserted in order, and the tasks they make ready are
+ * scheduled together.
+ */
+void
+parsec_dtd_insert_tasks_with_args(parsec_taskpool_t *tp,
+                                  parsec_task_class_t *tc, int priority,
+                                  int device_type, int nb_tasks,
+                                  void * const *args);
+
+/**
+ * Hints on the execution of the tasks of a task class by the thread that
+ * inserts them. A task that is ready when it is inserted, and that can only
+ * execute on a CPU, can be executed right away by its inserter instead of
+ * going through the scheduler.
+ */
+typedef enum {
+    PARSEC_DTD_INLINE_NEVER    = -1, /**< the tasks always go through the scheduler */
+    PARSEC_DTD_INLINE_MEASURED = 0,  /**< the tasks are inlined when their measured bodies last
+                                      *   at most dtd_inline_max_duration ns (the default) */
+    PARSEC_DTD_INLINE_ALWAYS   = 1   /**< the tasks ready at insertion are always inlined */
+} parsec_dtd_inline_hint_t;
+
+/**
+ * Sets the inline execution hint of the DTD task class tc.
+ * Returns PARSEC_ERR_BAD_PARAM if tc is not a DTD task class.
+ */
+int
+parsec_dtd_task_class_set_inline(parsec_task_class_t *tc, parsec_dtd_inline_hint_t hint);
+
 void
 parsec_dtd_register_task_class(parsec_taskpool_t *tp,
                                uint64_t key,
                                parsec_task_class_t *value);
 
+/**
+ * A recorded sequence of task insertions, see parsec_dtd_graph_record_begin().
+ * The content of a graph is immutable once the recording is over.
+ */
+typedef struct parsec_dtd_graph_s parsec_dtd_graph_t;
+
+/**
+ * Callback invoked by parsec_dtd_graph_replay() on every local task before
+ * it is inserted.
+ * 1. The index of the task in the recording order (the same on all ranks)
+ * 2. The number of parameters of the task
+ * 3. For each parameter, a pointer to the copy of the PARSEC_VALUE argument
+ *    stored in the task (initialized with the recorded value), or NULL for
+ *    any other type of parameter. The callback can update these values.
+ * 4. The cb_data passed to parsec_dtd_graph_replay()
+ */
+typedef void (parsec_dtd_graph_update_t)(int task_index, int nb_params,
+                                         void **values, void *cb_data);
+
+/**
+ * Start recording the tasks inserted in the taskpool. Tasks are inserted
+ * and executed as usual while they are recorded, only the tasks inserted
+ * by the user are recorded (the runtime inserts its own tasks again
+ * during the replay). Tasks must be inserted by a single thread while
+ * the taskpool is recording. Returns PARSEC_ERR_EXISTS if the taskpool
+ * is already recording.
+ */
+int
+parsec_dtd_graph_record_begin(parsec_taskpool_t *tp);
+
+/**
+ * Stop recording and return the graph of the tasks inserted since
+ * parsec_dtd_graph_record_begin(), or NULL if the taskpool was not
+ * recording.
+ */
+parsec_dtd_graph_t *
+parsec_dtd_graph_record_end(parsec_taskpool_t *tp);
+
+/**
+ * Insert again in the taskpool, in the same order, all the tasks of
+ * the graph. The argument parsing, the task class and tile lookups and
+ * the placement of the tasks are skipped. On a single process, the tasks
+ * are linked with the edges of the recording, only their first access to
+ * each data is tracked against the current state of the data, and the
+ * graph is released to the scheduler as a whole.
+ * The value of the PARSEC_VALUE arguments can be changed through the
+ * optional update callback, the placement of the tasks cannot.
+ * All processes must replay the same graph.
+ *
+ * Limitation: the recorded edges are only replayed by a taskpool running
+ * on a single process, without parsec_dtd_taskpool_set_neighbors(), and
+ * for graphs without PARSEC_ATOMIC_WRITE flows nor tasks using the same
+ * data in several flows. The edges do not record the remote tasks and the
+ * communications between the processes. In all the other cases, the
+ * replay only skips the argument parsing and the lookups, and the
+ * dependencies of every replayed task are tracked as for any other
+ * insertion.
+ */
+int
+parsec_dtd_graph_replay(parsec_taskpool_t *tp, const parsec_dtd_graph_t *graph,
+                        parsec_dtd_graph_update_t *update, void *cb_data);
+
+/**
+ * Returns the number of tasks recorded in the graph, local or remote.
+ */
+int
+parsec_dtd_graph_nb_tasks(const parsec_dtd_graph_t *graph);
+
+/**
+ * Release a graph. Graphs must be released before the taskpool they
+ * were recorded in.
+ */
+void
+parsec_dtd_graph_free(parsec_dtd_graph_t *graph);
+
+/**
+ * Declare the processes this one exchanges data with, to insert tasks at a
+ * cost that depends on the local work instead of the global number of
+ * tasks. The remote tasks accessing only data owned by other processes
+ * than this one and its neighbors are then discarded at insertion, instead
+ * of being kept to track their dependencies: only the rank of the last
+ * writer of these data is kept, for the tasks the runtime inserts on them.
+ * The local tasks must only access data owned by this process or its
+ * neighbors. Must be called after the taskpool is added to the context and
+ * before any task is inserted. Returns PARSEC_ERR_BAD_PARAM on an invalid
+ * rank and PARSEC_ERR_NOT_SUPPORTED if tasks were already inserted.
+ */
+int
+parsec_dtd_taskpool_set_neighbors(parsec_taskpool_t *tp, int nb_neighbors,
+                                  const int *neighbors);
+
 /**
  * @}
  */
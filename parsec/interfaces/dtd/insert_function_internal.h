@@ -29,6 +29,10 @@
 BEGIN_C_DECLS
 
 #define PARSEC_DTD_NB_TASK_CLASSES  25 /*< Max number of task classes allowed */
+#define PARSEC_DTD_BATCH_SIZE       64 /*< Max number of tasks of a batch scheduled together */
+#define PARSEC_DTD_INLINE_MIN_MEASURES 4 /*< Measured executions of a body before its tasks can be inlined */
+#define PARSEC_DTD_TILE_CACHE_SIZE  16 /*< Tiles remembered by each execution stream, a power of 2 */
+#define PARSEC_DTD_TILE_CACHE_NB_ES 64 /*< Execution streams of a data collection that have a tile cache */
 
 typedef struct parsec_dtd_task_param_s  parsec_dtd_task_param_t;
 
@@ -38,6 +42,7 @@ extern int hashtable_trace_keyout;
 extern int insert_task_trace_keyin;
 extern int insert_task_trace_keyout;
 extern int parsec_dtd_debug_output;
+extern int parsec_dtd_profile_verbose;
 extern int parsec_dtd_dump_traversal_info; /**< For printing traversal info */
 
 #define PARSEC_DTD_FLUSH_TC_ID    ((uint8_t)0x00)
@@ -61,6 +66,12 @@ extern int parsec_dtd_dump_traversal_info; /**< For printing traversal info */
                                 TILE->last_writer.task        = NULL;                   \
                                 TILE->last_writer.alive       = TASK_IS_NOT_ALIVE;      \
                                 parsec_atomic_unlock(&TILE->last_writer.atomic_lock);   \
+                                                                                        \
+                                TILE->last_op_type = -1;                                \
+                                parsec_atomic_unlock(&TILE->atomic_write_lock);         \
+                                                                                        \
+                                TILE->pruned_writer_rank = -1;                          \
+                                TILE->pruned_last_user   = (parsec_key_t)-1;            \
 
 #define READ_FROM_TILE(TO, FROM) TO.task       = FROM.task;                             \
                                  TO.flow_index = FROM.flow_index;                       \
@@ -208,10 +219,36 @@ struct parsec_dtd_tile_s {
     parsec_data_collection_t *dc;
     parsec_dtd_tile_user_t    last_user;
     parsec_dtd_tile_user_t    last_writer;
+    int32_t                   last_op_type;       /* op type of the last tracked access, the same on all ranks */
+    parsec_atomic_lock_t      atomic_write_lock;  /* held by the PARSEC_ATOMIC_WRITE task updating the tile */
+    int32_t                   pruned_writer_rank; /* on a tile pruned by this rank, rank of the last writer */
+    parsec_key_t              pruned_last_user;   /* on a tile pruned by this rank, key of the last user */
 };
 /* For creating objects of class parsec_dtd_tile_t */
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_dtd_tile_t);
 
+/**
+ * The tiles an execution stream looked up last in a data collection,
+ * indexed by the low bits of their key. The cache is emptied when a tile
+ * was removed from the data collection since it was filled.
+ */
+typedef struct parsec_dtd_tile_cache_s {
+    int32_t            nb_removals;
+    parsec_dtd_tile_t *tiles[PARSEC_DTD_TILE_CACHE_SIZE];
+} parsec_dtd_tile_cache_t;
+
+/**
+ * Tile hash table of a data collection. The lookups by the execution
+ * streams go through their own cache before the shared hash table.
+ */
+typedef struct parsec_dtd_tile_table_s {
+    parsec_hash_table_t     super;
+    int32_t                 nb_removals; /* tiles removed from the hash table */
+    parsec_dtd_tile_cache_t caches[PARSEC_DTD_TILE_CACHE_NB_ES];
+} parsec_dtd_tile_table_t;
+
+PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(parsec_dtd_tile_table_t);
+
 /* for testing abstraction for PaRsec */
 struct hook_info {
     parsec_hook_t *hook;
@@ -224,20 +261,38 @@ struct parsec_dtd_taskpool_s {
     parsec_taskpool_t            super;
     parsec_thread_mempool_t     *mempool_owner;
     int                          enqueue_flag;
-    int                          task_id;
-    int                          task_window_size;
+    int32_t                      task_id;
+    int32_t                      task_window_size;
     int32_t                      task_threshold_size;
     int                          total_tasks_to_be_exec;
-    uint32_t                     local_task_inserted;  /* don't waste an atomic operation
-                                                          on this, it can be loosely connected
-                                                          to the number of locally inserted
-                                                          tasks. */
+    int32_t                      local_task_inserted;  /* updated atomically, several threads
+                                                          can insert tasks concurrently */
     uint8_t                      flow_set_flag[PARSEC_DTD_NB_TASK_CLASSES];
+    parsec_atomic_lock_t         task_class_lock;      /* protects the creation of the task
+                                                          classes and of their flows */
+    volatile int32_t             link_ticket_next;     /* tickets ordering the tasks with several
+                                                          tiles, which link their tiles one task */
+    volatile int32_t             link_ticket_served;   /* at a time */
+    parsec_execution_stream_t * volatile link_holder;  /* stream linking the tiles of such a task */
+    parsec_execution_stream_t * volatile inserter;     /* with several processes, the only stream
+                                                          creating and linking tasks */
+    int32_t                      inserter_depth;       /* nested insertions of the inserter */
     int64_t                      new_tile_keys;
     parsec_data_collection_t     new_tile_dc;
     parsec_mempool_t            *hash_table_bucket_mempool;
     parsec_hash_table_t         *task_hash_table;
     parsec_hash_table_t         *function_h_table;
+    parsec_dtd_graph_t          *graph_recording; /* graph recording the inserted tasks, if any */
+    uint8_t                     *tracked_ranks;   /* ranks whose tiles are tracked by this rank,
+                                                     NULL if all are (no task is pruned) */
+    int32_t                      nb_pruned_tasks;
+    parsec_task_class_t         *flush_batch_tc;  /* task class of the batched flushes, created by the first one */
+    /* feedback of the adaptive window, only tracked if window_adaptive */
+    int32_t                      window_adaptive;
+    int32_t                      ready_tasks;          /* local tasks ready or executing */
+    int64_t                      memory_in_flight;     /* estimated memory of the local tasks in flight */
+    int32_t                      window_idle_permille; /* idle time of the inserter during the last drain */
+    int32_t                      window_memory_shrink; /* local tasks inserted at the last halving for memory */
     /* from here to end is for the testing interface */
     struct hook_info             actual_hook[PARSEC_DTD_NB_TASK_CLASSES];
 };
@@ -257,6 +312,14 @@ struct parsec_dtd_task_class_s {
     int8_t                     count_of_params;
     int                        ref_count;
     parsec_dtd_param_t        *params;
+    /* Layout of the parameters, compiled when the task class is created */
+    int8_t                     affinity_param;     /**< first parameter placing the tasks, -1 if none */
+    uint64_t                   flow_params;        /**< mask of the PASSED_BY_REF parameters */
+    uint64_t                   write_params;       /**< mask of the tracked INOUT and OUTPUT parameters */
+    uint64_t                   atomic_write_params; /**< mask of the tracked ATOMIC_WRITE parameters */
+    int8_t                     inline_hint;        /**< parsec_dtd_inline_hint_t of the task class */
+    int32_t                    nb_body_durations;  /**< number of measured executions of the CPU body */
+    int64_t                    body_duration;      /**< moving average of the CPU body duration, in ns */
     parsec_hook_t             *cpu_func_ptr;
     parsec_advance_task_function_t gpu_func_ptr;
 };
@@ -332,6 +395,27 @@ void
 parsec_execute_and_come_back( parsec_taskpool_t  *tp,
                               int task_threshold_count );
 
+/* A thread that is not a PaRSEC thread inserts tasks with an execution
+ * stream borrowed for the duration of the call, see insert_function.c */
+int
+parsec_dtd_borrow_execution_stream( parsec_dtd_taskpool_t *tp,
+                                    parsec_execution_stream_t *app_es );
+
+void
+parsec_dtd_return_execution_stream( int borrowed );
+
+int
+parsec_dtd_schedule( parsec_execution_stream_t *es,
+                     parsec_task_t *tasks_ring );
+
+/* The tasks linking several tiles link them one task at a time */
+void
+parsec_dtd_link_alone_begin( parsec_dtd_taskpool_t *tp,
+                             parsec_execution_stream_t *es );
+
+void
+parsec_dtd_link_alone_end( parsec_dtd_taskpool_t *tp );
+
 parsec_dep_t *
 parsec_dtd_find_and_return_dep( parsec_dtd_task_t *parent_task,
                                 parsec_dtd_task_t *desc_task,
@@ -388,6 +472,10 @@ int
 parsec_dtd_data_flush_sndrcv(parsec_execution_stream_t *es,
                              parsec_task_t *this_task);
 
+int
+parsec_dtd_data_flush_batch_body(parsec_execution_stream_t *es,
+                                 parsec_task_t *this_task);
+
 void
 parsec_dtd_remote_task_retain(parsec_dtd_task_t *this_task);
 
@@ -396,6 +484,13 @@ parsec_dtd_set_flow_in_function( parsec_dtd_taskpool_t *dtd_tp,
                       parsec_dtd_task_t *this_task, int tile_op_type,
                       int flow_index);
 
+void
+set_dependencies_for_function(parsec_taskpool_t *tp,
+                              parsec_task_class_t *parent_tc,
+                              parsec_task_class_t *desc_tc,
+                              uint8_t parent_flow_index,
+                              uint8_t desc_flow_index);
+
 void
 parsec_dtd_set_parent(parsec_dtd_task_t *parent_task, uint8_t parent_flow_index,
                       parsec_dtd_task_t *desc_task, uint8_t desc_flow_index,
@@ -408,14 +503,58 @@ parsec_dtd_set_descendant(parsec_dtd_task_t *parent_task, uint8_t parent_flow_in
 
 int
 parsec_dtd_schedule_task_if_ready(int satisfied_flow, parsec_dtd_task_t *this_task,
-                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid);
+                                  parsec_dtd_taskpool_t *dtd_tp, int *vpid,
+                                  parsec_task_t **ready_ring);
 
 int
-parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int task_threshold);
+parsec_dtd_block_if_threshold_reached(parsec_dtd_taskpool_t *dtd_tp, int32_t nb_inserted,
+                                      int32_t nb_new, int task_threshold);
+
+void
+parsec_dtd_window_task_inserted(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task);
+
+void
+parsec_dtd_window_task_ready(parsec_dtd_taskpool_t *dtd_tp);
+
+void
+parsec_dtd_window_task_completed(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task);
+
+void
+parsec_dtd_set_flows_of_task_class(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_task_t *this_task);
+
+void
+parsec_dtd_insert_fake_first_out(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_tile_t *tile,
+                                 int tile_op_type, parsec_task_t **ready_ring);
+
+void
+parsec_dtd_graph_record_task(parsec_dtd_graph_t *graph, parsec_dtd_task_t *this_task);
 
 void
 parsec_dtd_fini();
 
+/***************************************************************************//**
+ *
+ * Check if this rank prunes the tasks accessing a tile, see
+ * parsec_dtd_taskpool_set_neighbors()
+ *
+ * @ingroup         DTD_INTERFACE_INTERNAL
+ *
+ ******************************************************************************/
+static inline int
+parsec_dtd_tile_is_pruned( parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_tile_t *tile )
+{
+    return (NULL != dtd_tp->tracked_ranks) && (0 == dtd_tp->tracked_ranks[tile->rank]);
+}
+
+/* The tasks of the flush task classes hold a reference on their tiles */
+static inline int
+parsec_dtd_task_holds_tiles( parsec_dtd_task_t *this_task )
+{
+    const parsec_task_class_t *tc = this_task->super.task_class;
+    return (PARSEC_DTD_FLUSH_TC_ID == tc->task_class_id) ||
+           (tc == ((parsec_dtd_taskpool_t *)this_task->super.taskpool)->flush_batch_tc);
+}
+
 static inline void
 parsec_dtd_retain_data_copy( parsec_data_copy_t *data )
 {
@@ -123,7 +123,9 @@ release_ownership_of_data(parsec_dtd_task_t *current_task, int flow_index)
  * the descendant of a task for each flow and put them in a list.
  * This is helpful in terms of creating chains of PARSEC_INPUT tasks.
  * INPUT tasks are activated if they are found in successions,
- * and they are treated the same way.
+ * and they are treated the same way. PARSEC_ATOMIC_WRITE tasks are
+ * chained the same way, their mutual exclusion is enforced when they
+ * execute.
  *
  * @param[in]   es
  *                  Execution unit
@@ -173,7 +175,9 @@ parsec_dtd_ordering_correctly( parsec_execution_stream_t *es,
             }
 
             if(action_mask & PARSEC_ACTION_RELEASE_LOCAL_DEPS) {
-                if( PARSEC_INPUT == op_type_on_current_flow ) {
+                /* PARSEC_ATOMIC_WRITE tasks are chained, and counted, as readers */
+                if( PARSEC_INPUT == op_type_on_current_flow ||
+                    PARSEC_ATOMIC_WRITE == op_type_on_current_flow ) {
                     if(parsec_dtd_task_is_local(current_task)){
                        (void)parsec_atomic_fetch_dec_int32( &current_task->super.data[current_dep].data_out->readers );
                     }
@@ -59,6 +59,44 @@ parsec_dtd_data_flush_sndrcv(parsec_execution_stream_t *es,
     return PARSEC_HOOK_RETURN_DONE;
 }
 
+/**
+ * This is the body of the tasks of a batched flush. The task on the
+ * owner of the tiles copies back the versions it received, the task on
+ * the last writer of the tiles only sends them.
+ */
+int
+parsec_dtd_data_flush_batch_body(parsec_execution_stream_t *es,
+                                 parsec_task_t *this_task)
+{
+    (void)es;
+#if defined(DISTRIBUTED)
+    parsec_arena_datatype_t *adt;
+    parsec_dtd_task_t *current_task = (parsec_dtd_task_t *)this_task;
+    int flow_index;
+
+    for( flow_index = 0; flow_index < this_task->task_class->nb_flows; flow_index++ ) {
+        parsec_dtd_tile_t *tile = (FLOW_OF(current_task, flow_index))->tile;
+        if( NULL == tile || tile->rank != current_task->rank ) continue;
+        if( current_task->super.data[flow_index].data_in != tile->data_copy ) {
+            int16_t index = (FLOW_OF(current_task, flow_index))->arena_index;
+            parsec_dep_data_description_t data;
+            data.data   = current_task->super.data[flow_index].data_in;
+            adt = parsec_dtd_get_arena_datatype(this_task->taskpool->context, index);
+            data.local.arena = adt->arena;
+            data.local.src_datatype = data.local.dst_datatype = adt->opaque_dtt;
+            data.local.src_count = data.local.dst_count = 1;
+            data.local.src_displ = data.local.dst_displ = 0;
+            parsec_remote_dep_memcpy(es, this_task->taskpool,
+                         tile->data_copy, current_task->super.data[flow_index].data_in, &data);
+        }
+    }
+#else
+    (void)this_task;
+#endif
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
 /**
  * For general tasks we set the dependencies between
  * the task classes in a generic way. Data flush tasks
@@ -120,6 +158,7 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
 
     int flow_index = 0;
     int satisfied_flow = 0, tile_op_type = PARSEC_INOUT;
+    int32_t nb_inserted = 0, nb_new = 0;
     static int vpid = 0;
 
     if( NULL == tile ) {
@@ -133,9 +172,15 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
 
     parsec_dtd_tile_user_t last_user, last_writer;
     if(0 == dtd_tp->flow_set_flag[tc->task_class_id]) {
-        /* Setting flow in function structure */
-        parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
-        set_deps_for_flush_task(tc);
+        parsec_atomic_lock(&dtd_tp->task_class_lock);
+        if(0 == dtd_tp->flow_set_flag[tc->task_class_id]) {
+            /* Setting flow in function structure */
+            parsec_dtd_set_flow_in_function(dtd_tp, this_task, tile_op_type, flow_index);
+            set_deps_for_flush_task(tc);
+            parsec_atomic_wmb();
+            dtd_tp->flow_set_flag[tc->task_class_id] = 1;
+        }
+        parsec_atomic_unlock(&dtd_tp->task_class_lock);
     }
 
     (FLOW_OF(this_task, flow_index))->arena_index = tile->arena_index;
@@ -163,6 +208,7 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
     tile->last_user.flow_index = flow_index;
     tile->last_user.op_type    = tile_op_type;
     tile->last_user.alive      = TASK_IS_ALIVE;
+    tile->last_op_type         = tile_op_type;
 
     if( parsec_dtd_task_is_remote( this_task ) ) {
         if( parsec_dtd_task_is_local( last_writer.task ) ) {
@@ -222,11 +268,13 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
         parsec_dtd_remote_task_release( last_writer.task );
     }
 
-    dtd_tp->flow_set_flag[tc->task_class_id] = 1;
-
     if( parsec_dtd_task_is_local(this_task) ) {/* Task is local */
         dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, 1);
-        dtd_tp->local_task_inserted++;
+        nb_inserted = parsec_atomic_fetch_inc_int32(&dtd_tp->local_task_inserted);
+        nb_new = 1;
+        if( dtd_tp->window_adaptive ) {
+            parsec_dtd_window_task_inserted(dtd_tp, this_task);
+        }
         PARSEC_DEBUG_VERBOSE(parsec_dtd_dump_traversal_info, parsec_dtd_debug_output,
                              "Task generated -> %s %d rank %d\n", this_task->super.task_class->name, this_task->ht_item.key, this_task->rank);
     }
@@ -243,10 +291,10 @@ parsec_insert_dtd_flush_task(parsec_dtd_task_t *this_task, parsec_dtd_tile_t *ti
 
     if( parsec_dtd_task_is_local(this_task) ) {
         parsec_dtd_schedule_task_if_ready(satisfied_flow, this_task,
-                                          dtd_tp, &vpid);
+                                          dtd_tp, &vpid, NULL);
     }
 
-    parsec_dtd_block_if_threshold_reached(dtd_tp, parsec_dtd_threshold_size);
+    parsec_dtd_block_if_threshold_reached(dtd_tp, nb_inserted, nb_new, parsec_dtd_threshold_size);
 
     return 1;
 }
@@ -304,8 +352,22 @@ parsec_dtd_insert_flush_task(parsec_taskpool_t *tp, parsec_dtd_tile_t *tile, int
 int
 parsec_dtd_insert_flush_task_pair(parsec_taskpool_t *tp, parsec_dtd_tile_t *tile)
 {
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
     parsec_dtd_tile_user_t last_writer;
 
+    if( parsec_dtd_tile_is_pruned(dtd_tp, tile) ) {
+        /* The flush tasks of a tile pruned by this rank are remote, only
+         * their ids are taken to remain in sync with the other ranks */
+        int writer_rank;
+        parsec_dtd_last_user_lock(&(tile->last_user));
+        writer_rank = tile->pruned_writer_rank;
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+        if( -1 != writer_rank ) {
+            (void)parsec_atomic_fetch_add_int32(&dtd_tp->task_id, (writer_rank != tile->rank) ? 2 : 1);
+        }
+        return 1;
+    }
+
     parsec_dtd_last_user_lock(&(tile->last_user));
     READ_FROM_TILE(last_writer, tile->last_writer);
     parsec_dtd_last_user_unlock(&(tile->last_user));
@@ -366,10 +428,211 @@ parsec_internal_dtd_data_flush(parsec_dtd_tile_t *tile, parsec_taskpool_t *tp)
 int
 parsec_dtd_data_flush(parsec_taskpool_t *tp, parsec_dtd_tile_t *tile)
 {
+    parsec_execution_stream_t app_es;
+    int borrowed = parsec_dtd_borrow_execution_stream((parsec_dtd_taskpool_t *)tp, &app_es);
+
     parsec_internal_dtd_data_flush(tile, tp);
+    parsec_dtd_return_execution_stream(borrowed);
     return PARSEC_SUCCESS; /* TODO: internal_dtd_data_flush should care for error codepaths */
 }
 
+/**
+ * The tiles of a batched flush, which have the same last writer and owner
+ */
+typedef struct parsec_dtd_flush_batch_s {
+    int                writer_rank;
+    int                owner_rank;
+    int                nb_tiles;
+    parsec_dtd_tile_t *tiles[MAX_PARAM_COUNT];
+} parsec_dtd_flush_batch_t;
+
+/**
+ * The tiles of a data collection, in the order of its hash table
+ */
+typedef struct parsec_dtd_flush_tiles_s {
+    int                 nb_tiles;
+    int                 size;
+    parsec_dtd_tile_t **tiles;
+} parsec_dtd_flush_tiles_t;
+
+static void
+parsec_dtd_flush_collect_tile(parsec_dtd_tile_t *tile, parsec_dtd_flush_tiles_t *tiles)
+{
+    if( tiles->nb_tiles == tiles->size ) {
+        tiles->size = (0 == tiles->size) ? 64 : 2 * tiles->size;
+        tiles->tiles = (parsec_dtd_tile_t **)realloc(tiles->tiles, tiles->size * sizeof(parsec_dtd_tile_t *));
+    }
+    tiles->tiles[tiles->nb_tiles++] = tile;
+}
+
+/**
+ * Returns the rank of the last writer of a tile, -1 if it was never written
+ */
+static int
+parsec_dtd_flush_writer_rank(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_tile_t *tile)
+{
+    int writer_rank;
+
+    parsec_dtd_last_user_lock(&(tile->last_user));
+    if( parsec_dtd_tile_is_pruned(dtd_tp, tile) ) {
+        writer_rank = tile->pruned_writer_rank;
+    } else {
+        writer_rank = (NULL == tile->last_writer.task) ? -1 : tile->last_writer.task->rank;
+    }
+    parsec_dtd_last_user_unlock(&(tile->last_user));
+    return writer_rank;
+}
+
+/**
+ * Returns the task class of the batched flushes of a taskpool. It is
+ * created by the first batched flush, which happens at the same point on
+ * all the ranks, so its id is the same everywhere.
+ */
+static parsec_task_class_t *
+parsec_dtd_flush_batch_task_class(parsec_dtd_taskpool_t *dtd_tp, int batch_size)
+{
+    parsec_dtd_param_t params[MAX_PARAM_COUNT + 1];
+    parsec_task_class_t *tc;
+    int i;
+
+    if( NULL != dtd_tp->flush_batch_tc ) {
+        return dtd_tp->flush_batch_tc;
+    }
+    /* The rank of the task, then the tiles */
+    params[0].op = PARSEC_VALUE | PARSEC_AFFINITY;
+    params[0].size = sizeof(int);
+    params[0].profile_info = NULL;
+    for( i = 1; i <= batch_size; i++ ) {
+        params[i].op = PARSEC_INOUT;
+        params[i].size = PASSED_BY_REF;
+        params[i].profile_info = NULL;
+    }
+    tc = &parsec_dtd_create_task_classv("parsec_dtd_data_flush_batch", batch_size + 1, params)->super;
+    parsec_dtd_task_class_add_chore(&dtd_tp->super, tc, PARSEC_DEV_CPU, parsec_dtd_data_flush_batch_body);
+    dtd_tp->flush_batch_tc = tc;
+    return tc;
+}
+
+/**
+ * Inserts the tasks writing back the tiles of a batch to their owner: one
+ * on the last writer of the tiles, if it is not their owner, and one on
+ * their owner. The data of all the tiles travel with a single activation.
+ */
+static void
+parsec_dtd_flush_batch_insert(parsec_dtd_taskpool_t *dtd_tp, parsec_dtd_flush_batch_t *batch)
+{
+    parsec_task_class_t *tc = dtd_tp->flush_batch_tc;
+    parsec_dtd_graph_t *graph = dtd_tp->graph_recording;
+    void *args[MAX_PARAM_COUNT + 1];
+    parsec_task_t *tasks[2];
+    parsec_dtd_task_t *this_task;
+    int ranks[2], nb_tasks = 0, t, i;
+
+    if( batch->writer_rank != batch->owner_rank ) {
+        ranks[nb_tasks++] = batch->writer_rank;
+    }
+    ranks[nb_tasks++] = batch->owner_rank;
+
+    for( t = 0; t < nb_tasks; t++ ) {
+        args[0] = &ranks[t];
+        for( i = 0; i < tc->nb_flows; i++ ) {
+            args[i + 1] = (i < batch->nb_tiles) ? batch->tiles[i] : NULL;
+        }
+        tasks[t] = parsec_dtd_create_task_with_args(&dtd_tp->super, tc, 0, PARSEC_DEV_CPU, args);
+        this_task = (parsec_dtd_task_t *)tasks[t];
+        for( i = 0; i < batch->nb_tiles; i++ ) {
+            parsec_dtd_tile_t *tile = batch->tiles[i];
+            /* The data travel with the datatype they were last used with */
+            if( tile->arena_index >= 0 ) {
+                (FLOW_OF(this_task, i))->op_type = PARSEC_INOUT | tile->arena_index;
+            }
+            /* The tasks on pruned tiles are pruned in turn and never released */
+            if( !parsec_dtd_tile_is_pruned(dtd_tp, tile) ) {
+                parsec_dtd_tile_retain(tile);
+            }
+        }
+    }
+
+    /* As the other flush tasks, these tasks are not recorded in a graph */
+    dtd_tp->graph_recording = NULL;
+    parsec_insert_dtd_tasks(tasks, nb_tasks);
+    dtd_tp->graph_recording = graph;
+
+    /* The last task remains the last writer of the tiles, which are removed:
+     * a remote one is released as the insertion of the next writer would */
+    this_task = (parsec_dtd_task_t *)tasks[nb_tasks - 1];
+    if( parsec_dtd_task_is_remote(this_task) ) {
+        for( i = 0; i < batch->nb_tiles; i++ ) {
+            if( !parsec_dtd_tile_is_pruned(dtd_tp, batch->tiles[i]) ) {
+                parsec_dtd_remote_task_release(this_task);
+            }
+        }
+    }
+
+    for( i = 0; i < batch->nb_tiles; i++ ) {
+        parsec_dtd_tile_t *tile = batch->tiles[i];
+        tile->flushed = FLUSHED;
+        parsec_dtd_tile_remove( tile->dc, tile->key );
+        parsec_dtd_tile_release( tile );
+    }
+    batch->nb_tiles = 0;
+}
+
+/**
+ * Flushes all the tiles of a data collection, grouping the tiles with
+ * the same last writer and owner in batches of at most batch_size tiles.
+ * The tiles are visited in the same order on all the ranks, so the
+ * batches, and the ids of their tasks, are the same everywhere.
+ */
+static void
+parsec_dtd_data_flush_all_batched(parsec_taskpool_t *tp, parsec_data_collection_t *dc, int batch_size)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_flush_tiles_t tiles = { 0, 0, NULL };
+    parsec_dtd_flush_batch_t *batches = NULL;
+    int nb_batches = 0, t, b, writer_rank;
+
+    parsec_hash_table_for_all( (parsec_hash_table_t *)dc->tile_h_table,
+                               (parsec_hash_elem_fct_t)parsec_dtd_flush_collect_tile, &tiles);
+    batch_size = parsec_dtd_flush_batch_task_class(dtd_tp, batch_size)->nb_flows;
+
+    for( t = 0; t < tiles.nb_tiles; t++ ) {
+        parsec_dtd_tile_t *tile = tiles.tiles[t];
+        assert(tile->flushed == NOT_FLUSHED);
+
+        writer_rank = parsec_dtd_flush_writer_rank(dtd_tp, tile);
+        if( -1 == writer_rank ) {
+            /* Nothing to write back */
+            parsec_internal_dtd_data_flush(tile, tp);
+            continue;
+        }
+        for( b = 0; b < nb_batches; b++ ) {
+            if( batches[b].writer_rank == writer_rank && batches[b].owner_rank == tile->rank ) break;
+        }
+        if( b == nb_batches ) {
+            batches = (parsec_dtd_flush_batch_t *)realloc(batches, (nb_batches + 1) * sizeof(parsec_dtd_flush_batch_t));
+            batches[b].writer_rank = writer_rank;
+            batches[b].owner_rank = tile->rank;
+            batches[b].nb_tiles = 0;
+            nb_batches++;
+        }
+        /* The tile is kept until its batch is inserted */
+        parsec_dtd_tile_retain(tile);
+        batches[b].tiles[batches[b].nb_tiles++] = tile;
+        if( batches[b].nb_tiles == batch_size ) {
+            parsec_dtd_flush_batch_insert(dtd_tp, &batches[b]);
+        }
+    }
+    for( b = 0; b < nb_batches; b++ ) {
+        if( batches[b].nb_tiles > 0 ) {
+            parsec_dtd_flush_batch_insert(dtd_tp, &batches[b]);
+        }
+    }
+
+    free(batches);
+    free(tiles.tiles);
+}
+
 /**
  * This function will flush all the data DTD has seen so far
  * pertaining to the data collection passed. The same constraints
@@ -382,12 +645,20 @@ int
 parsec_dtd_data_flush_all(parsec_taskpool_t *tp, parsec_data_collection_t *dc)
 {
     parsec_hash_table_t *hash_table   = (parsec_hash_table_t *)dc->tile_h_table;
+    parsec_execution_stream_t app_es;
+    int borrowed = parsec_dtd_borrow_execution_stream((parsec_dtd_taskpool_t *)tp, &app_es);
     parsec_execution_stream_t *es = parsec_my_execution_stream();
 
     PARSEC_PINS(es, DATA_FLUSH_BEGIN, NULL);
 
-    parsec_hash_table_for_all( hash_table, (parsec_hash_elem_fct_t)parsec_internal_dtd_data_flush, tp);
+    if( parsec_dtd_flush_batch_size > 1 ) {
+        parsec_dtd_data_flush_all_batched(tp, dc, parsec_dtd_flush_batch_size < MAX_PARAM_COUNT ?
+                                                  parsec_dtd_flush_batch_size : MAX_PARAM_COUNT);
+    } else {
+        parsec_hash_table_for_all( hash_table, (parsec_hash_elem_fct_t)parsec_internal_dtd_data_flush, tp);
+    }
 
     PARSEC_PINS(es, DATA_FLUSH_END, NULL);
+    parsec_dtd_return_execution_stream(borrowed);
     return PARSEC_SUCCESS; /* TODO: internal_dtd_data_flush should care for error codepaths */
 }
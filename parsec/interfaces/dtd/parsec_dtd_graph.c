@@ -0,0 +1,682 @@
+/**
+ * Copyright (c) 2023      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+/* **************************************************************************** */
+/**
+ * @file parsec_dtd_graph.c
+ *
+ * Record and replay of the tasks inserted in a DTD taskpool. Iterative
+ * applications insert the same pattern of tasks at every iteration, the
+ * recording keeps the outcome of the argument parsing (task class, tiles,
+ * placement and packed values) of one iteration so that the following
+ * ones can create their tasks directly from it. The edges between the
+ * tasks of the graph are also recorded: on a single process, the replay
+ * links the tasks directly and only resolves the first access of the graph
+ * to each data against the tasks inserted before it. The edges hold no
+ * remote task nor communication, distributed replays track the dependencies
+ * of every task.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/runtime.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/scheduling.h"
+#include "parsec/remote_dep.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+/**
+ * @addtogroup DTD_INTERFACE_INTERNAL
+ */
+
+/* A recorded parameter. The pointer is the tile for the data flows and the
+ * user pointer for the PARSEC_REF and PARSEC_SCRATCH parameters (NULL when
+ * the runtime allocates the scratch space). PARSEC_VALUE parameters are
+ * stored in the value block of the graph. */
+typedef struct parsec_dtd_graph_param_s {
+    int32_t  op_type;
+    int32_t  arg_size;
+    void    *pointer;
+    size_t   value_offset;
+} parsec_dtd_graph_param_t;
+
+/* A recorded task, its parameters are stored contiguously in the graph.
+ * Remote tasks only record their data flows. */
+typedef struct parsec_dtd_graph_task_s {
+    parsec_task_class_t *tc;
+    int32_t              priority;
+    int32_t              rank;
+    uint32_t             chore_mask;
+    int32_t              write_flow_count;
+    int32_t              first_param;
+    int32_t              nb_params;
+} parsec_dtd_graph_task_t;
+
+/* An access of a task of the graph to a tracked data. The accesses to the
+ * same data are chained in the order of the recording, by the index of
+ * their parameter in the graph. */
+typedef struct parsec_dtd_graph_link_s {
+    int32_t task;         /* -1 if the parameter is not a tracked flow */
+    int32_t flow_index;
+    int32_t prev;         /* previous access to the data, -1 for the first one */
+    int32_t next;         /* next access to the data, -1 for the last one */
+    int32_t writer;       /* last writer of the data before this access, -1 if none */
+    int32_t tail;         /* on the first access: last access to the data */
+    int32_t tail_writer;  /* on the first access: last writer of the data, -1 if none */
+} parsec_dtd_graph_link_t;
+
+struct parsec_dtd_graph_s {
+    parsec_dtd_taskpool_t    *dtd_tp;
+    int                       nb_tasks;
+    int                       size_tasks;
+    parsec_dtd_graph_task_t  *tasks;
+    int                       nb_params;
+    int                       size_params;
+    parsec_dtd_graph_param_t *params;
+    size_t                    values_length;
+    size_t                    values_size;
+    char                     *values;
+    parsec_dtd_graph_link_t  *links;  /* NULL if the replay cannot rebuild the edges */
+};
+
+static inline int
+parsec_dtd_graph_is_flow(int op_type)
+{
+    return (op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ||
+           (op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+           (op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT ||
+           (op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE;
+}
+
+static parsec_dtd_graph_param_t *
+parsec_dtd_graph_add_param(parsec_dtd_graph_t *graph, int op_type, int arg_size, void *pointer)
+{
+    parsec_dtd_graph_param_t *param;
+
+    if( graph->nb_params == graph->size_params ) {
+        graph->size_params = (0 == graph->size_params) ? 256 : 2 * graph->size_params;
+        graph->params = (parsec_dtd_graph_param_t *)realloc(graph->params,
+                                                            graph->size_params * sizeof(parsec_dtd_graph_param_t));
+    }
+    param = &graph->params[graph->nb_params++];
+    param->op_type = op_type;
+    param->arg_size = arg_size;
+    param->pointer = pointer;
+    param->value_offset = 0;
+    if( parsec_dtd_graph_is_flow(op_type) && NULL != pointer ) {
+        parsec_dtd_tile_retain((parsec_dtd_tile_t *)pointer);
+    }
+    return param;
+}
+
+static void
+parsec_dtd_graph_add_value(parsec_dtd_graph_t *graph, parsec_dtd_graph_param_t *param, const void *value)
+{
+    if( graph->values_length + param->arg_size > graph->values_size ) {
+        do {
+            graph->values_size = (0 == graph->values_size) ? 1024 : 2 * graph->values_size;
+        } while( graph->values_length + param->arg_size > graph->values_size );
+        graph->values = (char *)realloc(graph->values, graph->values_size);
+    }
+    param->value_offset = graph->values_length;
+    memcpy(graph->values + graph->values_length, value, param->arg_size);
+    graph->values_length += param->arg_size;
+}
+
+/**
+ * Append a task, created but not yet inserted, to the graph being recorded.
+ */
+void
+parsec_dtd_graph_record_task(parsec_dtd_graph_t *graph, parsec_dtd_task_t *this_task)
+{
+    parsec_dtd_task_class_t *dtd_tc = (parsec_dtd_task_class_t *)this_task->super.task_class;
+    parsec_dtd_graph_task_t *task;
+    parsec_dtd_flow_info_t *flow;
+    parsec_dtd_graph_param_t *param;
+    int i, flow_index = 0;
+
+    if( graph->nb_tasks == graph->size_tasks ) {
+        graph->size_tasks = (0 == graph->size_tasks) ? 64 : 2 * graph->size_tasks;
+        graph->tasks = (parsec_dtd_graph_task_t *)realloc(graph->tasks,
+                                                          graph->size_tasks * sizeof(parsec_dtd_graph_task_t));
+    }
+    task = &graph->tasks[graph->nb_tasks++];
+    task->tc = &dtd_tc->super;
+    task->priority = this_task->super.priority;
+    task->rank = this_task->rank;
+    task->chore_mask = this_task->super.chore_mask;
+    task->write_flow_count = 1;
+    task->first_param = graph->nb_params;
+    (void)parsec_atomic_fetch_inc_int32(&dtd_tc->ref_count);
+
+    if( parsec_dtd_task_is_remote(this_task) ) {
+        /* Only the data flows of remote tasks are known */
+        for( i = 0; i < dtd_tc->super.nb_flows; i++ ) {
+            flow = FLOW_OF(this_task, i);
+            (void)parsec_dtd_graph_add_param(graph, flow->op_type, PASSED_BY_REF, flow->tile);
+        }
+        task->nb_params = graph->nb_params - task->first_param;
+        return;
+    }
+
+    parsec_dtd_task_param_t *current_param = GET_HEAD_OF_PARAM_LIST(this_task);
+    char *current_val = GET_VALUE_BLOCK(current_param, dtd_tc->count_of_params);
+    for( i = 0; i < dtd_tc->count_of_params; i++, current_param++ ) {
+        int op_type = (int)current_param->op_type;
+
+        if( parsec_dtd_graph_is_flow(op_type) ) {
+            flow = FLOW_OF(this_task, flow_index);
+            flow_index++;
+            (void)parsec_dtd_graph_add_param(graph, op_type, PASSED_BY_REF, flow->tile);
+            /* same accounting as the task creation */
+            if( NULL != flow->tile && !(op_type & PARSEC_DONT_TRACK) &&
+                (PARSEC_INOUT == (op_type & PARSEC_GET_OP_TYPE) ||
+                 PARSEC_OUTPUT == (op_type & PARSEC_GET_OP_TYPE)) ) {
+                task->write_flow_count++;
+            }
+            continue;
+        }
+        if( (op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
+            param = parsec_dtd_graph_add_param(graph, op_type, current_param->arg_size, NULL);
+            parsec_dtd_graph_add_value(graph, param, current_param->pointer_to_tile);
+        } else if( (op_type & PARSEC_GET_OP_TYPE) == PARSEC_SCRATCH &&
+                   current_param->pointer_to_tile == (void *)current_val ) {
+            /* scratch space allocated by the runtime in the task */
+            (void)parsec_dtd_graph_add_param(graph, op_type, current_param->arg_size, NULL);
+        } else {
+            (void)parsec_dtd_graph_add_param(graph, op_type, current_param->arg_size,
+                                             current_param->pointer_to_tile);
+        }
+        current_val += current_param->arg_size;
+    }
+    task->nb_params = graph->nb_params - task->first_param;
+}
+
+/**
+ * Returns the tile to use for a recorded flow. Flushed tiles are not known
+ * anymore by their data collection, they are looked up again.
+ */
+static inline parsec_dtd_tile_t *
+parsec_dtd_graph_tile_of(const parsec_dtd_graph_param_t *param)
+{
+    parsec_dtd_tile_t *tile = (parsec_dtd_tile_t *)param->pointer;
+
+    if( NULL != tile && FLUSHED == tile->flushed ) {
+        tile = parsec_dtd_tile_of(tile->dc, tile->key);
+    }
+    return tile;
+}
+
+int
+parsec_dtd_graph_record_begin(parsec_taskpool_t *tp)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+
+    if( PARSEC_TASKPOOL_TYPE_DTD != tp->taskpool_type ) {
+        parsec_fatal("Error! Taskpool is of incorrect type\n");
+    }
+    if( NULL != dtd_tp->graph_recording ) {
+        return PARSEC_ERR_EXISTS;
+    }
+    dtd_tp->graph_recording = (parsec_dtd_graph_t *)calloc(1, sizeof(parsec_dtd_graph_t));
+    dtd_tp->graph_recording->dtd_tp = dtd_tp;
+    return PARSEC_SUCCESS;
+}
+
+typedef struct parsec_dtd_graph_access_s {
+    parsec_data_collection_t *dc;
+    uint64_t                  key;
+    int32_t                   param;
+} parsec_dtd_graph_access_t;
+
+static int
+parsec_dtd_graph_access_compare(const void *a, const void *b)
+{
+    const parsec_dtd_graph_access_t *access_a = (const parsec_dtd_graph_access_t *)a;
+    const parsec_dtd_graph_access_t *access_b = (const parsec_dtd_graph_access_t *)b;
+
+    if( access_a->dc != access_b->dc )
+        return ((uintptr_t)access_a->dc < (uintptr_t)access_b->dc) ? -1 : 1;
+    if( access_a->key != access_b->key )
+        return (access_a->key < access_b->key) ? -1 : 1;
+    return access_a->param - access_b->param;
+}
+
+static inline int
+parsec_dtd_graph_is_write(int op_type)
+{
+    return (op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ||
+           (op_type & PARSEC_GET_OP_TYPE) == PARSEC_OUTPUT;
+}
+
+/**
+ * Chain the accesses of the graph to each data. The edges are not kept if
+ * the insertion can add tasks, or order the accesses, differently from the
+ * recording: for PARSEC_ATOMIC_WRITE flows, and for tasks using the same
+ * data in several flows.
+ */
+static void
+parsec_dtd_graph_link(parsec_dtd_graph_t *graph)
+{
+    parsec_dtd_graph_access_t *accesses;
+    parsec_dtd_graph_link_t *links;
+    int t, i, j, nb_accesses = 0;
+
+    if( 0 == graph->nb_params ) return;
+    links = (parsec_dtd_graph_link_t *)malloc(graph->nb_params * sizeof(parsec_dtd_graph_link_t));
+    accesses = (parsec_dtd_graph_access_t *)malloc(graph->nb_params * sizeof(parsec_dtd_graph_access_t));
+
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+        const parsec_dtd_graph_task_t *task = &graph->tasks[t];
+        int flow_index = 0;
+
+        for( i = task->first_param; i < task->first_param + task->nb_params; i++ ) {
+            const parsec_dtd_graph_param_t *param = &graph->params[i];
+            const parsec_dtd_tile_t *tile = (const parsec_dtd_tile_t *)param->pointer;
+
+            links[i].task = -1;
+            if( !parsec_dtd_graph_is_flow(param->op_type) ) continue;
+            flow_index++;
+            if( NULL == tile || (param->op_type & PARSEC_DONT_TRACK) ) continue;
+            if( (param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_ATOMIC_WRITE ) goto unlinked;
+            links[i].task = t;
+            links[i].flow_index = flow_index - 1;
+            accesses[nb_accesses].dc = tile->dc;
+            accesses[nb_accesses].key = tile->key;
+            accesses[nb_accesses].param = i;
+            nb_accesses++;
+        }
+    }
+
+    qsort(accesses, nb_accesses, sizeof(parsec_dtd_graph_access_t), parsec_dtd_graph_access_compare);
+    for( i = 0; i < nb_accesses; i = j ) {
+        int head = accesses[i].param, writer = -1;
+
+        for( j = i; j < nb_accesses && accesses[j].dc == accesses[i].dc &&
+                    accesses[j].key == accesses[i].key; j++ ) {
+            parsec_dtd_graph_link_t *link = &links[accesses[j].param];
+
+            if( j > i && links[accesses[j - 1].param].task == link->task ) goto unlinked;
+            link->prev = (j > i) ? accesses[j - 1].param : -1;
+            link->next = (j + 1 < nb_accesses && accesses[j + 1].dc == accesses[i].dc &&
+                          accesses[j + 1].key == accesses[i].key) ? accesses[j + 1].param : -1;
+            link->writer = writer;
+            if( parsec_dtd_graph_is_write(graph->params[accesses[j].param].op_type) ) {
+                writer = accesses[j].param;
+            }
+        }
+        links[head].tail = accesses[j - 1].param;
+        links[head].tail_writer = writer;
+    }
+    free(accesses);
+    graph->links = links;
+    return;
+
+  unlinked:
+    free(accesses);
+    free(links);
+}
+
+parsec_dtd_graph_t *
+parsec_dtd_graph_record_end(parsec_taskpool_t *tp)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_dtd_graph_t *graph = dtd_tp->graph_recording;
+
+    dtd_tp->graph_recording = NULL;
+    if( NULL != graph ) {
+        parsec_dtd_graph_link(graph);
+    }
+    return graph;
+}
+
+/**
+ * Create the task t of the graph, with the recorded parameters and the
+ * values of the update callback.
+ */
+static parsec_dtd_task_t *
+parsec_dtd_graph_create_task(parsec_dtd_taskpool_t *dtd_tp, const parsec_dtd_graph_t *graph, int t,
+                             parsec_dtd_graph_update_t *update, void *cb_data)
+{
+    const parsec_dtd_graph_task_t *task = &graph->tasks[t];
+    const parsec_dtd_graph_param_t *param = &graph->params[task->first_param];
+    void *values[PARSEC_DTD_MAX_PARAMS];
+    int i, flow_index = 0;
+
+    parsec_dtd_task_t *this_task = parsec_dtd_create_and_initialize_task(dtd_tp, task->tc, task->rank);
+    this_task->super.priority = task->priority;
+    this_task->super.chore_mask = task->chore_mask;
+
+    if( parsec_dtd_task_is_remote(this_task) ) {
+        for( i = 0; i < task->nb_params; i++, param++ ) {
+            parsec_dtd_set_params_of_task(this_task, parsec_dtd_graph_tile_of(param), param->op_type,
+                                          &flow_index, NULL, NULL, PASSED_BY_REF);
+        }
+        return this_task;
+    }
+
+    /* retaining the local task as many write flows as
+     * it has and one to indicate when we have executed the task */
+    (void)parsec_atomic_fetch_add_int32(&this_task->super.super.super.obj_reference_count,
+                                        task->write_flow_count);
+
+    parsec_dtd_task_param_t *current_param = GET_HEAD_OF_PARAM_LIST(this_task);
+    void *current_val = GET_VALUE_BLOCK(current_param, task->nb_params);
+    for( i = 0; i < task->nb_params; i++, param++, current_param++ ) {
+        void *tile;
+        if( parsec_dtd_graph_is_flow(param->op_type) ) {
+            tile = parsec_dtd_graph_tile_of(param);
+        } else if( (param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE ) {
+            tile = graph->values + param->value_offset;
+        } else {
+            tile = param->pointer;
+        }
+        parsec_dtd_set_params_of_task(this_task, tile, param->op_type,
+                                      &flow_index, &current_val,
+                                      current_param, param->arg_size);
+        current_param->arg_size = param->arg_size;
+        current_param->op_type = (parsec_dtd_op_t)param->op_type;
+        values[i] = ((param->op_type & PARSEC_GET_OP_TYPE) == PARSEC_VALUE) ? current_param->pointer_to_tile : NULL;
+    }
+
+    if( NULL != update ) {
+        update(t, task->nb_params, values, cb_data);
+    }
+    return this_task;
+}
+
+/**
+ * Resolve the first access of the graph to a data against the tasks
+ * inserted before the graph, following the rules of the insertion, and
+ * make the last accesses of the graph the last user and last writer of the
+ * data. Returns the number of flows of the task satisfied by the data
+ * itself.
+ */
+static int
+parsec_dtd_graph_link_head(parsec_dtd_taskpool_t *dtd_tp, const parsec_dtd_graph_t *graph,
+                           parsec_dtd_task_t **tasks, int head, parsec_task_t **ready_ring)
+{
+    const parsec_dtd_graph_link_t *links = graph->links, *tail;
+    parsec_dtd_task_t *this_task = tasks[links[head].task];
+    int flow_index = links[head].flow_index, j;
+    parsec_dtd_tile_t *tile = FLOW_OF(this_task, flow_index)->tile;
+    int tile_op_type = FLOW_OF(this_task, flow_index)->op_type;
+    parsec_dtd_tile_user_t last_user, last_writer;
+
+    parsec_dtd_last_user_lock(&(tile->last_user));
+
+    READ_FROM_TILE(last_user, tile->last_user);
+    READ_FROM_TILE(last_writer, tile->last_writer);
+
+    if( NULL == last_user.task && (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INPUT ) {
+        parsec_dtd_last_user_unlock(&(tile->last_user));
+
+        parsec_dtd_insert_fake_first_out(dtd_tp, tile, tile_op_type, ready_ring);
+
+        parsec_dtd_last_user_lock(&(tile->last_user));
+
+        READ_FROM_TILE(last_user, tile->last_user);
+        READ_FROM_TILE(last_writer, tile->last_writer);
+    }
+
+    /* The accesses up to the first writer of the graph depend on the last
+     * writer before the graph */
+    if( NULL != last_user.task ) {
+        for( j = head; -1 != j && -1 == links[j].writer; j = links[j].next ) {
+            parsec_dtd_task_t *task = tasks[links[j].task];
+            parsec_dtd_set_parent(last_writer.task, last_writer.flow_index,
+                                  task, links[j].flow_index, last_writer.op_type,
+                                  FLOW_OF(task, links[j].flow_index)->op_type);
+        }
+    }
+
+    tail = &links[links[head].tail];
+    tile->last_user.task = tasks[tail->task];
+    tile->last_user.flow_index = tail->flow_index;
+    tile->last_user.op_type = FLOW_OF(tasks[tail->task], tail->flow_index)->op_type;
+    tile->last_user.alive = TASK_IS_ALIVE;
+    if( -1 != links[head].tail_writer ) {
+        const parsec_dtd_graph_link_t *writer = &links[links[head].tail_writer];
+        tile->last_writer.task = tasks[writer->task];
+        tile->last_writer.flow_index = writer->flow_index;
+        tile->last_writer.op_type = FLOW_OF(tasks[writer->task], writer->flow_index)->op_type;
+        tile->last_writer.alive = TASK_IS_ALIVE;
+    }
+    tile->last_op_type = tile->last_user.op_type & PARSEC_GET_OP_TYPE;
+
+    parsec_dtd_last_user_unlock(&(tile->last_user));
+
+    if( TASK_IS_ALIVE == last_user.alive ) {
+        set_dependencies_for_function((parsec_taskpool_t *)dtd_tp,
+                                      (parsec_task_class_t *)last_writer.task->super.task_class,
+                                      (parsec_task_class_t *)this_task->super.task_class,
+                                      last_writer.flow_index, flow_index);
+        parsec_dtd_set_descendant(last_user.task, last_user.flow_index,
+                                  this_task, flow_index, last_user.op_type,
+                                  tile_op_type, last_user.alive);
+        return 0;
+    }
+    if( NULL != last_user.task ) {
+        /* The last writer completed, it activates the head of the graph */
+        set_dependencies_for_function((parsec_taskpool_t *)dtd_tp,
+                                      (parsec_task_class_t *)last_writer.task->super.task_class,
+                                      (parsec_task_class_t *)this_task->super.task_class,
+                                      last_writer.flow_index, flow_index);
+        parsec_dtd_set_descendant(last_writer.task, last_writer.flow_index,
+                                  this_task, flow_index, last_writer.op_type,
+                                  tile_op_type, last_user.alive);
+        this_task->super.task_class->release_deps(parsec_my_execution_stream(),
+                                                  (parsec_task_t *)last_writer.task,
+                                                  (1 << last_writer.flow_index) |
+                                                  PARSEC_ACTION_SEND_REMOTE_DEPS |
+                                                  PARSEC_ACTION_SEND_INIT_REMOTE_DEPS |
+                                                  PARSEC_ACTION_RELEASE_REMOTE_DEPS |
+                                                  PARSEC_ACTION_COMPLETE_LOCAL_TASK |
+                                                  PARSEC_ACTION_RELEASE_LOCAL_DEPS, NULL);
+        return 0;
+    }
+    if( (tile_op_type & PARSEC_GET_OP_TYPE) == PARSEC_INOUT ) {
+        set_dependencies_for_function((parsec_taskpool_t *)dtd_tp, NULL,
+                                      (parsec_task_class_t *)this_task->super.task_class,
+                                      0, flow_index);
+    }
+    this_task->super.data[flow_index].data_in = tile->data_copy;
+    if( tile->data_copy != NULL) {
+        /* We are using this local data for the first time, let's retain it */
+        parsec_dtd_retain_data_copy(tile->data_copy);
+    }
+    return 1;
+}
+
+/**
+ * Replay the graph by linking its tasks with the recorded edges. Only the
+ * first access to each data goes through the last user of the data, the
+ * tasks are scheduled once all of them are linked.
+ */
+static void
+parsec_dtd_graph_replay_edges(parsec_dtd_taskpool_t *dtd_tp, const parsec_dtd_graph_t *graph,
+                              parsec_dtd_graph_update_t *update, void *cb_data)
+{
+    const parsec_dtd_graph_link_t *links = graph->links;
+    parsec_dtd_task_t **tasks;
+    parsec_task_t *ready_ring = NULL;
+    int32_t *satisfied_flow;
+    int32_t nb_inserted;
+    int t, i, flow_index, vpid = 0;
+
+    tasks = (parsec_dtd_task_t **)malloc(graph->nb_tasks * sizeof(parsec_dtd_task_t *));
+    satisfied_flow = (int32_t *)calloc(graph->nb_tasks, sizeof(int32_t));
+
+    /* Create the tasks and link the accesses inside the graph. The tasks
+     * cannot be activated before they are all linked, they hold the extra
+     * flow counted at their creation. The recording already set the
+     * dependencies between the task classes of the graph. */
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+        const parsec_dtd_graph_task_t *task = &graph->tasks[t];
+        parsec_dtd_task_t *this_task;
+
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+        tasks[t] = this_task = parsec_dtd_graph_create_task(dtd_tp, graph, t, update, cb_data);
+        if( 0 == dtd_tp->flow_set_flag[task->tc->task_class_id] ) {
+            parsec_dtd_set_flows_of_task_class(dtd_tp, this_task);
+        }
+
+        for( flow_index = 0; flow_index < task->tc->nb_flows; flow_index++ ) {
+            parsec_dtd_flow_info_t *flow = FLOW_OF(this_task, flow_index);
+            if( NULL == flow->tile ) {
+                satisfied_flow[t]++;
+            } else if( flow->op_type & PARSEC_DONT_TRACK ) {
+                this_task->super.data[flow_index].data_in = flow->tile->data_copy;
+                satisfied_flow[t]++;
+            }
+        }
+
+        for( i = task->first_param; i < task->first_param + task->nb_params; i++ ) {
+            const parsec_dtd_graph_link_t *link = &links[i];
+            parsec_dtd_flow_info_t *flow;
+            if( -1 == link->task ) continue;
+
+            flow = FLOW_OF(this_task, link->flow_index);
+            if( flow->tile->arena_index == -1 ) {
+                flow->tile->arena_index = (flow->op_type & PARSEC_GET_REGION_INFO);
+            }
+            flow->arena_index = (flow->op_type & PARSEC_GET_REGION_INFO);
+#if defined(PARSEC_PROF_TRACE)
+            if( parsec_dtd_graph_is_write(flow->op_type) ) {
+                this_task->super.prof_info.desc = NULL;
+                this_task->super.prof_info.priority = this_task->super.priority;
+                this_task->super.prof_info.data_id = flow->tile->key;
+                this_task->super.prof_info.task_class_id = task->tc->task_class_id;
+            }
+#endif
+            if( -1 != link->writer ) {
+                const parsec_dtd_graph_link_t *writer = &links[link->writer];
+                parsec_dtd_set_parent(tasks[writer->task], writer->flow_index,
+                                      this_task, link->flow_index,
+                                      FLOW_OF(tasks[writer->task], writer->flow_index)->op_type,
+                                      flow->op_type);
+            }
+            if( -1 != link->prev ) {
+                const parsec_dtd_graph_link_t *prev = &links[link->prev];
+                parsec_dtd_descendant_info_t *desc = DESC_OF(tasks[prev->task], prev->flow_index);
+                desc->flow_index = link->flow_index;
+                desc->op_type = flow->op_type;
+                desc->task = this_task;
+            }
+        }
+
+        if( dtd_tp->window_adaptive ) {
+            parsec_dtd_window_task_inserted(dtd_tp, this_task);
+        }
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyout, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+    }
+
+    /* Link the graph to the tasks inserted before it, as a single task
+     * linking all the tiles of the graph */
+    parsec_dtd_link_alone_begin(dtd_tp, parsec_my_execution_stream());
+    for( i = 0; i < graph->nb_params; i++ ) {
+        if( -1 == links[i].task || -1 != links[i].prev ) continue;
+        satisfied_flow[links[i].task] += parsec_dtd_graph_link_head(dtd_tp, graph, tasks, i, &ready_ring);
+    }
+    parsec_dtd_link_alone_end(dtd_tp);
+
+    dtd_tp->super.tdm.module->taskpool_addto_nb_tasks(&dtd_tp->super, graph->nb_tasks);
+    nb_inserted = parsec_atomic_fetch_add_int32(&dtd_tp->local_task_inserted, graph->nb_tasks);
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+        parsec_dtd_schedule_task_if_ready(satisfied_flow[t] + 1, tasks[t],
+                                          dtd_tp, &vpid, &ready_ring);
+    }
+    free(satisfied_flow);
+    free(tasks);
+
+    if( NULL != ready_ring ) {
+        parsec_dtd_schedule(parsec_my_execution_stream(), ready_ring);
+    }
+    parsec_dtd_block_if_threshold_reached(dtd_tp, nb_inserted, graph->nb_tasks, parsec_dtd_threshold_size);
+}
+
+int
+parsec_dtd_graph_replay(parsec_taskpool_t *tp, const parsec_dtd_graph_t *graph,
+                        parsec_dtd_graph_update_t *update, void *cb_data)
+{
+    parsec_dtd_taskpool_t *dtd_tp = (parsec_dtd_taskpool_t *)tp;
+    parsec_execution_stream_t app_es;
+    int t, borrowed;
+
+    if( graph->dtd_tp != dtd_tp ) {
+        parsec_warning("A DTD graph can only be replayed in the taskpool it was recorded in\n");
+        return PARSEC_ERR_BAD_PARAM;
+    }
+    if( tp->context == NULL ) {
+        parsec_fatal("Sorry! You can not insert task without enqueuing the taskpool to parsec_context"
+                     " first. Please make sure you call parsec_context_add_taskpool(parsec_context, taskpool) before"
+                     " you try inserting task in PaRSEC\n");
+    }
+
+    borrowed = parsec_dtd_borrow_execution_stream(dtd_tp, &app_es);
+
+    /* The edges only hold if all the tasks are local and tracked */
+    if( NULL != graph->links && 1 == tp->context->nb_nodes && NULL == dtd_tp->tracked_ranks ) {
+        parsec_dtd_graph_replay_edges(dtd_tp, graph, update, cb_data);
+        parsec_dtd_return_execution_stream(borrowed);
+        return PARSEC_SUCCESS;
+    }
+
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+#if defined(PARSEC_PROF_TRACE)
+        if( parsec_dtd_profile_verbose )
+            parsec_profiling_ts_trace_flags_info_fn(insert_task_trace_keyin, 0, dtd_tp->super.taskpool_id, NULL, NULL, 0);
+#endif
+        parsec_insert_dtd_task(&parsec_dtd_graph_create_task(dtd_tp, graph, t, update, cb_data)->super);
+    }
+    parsec_dtd_return_execution_stream(borrowed);
+    return PARSEC_SUCCESS;
+}
+
+int
+parsec_dtd_graph_nb_tasks(const parsec_dtd_graph_t *graph)
+{
+    return graph->nb_tasks;
+}
+
+void
+parsec_dtd_graph_free(parsec_dtd_graph_t *graph)
+{
+    int t, i;
+
+    if( NULL == graph ) return;
+    for( t = 0; t < graph->nb_tasks; t++ ) {
+        parsec_dtd_graph_task_t *task = &graph->tasks[t];
+        for( i = task->first_param; i < task->first_param + task->nb_params; i++ ) {
+            parsec_dtd_tile_t *tile = (parsec_dtd_tile_t *)graph->params[i].pointer;
+            if( !parsec_dtd_graph_is_flow(graph->params[i].op_type) || NULL == tile ) {
+                continue;
+            }
+            if( FLUSHED == tile->flushed ) {
+                parsec_dtd_tile_release(tile);
+            } else {
+                /* the tile is still owned by its data collection until it is flushed */
+                (void)parsec_atomic_fetch_dec_int32(&tile->super.super.obj_reference_count);
+            }
+        }
+        parsec_dtd_task_class_release(&graph->dtd_tp->super, task->tc);
+    }
+    free(graph->tasks);
+    free(graph->params);
+    free(graph->values);
+    free(graph->links);
+    free(graph);
+}
@@ -108,6 +108,10 @@ typedef struct jdf_compiler_global_args {
     int   noline;  /**< Don't dump the jdf line number in the generate .c file */
     struct jdf_name_list *ignore_properties; /**< Properties to ignore */
     int   termdet; /**< What termination detection to use (one of TERMDET_*) */
+    int   direct_calls; /**< Dispatch the steps of the tasks and update the dependencies through direct calls */
+    int   estimate; /**< Generate the static estimation of the taskpool */
+    char *profile;  /**< Profile of a previous run guiding the generated code */
+    int   lazy_dep_pages; /**< Allocate the index-array dependency pages lazily */
 } jdf_compiler_global_args_t;
 extern jdf_compiler_global_args_t JDF_COMPILER_GLOBAL_ARGS;
 
@@ -181,6 +185,9 @@ typedef unsigned int jdf_flags_t;
 #define JDF_FUNCTION_FLAG_HAS_DATA_INPUT    ((jdf_flags_t)(1 << 4))
 #define JDF_FUNCTION_FLAG_HAS_DATA_OUTPUT   ((jdf_flags_t)(1 << 5))
 #define JDF_FUNCTION_FLAG_NO_PREDECESSORS   ((jdf_flags_t)(1 << 6))
+#define JDF_FUNCTION_FLAG_COARSENED         ((jdf_flags_t)(1 << 7))
+#define JDF_FUNCTION_FLAG_SINGLE_INPUT      ((jdf_flags_t)(1 << 8))
+#define JDF_FUNCTION_FLAG_COLD              ((jdf_flags_t)(1 << 9))
 
 #define JDF_HAS_UD_NB_LOCAL_TASKS              ((jdf_flags_t)(1 << 0))
 #define JDF_PROP_UD_NB_LOCAL_TASKS_FN_NAME     "nb_local_tasks_fn"
@@ -229,6 +236,7 @@ typedef struct jdf_function_entry {
     struct jdf_def_list       *properties;
     struct jdf_body           *bodies;
     struct jdf_expr           *inline_c_functions;
+    double                     profile_duration; /**< Mean duration of the tasks in the profile, 0 if unknown */
 } jdf_function_entry_t;
 
 typedef struct jdf_data_entry {
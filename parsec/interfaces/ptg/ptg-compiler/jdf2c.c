@@ -52,6 +52,12 @@ jdf_generate_code_find_deps(const jdf_t *jdf,
                             const jdf_function_entry_t *f,
                             const char *name);
 static void jdf_generate_inline_c_functions(jdf_t* jdf);
+static int jdf_startup_is_sliceable(const jdf_function_entry_t *f);
+static int jdf_function_has_lazy_dep_pages(const jdf_function_entry_t *f);
+static int jdf_param_bound_is_hoisted(const jdf_function_entry_t *f, const jdf_variable_list_t *vl,
+                                      const jdf_expr_t *bound);
+static char *jdf_dump_param_bound(const jdf_function_entry_t *f, const jdf_variable_list_t *vl,
+                                  const jdf_expr_t *bound, expr_info_t *info);
 
 /* local constants */
 
@@ -66,6 +72,8 @@ static char* strdup_upper(const char *str);
 static char* strdup_lower(const char *str);
 
 #define TASKPOOL_GLOBAL_PREFIX  "__parsec_tp->super."
+/* The index of the slice enumerated by a startup task, in its last reserved local */
+#define STARTUP_TASK_SLICE      "((parsec_task_t*)this_task)->locals[MAX_LOCAL_COUNT-1].value"
 
 /* A coutput and houtput functions to write in the .h and .c files, counting the number of lines */
 
@@ -1424,8 +1432,8 @@ static void jdf_generate_header_file(const jdf_t* jdf)
             jdf_basename, jdf_basename);
     houtput("#include \"parsec.h\"\n"
             "#include \"parsec/parsec_internal.h\"\n"
-            "#include \"parsec/remote_dep.h\"\n\n"
-            );
+            "#include \"parsec/remote_dep.h\"\n%s\n",
+            JDF_COMPILER_GLOBAL_ARGS.estimate ? "#include \"parsec/parsec_estimate.h\"\n" : "");
     houtput("BEGIN_C_DECLS\n\n");
 
     for( g = jdf->datatypes; NULL != g; g = g->next ) {
@@ -1470,6 +1478,14 @@ static void jdf_generate_header_file(const jdf_t* jdf)
                 UTIL_DUMP_LIST( sa2, jdf->globals, next, dump_typed_globals, &prop,
                                 "", "", ", ", ""));
     }
+    if( JDF_COMPILER_GLOBAL_ARGS.estimate ) {
+        houtput("/** Estimate the tasks, the communications and the critical path of the taskpool on\n"
+                " *  nb_ranks processes, without executing it (see parsec_estimate_taskpool). The cost\n"
+                " *  of the tasks on the critical path is their simcost, or 1 without simcost.\n"
+                " */\n"
+                "extern int parsec_%s_estimate(parsec_%s_taskpool_t *tp, int nb_ranks, parsec_estimate_t *estimate);\n\n",
+                jdf_basename, jdf_basename);
+    }
 
     houtput("%s", UTIL_DUMP_LIST(sa1, jdf->functions, next, jdf_generate_task_typedef, sa3,
                                  "", "", "\n", "\n"));
@@ -1549,6 +1565,15 @@ static void jdf_minimal_code_before_prologue(const jdf_t *jdf)
             jdf_basename, nbdata,
             jdf_basename, jdf_basename,
             jdf_basename);
+    if( NULL != JDF_COMPILER_GLOBAL_ARGS.profile ) {
+        coutput("#if defined(PARSEC_HAVE_BUILTIN_EXPECT)\n"
+                "#define "JDF2C_NAMESPACE"likely(x)   __builtin_expect(!!(x), 1)\n"
+                "#define "JDF2C_NAMESPACE"unlikely(x) __builtin_expect(!!(x), 0)\n"
+                "#else\n"
+                "#define "JDF2C_NAMESPACE"likely(x)   (x)\n"
+                "#define "JDF2C_NAMESPACE"unlikely(x) (x)\n"
+                "#endif  /* defined(PARSEC_HAVE_BUILTIN_EXPECT) */\n\n");
+    }
     jdf_generate_predeclarations(jdf);
 }
 
@@ -1558,6 +1583,7 @@ static void jdf_generate_structure(jdf_t *jdf)
     string_arena_t *sa1, *sa2;
     jdf_function_entry_t* f;
     jdf_param_list_t *pl;
+    jdf_variable_list_t *vl;
 
     JDF_COUNT_LIST_ENTRIES(jdf->functions, jdf_function_entry_t, next, nbfunctions);
 
@@ -1569,9 +1595,24 @@ static void jdf_generate_structure(jdf_t *jdf)
             " parsec_%s_taskpool_t super;\n"
             " volatile int32_t sync_point;\n"
             " volatile int32_t initial_number_tasks;\n"
-            " parsec_task_t* startup_queue;\n",
+            " parsec_task_t* startup_queue;\n"
+            " int32_t startup_slices;    /* number of startup tasks of the sliceable task classes */\n"
+            " int32_t nb_startup_tasks;\n"
+            " parsec_atomic_lock_t startup_lock;\n",
             jdf_basename, jdf_basename, jdf_basename);
+    if( nbfunctions != 0 ) {
+        coutput("  /* The slices of the startup tasks enumerated, and their local tasks */\n"
+                "  int32_t startup_slices_done[%d];\n"
+                "  int32_t startup_nb_tasks[%d];\n",
+                nbfunctions, nbfunctions);
+    }
 
+    for(f = jdf->functions; f != NULL; f = f->next) {
+        if( jdf_function_has_lazy_dep_pages(f) ) {
+            coutput("  int32_t *%s_page_nb_tasks;  /* local tasks left in each page of the dependencies */\n",
+                    f->fname);
+        }
+    }
     coutput("  /* The ranges to compute the hash key */\n");
     for(f = jdf->functions; f != NULL; f = f->next) {
         if( 0 == (f->user_defines & JDF_FUNCTION_HAS_UD_MAKE_KEY) ) {
@@ -1584,6 +1625,16 @@ static void jdf_generate_structure(jdf_t *jdf)
                     f->fname);
         }
     }
+    coutput("  /* The bounds of the parameters computed once from the globals */\n");
+    for(f = jdf->functions; f != NULL; f = f->next) {
+        for(vl = f->locals; vl != NULL; vl = vl->next) {
+            if( JDF_RANGE != vl->expr->op ) continue;
+            if( jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta1) )
+                coutput("  int %s_%s_lb;\n", f->fname, vl->name);
+            if( jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta2) )
+                coutput("  int %s_%s_ub;\n", f->fname, vl->name);
+        }
+    }
 
     coutput("  /* The list of data repositories ");
     for(f = jdf->functions; NULL != f; f = f->next) {
@@ -1620,7 +1671,13 @@ static void jdf_generate_structure(jdf_t *jdf)
     }
 
     coutput("static inline int parsec_imin(int a, int b) { return (a <= b) ? a : b; };\n\n"
-            "static inline int parsec_imax(int a, int b) { return (a >= b) ? a : b; };\n\n");
+            "static inline int parsec_imax(int a, int b) { return (a >= b) ? a : b; };\n\n"
+            "static inline int parsec_range_nb_values(int start, int end, int inc)\n"
+            "{\n"
+            "  if( inc > 0 ) return (start <= end) ? (end - start) / inc + 1 : 0;\n"
+            "  if( inc < 0 ) return (start >= end) ? (start - end) / -inc + 1 : 0;\n"
+            "  return 0;\n"
+            "};\n\n");
 
     /**
      * Generate the inline_c functions as soon as possible, or they will not be usable
@@ -3085,11 +3142,22 @@ static void jdf_generate_startup_tasks(const jdf_t *jdf, const jdf_function_entr
 
     idx = 0;
     for(vl = f->locals; vl != NULL; vl = vl->next, idx++) {
-        if(vl->expr->op == JDF_RANGE) {
+        if(vl->expr->op == JDF_RANGE && vl == f->locals && jdf_startup_is_sliceable(f)) {
+            /* Each startup task enumerates its slice of the values of the outermost local */
+            coutput("%s  for(this_task->locals.%s.value = %s = %s",
+                    indent(nesting), vl->name, vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta1, &info1));
+            coutput(" + "STARTUP_TASK_SLICE" * (%s);\n",
+                    dump_expr((void**)vl->expr->jdf_ta3, &info1));
+            coutput("%s      this_task->locals.%s.value <= %s;\n",
+                    indent(nesting), vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta2, &info1));
+            coutput("%s      this_task->locals.%s.value += (%s) * __parsec_tp->startup_slices, %s = this_task->locals.%s.value) {\n",
+                    indent(nesting), vl->name, dump_expr((void**)vl->expr->jdf_ta3, &info1), vl->name, vl->name);
+            nesting++;
+        } else if(vl->expr->op == JDF_RANGE) {
             coutput("%s  for(this_task->locals.%s.value = %s = %s;\n",
-                    indent(nesting), vl->name, vl->name, dump_expr((void**)vl->expr->jdf_ta1, &info1));
+                    indent(nesting), vl->name, vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta1, &info1));
             coutput("%s      this_task->locals.%s.value <= %s;\n",
-                    indent(nesting), vl->name, dump_expr((void**)vl->expr->jdf_ta2, &info1));
+                    indent(nesting), vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta2, &info1));
             coutput("%s      this_task->locals.%s.value += %s, %s = this_task->locals.%s.value) {\n",
                     indent(nesting), vl->name, dump_expr((void**)vl->expr->jdf_ta3, &info1), vl->name, vl->name);
             nesting++;
@@ -3429,14 +3497,203 @@ static  void jdf_generate_deps_key_functions(const jdf_t *jdf, const jdf_functio
             "\n", sname, sname);
 }
 
+/**
+ * Returns 0 if the expression does not use the named local, 1 if it does
+ * or might do (inline C code, local definitions).
+ */
+static int jdf_expr_may_use_local(const char *name, const jdf_expr_t *e)
+{
+    if( NULL == e || NULL != e->local_variables || JDF_RANGE == e->op )
+        return 1;
+    if( JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) )
+        return 0;
+    if( JDF_OP_IS_VAR(e->op) )
+        return 0 == strcmp(e->jdf_var, name);
+    if( JDF_OP_IS_UNARY(e->op) )
+        return jdf_expr_may_use_local(name, e->jdf_ua);
+    if( JDF_OP_IS_TERNARY(e->op) )
+        return jdf_expr_may_use_local(name, e->jdf_tat) ||
+            jdf_expr_may_use_local(name, e->jdf_ta1) ||
+            jdf_expr_may_use_local(name, e->jdf_ta2);
+    if( JDF_OP_IS_BINARY(e->op) )
+        return jdf_expr_may_use_local(name, e->jdf_ba1) ||
+            jdf_expr_may_use_local(name, e->jdf_ba2);
+    return 1;
+}
+
+/**
+ * Returns 1 if the variable (possibly a member access like descA->mt) is
+ * one of the globals of the JDF.
+ */
+static int jdf_var_is_global(const char *varname)
+{
+    const jdf_global_entry_t *g;
+    size_t len = strcspn(varname, ".-");
+
+    for( g = current_jdf.globals; NULL != g; g = g->next )
+        if( (strlen(g->name) == len) && (0 == strncmp(g->name, varname, len)) )
+            return 1;
+    return 0;
+}
+
+/**
+ * Returns 1 if the value of the expression depends only on the globals, and
+ * not on the locals of the task. Inline C code is only accepted when the
+ * caller knows that no local is set when it is evaluated.
+ */
+static int jdf_expr_is_global_only(const jdf_expr_t *e, int accept_c_code)
+{
+    if( NULL == e || NULL != e->local_variables || JDF_RANGE == e->op )
+        return 0;
+    if( JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) )
+        return 1;
+    if( JDF_OP_IS_VAR(e->op) )
+        return jdf_var_is_global(e->jdf_var);
+    if( JDF_OP_IS_C_CODE(e->op) )
+        return accept_c_code && (NULL == e->protected_by);
+    if( JDF_OP_IS_UNARY(e->op) )
+        return jdf_expr_is_global_only(e->jdf_ua, accept_c_code);
+    if( JDF_OP_IS_TERNARY(e->op) )
+        return jdf_expr_is_global_only(e->jdf_tat, accept_c_code) &&
+            jdf_expr_is_global_only(e->jdf_ta1, accept_c_code) &&
+            jdf_expr_is_global_only(e->jdf_ta2, accept_c_code);
+    return jdf_expr_is_global_only(e->jdf_ba1, accept_c_code) &&
+        jdf_expr_is_global_only(e->jdf_ba2, accept_c_code);
+}
+
+/**
+ * Returns 1 if a bound of the range of a parameter is worth precomputing
+ * once in the taskpool, instead of being evaluated for each successor or
+ * predecessor: it depends only on the globals, and is more than a constant
+ * or a global. The bounds of the outermost local can be computed by inline
+ * C code, as no other local can be used to define them.
+ */
+static int jdf_param_bound_is_hoisted(const jdf_function_entry_t *f,
+                                      const jdf_variable_list_t *vl,
+                                      const jdf_expr_t *bound)
+{
+    if( JDF_RANGE != vl->expr->op || NULL != vl->expr->local_variables )
+        return 0;
+    if( JDF_OP_IS_CST(bound->op) || JDF_OP_IS_VAR(bound->op) )
+        return 0;
+    return jdf_expr_is_global_only(bound, vl == f->locals);
+}
+
+/**
+ * Dumps a bound of the range of a local, or its precomputed value.
+ */
+static char *jdf_dump_param_bound(const jdf_function_entry_t *f, const jdf_variable_list_t *vl,
+                                  const jdf_expr_t *bound, expr_info_t *info)
+{
+    if( !jdf_param_bound_is_hoisted(f, vl, bound) )
+        return dump_expr((void**)bound, info);
+    string_arena_init(info->sa);
+    string_arena_add_string(info->sa, "__parsec_tp->%s_%s_%s", f->fname, vl->name,
+                            (bound == vl->expr->jdf_ta1) ? "lb" : "ub");
+    return string_arena_get_string(info->sa);
+}
+
+/**
+ * Returns the first of the innermost locals of a task class that can be
+ * counted instead of enumerated by the internal_init: ranges without local
+ * definitions, whose values do not change the rank of the tasks, and which
+ * do not change the ranges of the locals after them. For each value of
+ * the other locals, the local tasks are then the product of the number of
+ * values of these ranges, or none. NULL if there is no such local.
+ */
+static const jdf_variable_list_t *jdf_first_counted_local(const jdf_function_entry_t *f)
+{
+    const jdf_variable_list_t *vl, *next_vl, *counted = NULL;
+    const jdf_expr_t *param;
+
+    if( NULL == f->predicate ) return NULL;
+    while( counted != f->locals ) {
+        /* The local right before the counted ones */
+        for( vl = f->locals; vl->next != counted; vl = vl->next ) /* nothing */;
+        if( JDF_RANGE != vl->expr->op || NULL != vl->expr->local_variables )
+            return counted;
+        for( param = f->predicate->parameters; NULL != param; param = param->next )
+            if( jdf_expr_may_use_local(vl->name, param) )
+                return counted;
+        for( next_vl = counted; NULL != next_vl; next_vl = next_vl->next )
+            if( jdf_expr_may_use_local(vl->name, next_vl->expr->jdf_ta1) ||
+                jdf_expr_may_use_local(vl->name, next_vl->expr->jdf_ta2) ||
+                jdf_expr_may_use_local(vl->name, next_vl->expr->jdf_ta3) )
+                return counted;
+        counted = vl;
+    }
+    return counted;
+}
+
+/**
+ * Returns 1 if the startup of a task class can be split in slices, each
+ * enumerating a cyclic subset of the values of the outermost local: this
+ * local must be a plain range iterated by the internal_init, and a reserved
+ * local must be left to store the index of the slice.
+ */
+static int jdf_startup_is_sliceable(const jdf_function_entry_t *f)
+{
+    int nb_locals;
+
+    if( NULL == f->locals ||
+        JDF_RANGE != f->locals->expr->op || NULL != f->locals->expr->local_variables )
+        return 0;
+    if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ||
+        0 != (f->user_defines & JDF_FUNCTION_HAS_UD_STARTUP_TASKS_FUN) )
+        return 0;
+    if( 0 != (f->user_defines & JDF_HAS_UD_NB_LOCAL_TASKS) ||
+        0 != (f->user_defines & JDF_HAS_DYNAMIC_TERMDET) ||
+        0 != (f->user_defines & JDF_HAS_USER_TRIGGERED_TERMDET) ) {
+        /* Without counting, the internal_init iterates only for the hash keys */
+        if( 0 != (f->user_defines & JDF_FUNCTION_HAS_UD_MAKE_KEY) )
+            return 0;
+    } else if( jdf_first_counted_local(f) == f->locals ) {
+        return 0;  /* the outermost local is counted, not iterated */
+    }
+    JDF_COUNT_LIST_ENTRIES(f->locals, jdf_variable_list_t, next, nb_locals);
+    return (nb_locals + f->nb_max_local_def + 2) <= MAX_LOCAL_COUNT;
+}
+
+/**
+ * Returns 1 if the index-array dependencies of a task class are allocated
+ * lazily by pages, one for each value of its first parameter: this parameter
+ * must be the outermost local and a plain range, there must be other
+ * parameters, all ranges whose bounds are kept in the taskpool, and the local
+ * tasks of each page must be counted by the internal_init.
+ */
+static int jdf_function_has_lazy_dep_pages(const jdf_function_entry_t *f)
+{
+    const jdf_variable_list_t *vl;
+    int nb_params = 0;
+
+    if( !JDF_COMPILER_GLOBAL_ARGS.lazy_dep_pages ||
+        JDF_COMPILER_GLOBAL_ARGS.dep_management != DEP_MANAGEMENT_INDEX_ARRAY )
+        return 0;
+    if( 0 != (f->user_defines & (JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS | JDF_FUNCTION_HAS_UD_MAKE_KEY |
+                                 JDF_HAS_UD_NB_LOCAL_TASKS | JDF_HAS_DYNAMIC_TERMDET |
+                                 JDF_HAS_USER_TRIGGERED_TERMDET)) )
+        return 0;
+    if( NULL == f->locals || NULL == local_is_parameter(f, f->locals) ||
+        JDF_RANGE != f->locals->expr->op || NULL != f->locals->expr->local_variables )
+        return 0;
+    for( vl = f->locals; NULL != vl; vl = vl->next ) {
+        if( NULL == local_is_parameter(f, vl) )
+            continue;
+        if( JDF_RANGE != vl->expr->op || NULL != vl->expr->local_variables )
+            return 0;
+        nb_params++;
+    }
+    return nb_params > 1;
+}
+
 static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entry_t *f, const char *fname)
 {
     string_arena_t *sa1, *sa2, *sa_end;
-    const jdf_variable_list_t *vl, *inner_vl = NULL;
+    const jdf_variable_list_t *vl, *inner_vl = NULL, *counted_vl = NULL;
     jdf_expr_t *ld;
     const jdf_param_list_t *pl;
     expr_info_t info = EMPTY_EXPR_INFO;
-    int need_to_iterate, need_min_max, need_to_count_tasks;
+    int need_to_iterate, need_min_max, need_to_count_tasks, counted = 0, sliceable, lazy_pages;
     int nesting = 0, idx;
     jdf_l2p_t *l2p = build_l2p(f), *l2p_item;
     char *dep_key_fn_name = NULL;
@@ -3451,6 +3708,17 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             (0 == (f->user_defines & JDF_HAS_DYNAMIC_TERMDET)) &&
             (0 == (f->user_defines & JDF_HAS_USER_TRIGGERED_TERMDET));
     need_to_iterate = need_min_max || need_to_count_tasks;
+    /* The dependencies arrays are allocated for each local task, the other
+     * dependency managements let us count the tasks of the innermost locals,
+     * and the lazy pages of dependencies those of all the locals but the first */
+    lazy_pages = jdf_function_has_lazy_dep_pages(f);
+    if( need_to_count_tasks &&
+        (lazy_pages || JDF_COMPILER_GLOBAL_ARGS.dep_management != DEP_MANAGEMENT_INDEX_ARRAY) ) {
+        counted_vl = jdf_first_counted_local(f);
+        if( lazy_pages && counted_vl == f->locals )
+            counted_vl = f->locals->next;
+    }
+    sliceable = need_to_iterate && jdf_startup_is_sliceable(f);
 
     if( 0 != (f->user_defines & JDF_FUNCTION_HAS_UD_HASH_STRUCT) ) {
         dep_key_fn_name = strdup( jdf_property_get_string(f->properties, JDF_PROP_UD_HASH_STRUCT_NAME, NULL) );
@@ -3476,9 +3744,18 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
 
     if(need_to_count_tasks) {
         coutput("  int32_t nb_tasks = 0, saved_nb_tasks = 0;\n");
+        if( NULL != counted_vl ) {
+            coutput("  int32_t %snb_values = 1;\n", JDF2C_NAMESPACE);
+        }
         /* prepare the epilog output to prevent compiler from complaining about initialized but unused data */
         string_arena_add_string(sa_end, "(void)saved_nb_tasks;\n");
     }
+    if( sliceable ) {
+        /* This startup task enumerates only one slice of the values of the outermost local */
+        coutput("  const int32_t %sslice = "STARTUP_TASK_SLICE", %snb_slices = __parsec_tp->startup_slices;\n"
+                "  int %slast_slice;\n",
+                JDF2C_NAMESPACE, JDF2C_NAMESPACE, JDF2C_NAMESPACE);
+    }
     if( need_min_max ) {
         for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
             vl = l2p_item->vl; assert(NULL != vl);
@@ -3539,11 +3816,12 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
 
     if( need_to_iterate || need_min_max ) {
         for(vl = f->locals; vl != NULL; vl = vl->next) {
+            if( vl == counted_vl ) counted = 1;
             if(vl->expr->op == JDF_RANGE) {
                 coutput("%s    %s%s_start = %s;\n",
-                        indent(nesting), JDF2C_NAMESPACE, vl->name, dump_expr((void**)vl->expr->jdf_ta1, &info));
+                        indent(nesting), JDF2C_NAMESPACE, vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta1, &info));
                 coutput("%s    %s%s_end = %s;\n",
-                        indent(nesting), JDF2C_NAMESPACE, vl->name, dump_expr((void**)vl->expr->jdf_ta2, &info));
+                        indent(nesting), JDF2C_NAMESPACE, vl->name, jdf_dump_param_bound(f, vl, vl->expr->jdf_ta2, &info));
                 coutput("%s    %s%s_inc = %s;\n",
                         indent(nesting), JDF2C_NAMESPACE, vl->name, dump_expr((void**)vl->expr->jdf_ta3, &info));
 
@@ -3557,11 +3835,36 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                     coutput("%s    %s%s_max = parsec_imax(%s%s_max, __%s_max);\n",
                             indent(nesting), JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name, vl->name);
                 }
+                if( lazy_pages && vl == f->locals ) {
+                    /* Only the array of the pages is allocated, with their counters of local tasks */
+                    coutput("    ALLOCATE_DEP_TRACKING(dep, __%s_min, __%s_max, \"%s\", PARSEC_DEPENDENCIES_FLAG_NEXT);\n"
+                            "    __parsec_tp->%s_page_nb_tasks = (int32_t*)calloc(__%s_max - __%s_min + 1, sizeof(int32_t));\n",
+                            vl->name, vl->name, vl->name,
+                            f->fname, vl->name, vl->name);
+                }
+
+                if( counted ) {
+                    /* The rank of the tasks does not depend on this local, its values are counted */
+                    coutput("%s    %snb_values %s parsec_range_nb_values(%s%s_start, %s%s_end, %s%s_inc);\n"
+                            "%s    %s = %s%s_start;\n"
+                            "%s    assignments.%s.value = %s;\n",
+                            indent(nesting), JDF2C_NAMESPACE, vl == counted_vl ? "=" : "*=",
+                            JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE, vl->name,
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name,
+                            indent(nesting), vl->name, vl->name);
+                    continue;
+                }
 
                 /* Adapt the loop condition depending on the value of the increment. We can
                  * now handle both increasing and decreasing execution spaces. */
-                coutput("%s    for(%s =  %s%s_start;\n",
-                    indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name);
+                if( sliceable && vl == f->locals ) {
+                    coutput("%s    for(%s =  %s%s_start + %sslice * %s%s_inc;\n",
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name,
+                            JDF2C_NAMESPACE, JDF2C_NAMESPACE, vl->name);
+                } else {
+                    coutput("%s    for(%s =  %s%s_start;\n",
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name);
+                }
                 if( JDF_OP_IS_CST(vl->expr->jdf_ta3->op) ) {
                     if( vl->expr->jdf_ta3->jdf_cst >= 0 ) {
                         coutput("%s        %s <= %s%s_end;\n",
@@ -3576,8 +3879,13 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                             indent(nesting), JDF2C_NAMESPACE, vl->name, vl->name, JDF2C_NAMESPACE, vl->name,
                             indent(nesting), JDF2C_NAMESPACE, vl->name, vl->name, JDF2C_NAMESPACE, vl->name);
                 }
-                coutput("%s        %s += %s%s_inc) {\n",
-                    indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name);
+                if( sliceable && vl == f->locals ) {
+                    coutput("%s        %s += %s%s_inc * %snb_slices) {\n",
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name, JDF2C_NAMESPACE);
+                } else {
+                    coutput("%s        %s += %s%s_inc) {\n",
+                            indent(nesting), vl->name, JDF2C_NAMESPACE, vl->name);
+                }
             } else if ( NULL != vl->expr->local_variables) {
                 for(ld = jdf_expr_lv_first(vl->expr->local_variables); NULL != ld; ld = jdf_expr_lv_next(vl->expr->local_variables, ld)) {
                     assert(NULL != ld->alias);
@@ -3629,13 +3937,36 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
 
         string_arena_init(sa1);
         string_arena_init(sa2);
-        coutput("%s  if( !%s_pred(%s) ) continue;\n",
-                indent(nesting), f->fname, UTIL_DUMP_LIST_FIELD(sa2, f->locals, next, name,
-                                                                dump_string, NULL,
-                                                                "", "", ", ", ""));
-        if( need_to_count_tasks ) {
+        if( NULL != counted_vl && lazy_pages ) {
+            coutput("%s  if( %s_pred(%s) ) {\n"
+                    "%s    nb_tasks += %snb_values;\n"
+                    "%s    __parsec_tp->%s_page_nb_tasks[%s - dep->min] += %snb_values;\n"
+                    "%s  }\n",
+                    indent(nesting), f->fname, UTIL_DUMP_LIST_FIELD(sa2, f->locals, next, name,
+                                                                    dump_string, NULL,
+                                                                    "", "", ", ", ""),
+                    indent(nesting), JDF2C_NAMESPACE,
+                    indent(nesting), f->fname, f->locals->name, JDF2C_NAMESPACE,
+                    indent(nesting));
+        } else if( NULL != counted_vl ) {
+            coutput("%s  if( %s_pred(%s) ) nb_tasks += %snb_values;\n",
+                    indent(nesting), f->fname, UTIL_DUMP_LIST_FIELD(sa2, f->locals, next, name,
+                                                                    dump_string, NULL,
+                                                                    "", "", ", ", ""),
+                    JDF2C_NAMESPACE);
+        } else {
+            coutput("%s  if( !%s_pred(%s) ) continue;\n",
+                    indent(nesting), f->fname, UTIL_DUMP_LIST_FIELD(sa2, f->locals, next, name,
+                                                                    dump_string, NULL,
+                                                                    "", "", ", ", ""));
+        }
+        if( need_to_count_tasks && NULL == counted_vl ) {
             coutput("%s  nb_tasks++;\n",
                     indent(nesting));
+            if( lazy_pages ) {
+                coutput("%s  __parsec_tp->%s_page_nb_tasks[%s - dep->min]++;\n",
+                        indent(nesting), f->fname, f->locals->name);
+            }
         }
 
         /* We close all non-range variables */
@@ -3666,7 +3997,7 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             inner_vl = vl;
         }
 
-        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
+        if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY && !lazy_pages ) {
             /* If no tasks have been generated during the last loop, there is no need
              * to have any dependencies.
              */
@@ -3746,6 +4077,23 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                     indent(nesting),
                     indent(nesting));
         }
+        if( sliceable ) {
+            coutput("  parsec_atomic_lock(&__parsec_tp->startup_lock);\n");
+            if( need_min_max ) {
+                coutput("  if( 0 != __parsec_tp->startup_slices_done[%d] ) {  /* merge with the slices already enumerated */\n",
+                        f->task_class_id);
+                for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
+                    vl = l2p_item->vl;
+                    if( NULL == (pl = l2p_item->pl) ) continue;
+                    if(vl->expr->op != JDF_RANGE && NULL == vl->expr->local_variables) continue;
+                    coutput("    %s%s_min = parsec_imin(%s%s_min, __parsec_tp->%s_%s_min);\n"
+                            "    %s%s_max = parsec_imax(%s%s_max, __parsec_tp->%s_%s_min + __parsec_tp->%s_%s_range - 1);\n",
+                            JDF2C_NAMESPACE, pl->name, JDF2C_NAMESPACE, pl->name, f->fname, pl->name,
+                            JDF2C_NAMESPACE, pl->name, JDF2C_NAMESPACE, pl->name, f->fname, pl->name, f->fname, pl->name);
+                }
+                coutput("  }\n");
+            }
+        }
         if( need_min_max ) {
             coutput("  /* Set the range variables for the collision-free hash-computation */\n");
             for(l2p_item = l2p; NULL != l2p_item; l2p_item = l2p_item->next) {
@@ -3761,6 +4109,14 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
                 }
             }
         }
+        if( sliceable ) {
+            if( need_to_count_tasks ) {
+                coutput("  __parsec_tp->startup_nb_tasks[%d] += nb_tasks;\n", f->task_class_id);
+            }
+            coutput("  %slast_slice = (++__parsec_tp->startup_slices_done[%d] == %snb_slices);\n"
+                    "  parsec_atomic_unlock(&__parsec_tp->startup_lock);\n",
+                    JDF2C_NAMESPACE, f->task_class_id, JDF2C_NAMESPACE);
+        }
     }
     /* If this startup task belongs to a task class that has the potential to generate initial tasks,
      * we should be careful to delay the generation of these tasks until all initializations tasks
@@ -3783,6 +4139,10 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
 
     string_arena_free(sa1);
     string_arena_free(sa2);
+    if( sliceable ) {
+        /* Only the last slice enumerated sets up the task class */
+        coutput("  if( %slast_slice ) {\n", JDF2C_NAMESPACE);
+    }
     coutput("\n  PARSEC_AYU_REGISTER_TASK(&%s_%s);\n", jdf_basename, f->fname);
     idx = 0;
     JDF_COUNT_LIST_ENTRIES(f->dataflow, jdf_dataflow_t, next, idx);
@@ -3810,10 +4170,21 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
      * - the own tasks use it when reshaping a datacopy directly read from desc
      * No longer only when if( !(f->flags & JDF_FUNCTION_FLAG_NO_SUCCESSORS) )
      */
+    sa1 = string_arena_new(64);
+    if( !need_to_count_tasks )
+        string_arena_add_string(sa1, "PARSEC_DEFAULT_DATAREPO_HASH_LENGTH");
+    else if( sliceable )
+        string_arena_add_string(sa1, "__parsec_tp->startup_nb_tasks[%d]", f->task_class_id);
+    else
+        string_arena_add_string(sa1, "nb_tasks");
     coutput("  __parsec_tp->repositories[%d] = data_repo_create_nothreadsafe(%s, %s, (parsec_taskpool_t*)__parsec_tp, %d);\n",
-            f->task_class_id, need_to_count_tasks ? "nb_tasks" : "PARSEC_DEFAULT_DATAREPO_HASH_LENGTH",
+            f->task_class_id, string_arena_get_string(sa1),
             jdf_property_get_string(f->properties, JDF_PROP_UD_HASH_STRUCT_NAME, NULL),
             idx );
+    if( sliceable ) {
+        coutput("  }\n");
+    }
+    string_arena_free(sa1);
 
     coutput("%s"
             "  %s (void)__parsec_tp; (void)es;\n",
@@ -3851,9 +4222,8 @@ static void jdf_generate_internal_init(const jdf_t *jdf, const jdf_function_entr
             /* The startup tasks are going to count the real number of tasks as they discover them.
              * For now, we lock the idleness by creating a runtime pending action, and
              * we use sync_point to find when all the startup tasks are done. */
-            coutput("    __parsec_tp->sync_point = PARSEC_%s_NB_TASK_CLASSES;\n"
-                    "    //__parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks(&__parsec_tp->super.super, 1);\n",
-                    jdf_basename);
+            coutput("    __parsec_tp->sync_point = __parsec_tp->nb_startup_tasks;\n"
+                    "    //__parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks(&__parsec_tp->super.super, 1);\n");
         }
     } else {
         coutput("    __parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks(&__parsec_tp->super.super, __parsec_tp->initial_number_tasks);\n");
@@ -3899,12 +4269,14 @@ static void jdf_generate_simulation_cost_fct(const jdf_t *jdf, const jdf_functio
     ai.holder = "this_task->locals.";
     ai.expr = NULL;
 
-    coutput("#if defined(PARSEC_SIM)\n"
+    /* The estimation of the taskpool also uses the simulation cost */
+    coutput("%s"
             "static int %s(const %s *this_task)\n"
             "{\n"
             "  const parsec_taskpool_t *__parsec_tp = (const parsec_taskpool_t*)this_task->taskpool;\n"
             "%s"
             "  (void)__parsec_tp;\n",
+            JDF_COMPILER_GLOBAL_ARGS.estimate ? "" : "#if defined(PARSEC_SIM)\n",
             prefix, parsec_get_name(jdf, f, "task_t"),
             UTIL_DUMP_LIST(sa1, f->locals, next,
                            dump_local_assignments, &ai, "", "  ", "\n", "\n"));
@@ -3921,8 +4293,9 @@ static void jdf_generate_simulation_cost_fct(const jdf_t *jdf, const jdf_functio
     info.assignments = "&this_task->locals";
     coutput("  return %s;\n", dump_expr((void**)f->simcost, &info));
     coutput("}\n"
-            "#endif\n"
-            "\n");
+            "%s"
+            "\n",
+            JDF_COMPILER_GLOBAL_ARGS.estimate ? "" : "#endif\n");
 
     string_arena_free(sa);
     string_arena_free(sa1);
@@ -4005,7 +4378,10 @@ static void jdf_generate_release_task_fct(const jdf_t *jdf, jdf_function_entry_t
             prefix,
             jdf_basename,
             jdf_basename);
-    if( !(f->user_defines & JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS) ) {
+    coutput("    (void)__parsec_tp;\n");
+    /* The dependencies of the tasks with a single input are not in the hash table */
+    if( !(f->user_defines & JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS) &&
+        !(f->flags & JDF_FUNCTION_FLAG_SINGLE_INPUT) ) {
         coutput("    parsec_hash_table_t *ht = (parsec_hash_table_t*)__parsec_tp->super.super.dependencies_array[%d];\n"
                 "    parsec_key_t key = this_task->task_class->make_key((const parsec_taskpool_t*)__parsec_tp, (const parsec_assignment_t*)&this_task->locals);\n"
                 "    parsec_hashable_dependency_t *hash_dep = (parsec_hashable_dependency_t *)parsec_hash_table_remove(ht, key);\n",
@@ -4030,6 +4406,72 @@ static void jdf_generate_release_task_fct(const jdf_t *jdf, jdf_function_entry_t
             "\n");
 }
 
+/**
+ * The last local task of a page of the index-array dependencies releases
+ * the arrays of the page: all its tasks have been activated.
+ */
+static void jdf_generate_release_page_task_fct(const jdf_t *jdf, jdf_function_entry_t *f, const char *prefix)
+{
+    (void)jdf;
+    coutput("static parsec_hook_return_t %s(parsec_execution_stream_t *es, parsec_task_t *this_task)\n"
+            "{\n"
+            "    const __parsec_%s_internal_taskpool_t *__parsec_tp =\n"
+            "        (const __parsec_%s_internal_taskpool_t *)this_task->taskpool;\n"
+            "    parsec_dependencies_t *deps = (parsec_dependencies_t*)__parsec_tp->super.super.dependencies_array[%d];\n"
+            "    int page = ((%s*)this_task)->locals.%s.value - deps->min;\n"
+            "\n"
+            "    if( 1 == parsec_atomic_fetch_dec_int32(&__parsec_tp->%s_page_nb_tasks[page]) ) {\n"
+            "        parsec_dependencies_t *page_deps = deps->u.next[page];\n"
+            "        deps->u.next[page] = NULL;\n"
+            "        parsec_destruct_dependencies(page_deps);\n"
+            "    }\n"
+            "    return parsec_release_task_to_mempool_update_nbtasks(es, this_task);\n"
+            "}\n"
+            "\n",
+            prefix,
+            jdf_basename, jdf_basename,
+            f->task_class_id,
+            parsec_get_name(jdf, f, "task_t"), f->locals->name,
+            f->fname);
+}
+
+/**
+ * With direct calls, generate the release of a dependency of a task of f
+ * used by the iteration over the successors of its predecessors: when the
+ * dependency is released locally, the dependencies of the task are looked up
+ * and updated by direct calls to the functions of its task class.
+ */
+static void jdf_generate_release_dep_fct(const jdf_t *jdf, const jdf_function_entry_t *f, int use_mask)
+{
+    (void)jdf;
+    coutput("static inline parsec_ontask_iterate_t\n"
+            "release_dep_of_%s_%s(parsec_execution_stream_t *es, const parsec_task_t *nc, const parsec_task_t *this_task,\n"
+            "                     const parsec_dep_t *dep, parsec_dep_data_description_t *data,\n"
+            "                     int rank_src, int rank_dst, int vpid_dst,\n"
+            "                     data_repo_t *successor_repo, parsec_key_t successor_repo_key, void *ontask_arg)\n"
+            "{\n"
+            "  const parsec_release_dep_fct_arg_t *arg = (const parsec_release_dep_fct_arg_t*)ontask_arg;\n"
+            "  int completed = 0;\n"
+            "\n"
+            "  if( (arg->action_mask & PARSEC_ACTION_RELEASE_LOCAL_DEPS) &&\n"
+            "      (es->virtual_process->parsec_context->my_rank == rank_dst) ) {\n",
+            jdf_basename, f->fname);
+    if( f->flags & JDF_FUNCTION_FLAG_SINGLE_INPUT ) {
+        coutput("    /* The predecessor is the only one of the task, it is ready */\n"
+                "    completed = 1;\n");
+    } else {
+        coutput("    parsec_dependency_t *deps = %s(this_task->taskpool, es, nc);\n"
+                "    completed = %s(this_task->taskpool, nc, deps, this_task, dep->belongs_to, dep->flow);\n",
+                jdf_property_get_function(f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, NULL),
+                use_mask ? "parsec_update_deps_with_mask" : "parsec_update_deps_with_counter");
+    }
+    coutput("  }\n"
+            "  return parsec_release_dep_completed_fct(es, nc, this_task, dep, data, rank_src, rank_dst, vpid_dst,\n"
+            "                                          successor_repo, successor_repo_key, ontask_arg, completed);\n"
+            "}\n"
+            "\n");
+}
+
 static int jdf_function_property_has_duplicate_name(const jdf_def_list_t *cp)
 {
     if (NULL == cp->next) return 0;
@@ -4264,20 +4706,24 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
 
     if( use_mask ) {
         string_arena_add_string(sa,
-                                "  .flags = %s%s%s | PARSEC_USE_DEPS_MASK,\n"
+                                "  .flags = %s%s%s%s%s | PARSEC_USE_DEPS_MASK,\n"
                                 "  .dependencies_goal = 0x%x,\n",
                                 (f->flags & JDF_FUNCTION_FLAG_HIGH_PRIORITY) ? "PARSEC_HIGH_PRIORITY_TASK" : "0x0",
                                 has_in_in_dep ? " | PARSEC_HAS_IN_IN_DEPENDENCIES" : "",
                                 jdf_property_get_int(f->properties, "immediate", 0) ? " | PARSEC_IMMEDIATE_TASK" : "",
+                                (f->flags & JDF_FUNCTION_FLAG_COARSENED) ? " | PARSEC_COARSENED_TASK" : "",
+                                (f->flags & JDF_FUNCTION_FLAG_SINGLE_INPUT) ? " | PARSEC_SINGLE_INPUT_TASK" : "",
                                 inputmask);
     } else {
         string_arena_add_string(sa,
-                                "  .flags = %s%s%s%s,\n"
+                                "  .flags = %s%s%s%s%s%s,\n"
                                 "  .dependencies_goal = %d,\n",
                                 (f->flags & JDF_FUNCTION_FLAG_HIGH_PRIORITY) ? "PARSEC_HIGH_PRIORITY_TASK" : "0x0",
                                 has_in_in_dep ? " | PARSEC_HAS_IN_IN_DEPENDENCIES" : "",
                                 jdf_property_get_int(f->properties, "immediate", 0) ? " | PARSEC_IMMEDIATE_TASK" : "",
                                 has_control_gather ? "|PARSEC_HAS_CTL_GATHER" : "",
+                                (f->flags & JDF_FUNCTION_FLAG_COARSENED) ? " | PARSEC_COARSENED_TASK" : "",
+                                (f->flags & JDF_FUNCTION_FLAG_SINGLE_INPUT) ? " | PARSEC_SINGLE_INPUT_TASK" : "",
                                 nb_input);
     }
 
@@ -4310,6 +4756,9 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
     } else {
         string_arena_add_string(sa, "  .update_deps = parsec_update_deps_with_counter,\n");
     }
+    if( JDF_COMPILER_GLOBAL_ARGS.direct_calls ) {
+        jdf_generate_release_dep_fct(jdf, f, use_mask);
+    }
 
     if( !(f->flags & JDF_FUNCTION_FLAG_NO_SUCCESSORS) ) {
         sprintf(prefix, "iterate_successors_of_%s_%s", jdf_basename, f->fname);
@@ -4351,7 +4800,11 @@ static void jdf_generate_one_function( const jdf_t *jdf, jdf_function_entry_t *f
      * the tasks, the value returned from this function is not PARSEC_UNDETERMINED_NB_TASKS
      * (which means the runtime will have to count the completed tasks).
      */
-    if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
+    if( jdf_function_has_lazy_dep_pages(f) ) {
+        sprintf(prefix, "release_task_of_%s_%s", jdf_basename, f->fname);
+        jdf_generate_release_page_task_fct(jdf, f, prefix);
+        string_arena_add_string(sa, "  .release_task = &%s,\n", prefix);
+    } else if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
         string_arena_add_string(sa, "  .release_task = (parsec_hook_t*)parsec_release_task_to_mempool_update_nbtasks,\n");
     } else if ( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_DYNAMIC_HASH_TABLE ) {
         /* If we have a user-defined find_deps function, don't generate the hashtable_dep release task, keep
@@ -4443,10 +4896,140 @@ static void jdf_generate_priority_prototypes( const jdf_t *jdf )
     }
 }
 
+/**
+ * With direct calls, the release of the dependencies of the tasks of each task
+ * class is called by the iteration over the successors of the task classes
+ * generated before it.
+ */
+static void jdf_generate_release_dep_prototypes( const jdf_t *jdf )
+{
+    const jdf_function_entry_t *f;
+
+    for(f = jdf->functions; f != NULL; f = f->next) {
+        coutput("static inline parsec_ontask_iterate_t\n"
+                "release_dep_of_%s_%s(parsec_execution_stream_t *es, const parsec_task_t *nc, const parsec_task_t *this_task,\n"
+                "                     const parsec_dep_t *dep, parsec_dep_data_description_t *data,\n"
+                "                     int rank_src, int rank_dst, int vpid_dst,\n"
+                "                     data_repo_t *successor_repo, parsec_key_t successor_repo_key, void *ontask_arg);\n",
+                jdf_basename, f->fname);
+    }
+}
+
+static int jdf_function_has_cpu_body( const jdf_function_entry_t *f )
+{
+    jdf_def_list_t* type_property;
+
+    for(jdf_body_t* body = f->bodies; NULL != body; body = body->next) {
+        jdf_find_property(body->properties, "type", &type_property);
+        if( NULL == type_property ) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Generate the function executing the steps of the tasks of the taskpool
+ * through direct calls to the generated functions. Each call is guarded by
+ * the pointer it replaces, such that the hooks installed by the user, by
+ * PINS or by another device than the CPU are still called.
+ */
+static void jdf_generate_task_dispatch( const jdf_t *jdf )
+{
+    const jdf_function_entry_t *f;
+    char name[1024];
+
+    coutput("static int __parsec_%s_task_dispatch(parsec_execution_stream_t *es, parsec_task_t *this_task, parsec_task_step_t step)\n"
+            "{\n"
+            "  const parsec_task_class_t *tc = this_task->task_class;\n"
+            "  parsec_hook_t *hook;\n"
+            "\n"
+            "  switch( step ) {\n"
+            "  case PARSEC_TASK_STEP_PREPARE_INPUT: hook = tc->prepare_input; break;\n"
+            "  case PARSEC_TASK_STEP_EXECUTE: hook = tc->incarnations[this_task->selected_chore].hook; break;\n"
+            "  default: hook = tc->complete_execution; break;\n"
+            "  }\n"
+            "  switch( tc->task_class_id ) {\n",
+            jdf_basename);
+    for(f = jdf->functions; f != NULL; f = f->next) {
+        snprintf(name, sizeof(name), "%s_%s", jdf_basename, f->fname);
+        coutput("  case %d:  /* %s */\n"
+                "    switch( step ) {\n"
+                "    case PARSEC_TASK_STEP_PREPARE_INPUT:\n"
+                "      if( hook == (parsec_hook_t*)data_lookup_of_%s )\n"
+                "        return data_lookup_of_%s(es, (%s*)this_task);\n"
+                "      break;\n",
+                f->task_class_id, f->fname,
+                name, name, parsec_get_name(jdf, f, "task_t"));
+        if( jdf_function_has_cpu_body(f) ) {
+            coutput("#if defined(PARSEC_HAVE_DEV_CPU_SUPPORT)\n"
+                    "    case PARSEC_TASK_STEP_EXECUTE:\n"
+                    "      if( hook == (parsec_hook_t*)hook_of_%s )\n"
+                    "        return hook_of_%s(es, (%s*)this_task);\n"
+                    "      break;\n"
+                    "#endif  /* defined(PARSEC_HAVE_DEV_CPU_SUPPORT) */\n",
+                    name, name, parsec_get_name(jdf, f, "task_t"));
+        }
+        coutput("    case PARSEC_TASK_STEP_COMPLETE:\n"
+                "      if( hook == (parsec_hook_t*)complete_hook_of_%s )\n"
+                "        return complete_hook_of_%s(es, (%s*)this_task);\n"
+                "      break;\n"
+                "    default:\n"
+                "      break;\n"
+                "    }\n"
+                "    break;\n",
+                name, name, parsec_get_name(jdf, f, "task_t"));
+    }
+    coutput("  default:  /* the startup tasks */\n"
+            "    break;\n"
+            "  }\n"
+            "  return hook(es, this_task);\n"
+            "}\n\n");
+}
+
+/**
+ * Compute the bounds of the parameters depending only on the globals in the
+ * taskpool __parsec_tp, as the successors of the tasks are iterated with them.
+ */
+static void jdf_generate_hoisted_bounds(const jdf_t *jdf, string_arena_t *sa)
+{
+    const jdf_function_entry_t *f;
+    int hoisted_bounds = 0;
+
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        const jdf_variable_list_t *vl;
+        expr_info_t info = EMPTY_EXPR_INFO;
+
+        info.sa = sa;
+        info.prefix = "";
+        info.suffix = "";
+        info.assignments = "(void*)"JDF2C_NAMESPACE"no_locals";
+        for( vl = f->locals; NULL != vl; vl = vl->next ) {
+            if( JDF_RANGE != vl->expr->op ) continue;
+            if( 0 == hoisted_bounds &&
+                (jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta1) ||
+                 jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta2)) ) {
+                coutput("  parsec_assignment_t "JDF2C_NAMESPACE"no_locals[MAX_LOCAL_COUNT];\n"
+                        "  memset("JDF2C_NAMESPACE"no_locals, 0, sizeof("JDF2C_NAMESPACE"no_locals));\n");
+                hoisted_bounds = 1;
+            }
+            if( jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta1) )
+                coutput("  __parsec_tp->%s_%s_lb = %s;\n", f->fname, vl->name,
+                        dump_expr((void**)vl->expr->jdf_ta1, &info));
+            if( jdf_param_bound_is_hoisted(f, vl, vl->expr->jdf_ta2) )
+                coutput("  __parsec_tp->%s_%s_ub = %s;\n", f->fname, vl->name,
+                        dump_expr((void**)vl->expr->jdf_ta2, &info));
+        }
+    }
+}
+
 static void jdf_generate_startup_hook( const jdf_t *jdf )
 {
     string_arena_t *sa1 = string_arena_new(64);
     string_arena_t *sa2 = string_arena_new(64);
+    const jdf_function_entry_t *f;
+    int idx, max_id = 0;
+
+    for( f = jdf->functions; NULL != f; f = f->next )
+        if( max_id <= f->task_class_id ) max_id = f->task_class_id + 1;
 
     coutput("static void %s_startup(parsec_context_t *context, __parsec_%s_internal_taskpool_t *__parsec_tp, parsec_list_item_t ** ready_tasks)\n"
             "{\n"
@@ -4487,6 +5070,27 @@ static void jdf_generate_startup_hook( const jdf_t *jdf )
                            "                     device->name, parsec_dc->key_base, parsec_dc, __parsec_tp);\n"
                            "        __parsec_tp->super.super.devices_index_mask &= ~(1 << device->device_index);\n"
                            "      }\n"));
+    /* The bounds of the parameters depending only on the globals, before any task is created */
+    jdf_generate_hoisted_bounds(jdf, sa2);
+    /* The startup of the sliceable task classes is split across the execution streams */
+    string_arena_init(sa1);
+    for( idx = 0; idx < max_id; idx++ ) {
+        for( f = jdf->functions; NULL != f && f->task_class_id != idx; f = f->next ) /* nothing */;
+        string_arena_add_string(sa1, "%s%d", 0 == idx ? "" : ", ", (NULL != f) && jdf_startup_is_sliceable(f));
+    }
+    coutput("  static const int32_t sliceable[] = { %s };\n"
+            "  int32_t s, nb_slices, where = 0;\n"
+            "  if( 0 == (__parsec_tp->startup_slices = (int32_t)parsec_task_startup_slices) ) {\n"
+            "    for( i = 0; i < (uint32_t)context->nb_vp; i++ )\n"
+            "      __parsec_tp->startup_slices += context->virtual_processes[i]->nb_cores;\n"
+            "  }\n"
+            "  __parsec_tp->nb_startup_tasks = 0;\n"
+            "  for( i = 0; i < PARSEC_%s_NB_TASK_CLASSES; i++ )\n"
+            "    __parsec_tp->nb_startup_tasks += sliceable[i] ? __parsec_tp->startup_slices : 1;\n"
+            "  __parsec_tp->sync_point = __parsec_tp->nb_startup_tasks;\n"
+            "  __parsec_tp->super.super.tdm.module->taskpool_addto_runtime_actions(&__parsec_tp->super.super,\n"
+            "                                                                      __parsec_tp->nb_startup_tasks - PARSEC_%s_NB_TASK_CLASSES);\n",
+            string_arena_get_string(sa1), jdf_basename, jdf_basename);
     coutput("  /* Remove all the chores without a backend device */\n"
             "  for( i = 0; i < PARSEC_%s_NB_TASK_CLASSES; i++ ) {\n"
             "    parsec_task_class_t* tc = (parsec_task_class_t*)__parsec_tp->super.super.task_classes_array[i];\n"
@@ -4503,18 +5107,22 @@ static void jdf_generate_startup_hook( const jdf_t *jdf )
             "    chores[idx].type     = PARSEC_DEV_NONE;\n"
             "    chores[idx].evaluate = NULL;\n"
             "    chores[idx].hook     = NULL;\n"
-            "    /* Create the initialization tasks for each taskclass */\n"
-            "    parsec_task_t* task = (parsec_task_t*)parsec_thread_mempool_allocate(context->virtual_processes[0]->execution_streams[0]->context_mempool);\n"
-            "    PARSEC_OBJ_CONSTRUCT(task, parsec_task_t); /* construct called only when new, force-construct it again */\n"
-            "    task->taskpool = (parsec_taskpool_t *)__parsec_tp;\n"
-            "    task->chore_mask = PARSEC_DEV_CPU;\n"
-            "    memset(&task->locals, 0, sizeof(parsec_assignment_t) * MAX_LOCAL_COUNT);\n"
-            "    PARSEC_LIST_ITEM_SINGLETON(task);\n"
-            "    task->priority = -1;\n"
-            "    task->task_class = task->taskpool->task_classes_array[PARSEC_%s_NB_TASK_CLASSES + i];\n"
-            "    int where = i %% context->nb_vp;\n"
-            "    if( NULL == ready_tasks[where] ) ready_tasks[where] = &task->super;\n"
-            "    else ready_tasks[where] = parsec_list_item_ring_push(ready_tasks[where], &task->super);\n"
+            "    /* Create the initialization tasks for each taskclass, one per slice */\n"
+            "    nb_slices = sliceable[i] ? __parsec_tp->startup_slices : 1;\n"
+            "    for( s = 0; s < nb_slices; s++ ) {\n"
+            "      parsec_task_t* task = (parsec_task_t*)parsec_thread_mempool_allocate(context->virtual_processes[0]->execution_streams[0]->context_mempool);\n"
+            "      PARSEC_OBJ_CONSTRUCT(task, parsec_task_t); /* construct called only when new, force-construct it again */\n"
+            "      task->taskpool = (parsec_taskpool_t *)__parsec_tp;\n"
+            "      task->chore_mask = PARSEC_DEV_CPU;\n"
+            "      memset(&task->locals, 0, sizeof(parsec_assignment_t) * MAX_LOCAL_COUNT);\n"
+            "      task->locals[MAX_LOCAL_COUNT-1].value = s;\n"
+            "      PARSEC_LIST_ITEM_SINGLETON(task);\n"
+            "      task->priority = -1;\n"
+            "      task->task_class = task->taskpool->task_classes_array[PARSEC_%s_NB_TASK_CLASSES + i];\n"
+            "      if( NULL == ready_tasks[where] ) ready_tasks[where] = &task->super;\n"
+            "      else ready_tasks[where] = parsec_list_item_ring_push(ready_tasks[where], &task->super);\n"
+            "      where = (where + 1) %% context->nb_vp;\n"
+            "    }\n"
             "  }\n",
             jdf_basename, jdf_basename);
     /**
@@ -4589,6 +5197,8 @@ static void jdf_generate_destructor( const jdf_t *jdf )
         }
         coutput("  __parsec_tp->super.super.dependencies_array[%d] = NULL;\n",
                 f->task_class_id);
+        if( jdf_function_has_lazy_dep_pages(f) )
+            coutput("  free(__parsec_tp->%s_page_nb_tasks);\n", f->fname);
     }
     coutput("  free( __parsec_tp->super.super.dependencies_array );\n"
             "  __parsec_tp->super.super.dependencies_array = NULL;\n");
@@ -4642,6 +5252,7 @@ static void jdf_generate_constructor( const jdf_t* jdf )
 {
     string_arena_t *sa1, *sa2;
     profiling_init_info_t pi;
+    const jdf_function_entry_t *f;
     int idx = 0, need_profile = 0;
 
     sa1 = string_arena_new(64);
@@ -4671,11 +5282,22 @@ static void jdf_generate_constructor( const jdf_t* jdf )
             "  __parsec_tp->sync_point = __parsec_tp->super.super.nb_task_classes;\n"
             "  __parsec_tp->initial_number_tasks = 0;\n"
             "  __parsec_tp->startup_queue = NULL;\n"
+            "  __parsec_tp->startup_slices = 1;\n"
+            "  __parsec_tp->nb_startup_tasks = __parsec_tp->super.super.nb_task_classes;\n"
+            "  parsec_atomic_lock_init(&__parsec_tp->startup_lock);\n"
             "%s",
             jdf_basename, jdf_basename,
             string_arena_get_string(jdf->termdet_init_line),
             jdf_basename, jdf_basename,
             string_arena_get_string(sa1));
+    if( NULL != jdf->functions ) {
+        coutput("  memset(__parsec_tp->startup_slices_done, 0, sizeof(__parsec_tp->startup_slices_done));\n"
+                "  memset(__parsec_tp->startup_nb_tasks, 0, sizeof(__parsec_tp->startup_nb_tasks));\n");
+    }
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( jdf_function_has_lazy_dep_pages(f) )
+            coutput("  __parsec_tp->%s_page_nb_tasks = NULL;\n", f->fname);
+    }
 
     /* Prepare the functions */
     coutput("  for( i = 0; i < __parsec_tp->super.super.nb_task_classes; i++ ) {\n"
@@ -4775,15 +5397,44 @@ static void jdf_generate_constructor( const jdf_t* jdf )
     coutput("  __parsec_tp->super.super.repo_array = %s;\n",
             (NULL != jdf->functions) ? "__parsec_tp->repositories" : "NULL");
 
-    coutput("  __parsec_tp->super.super.startup_hook = (parsec_startup_fn_t)%s_startup;\n"
-            "  (void)parsec_taskpool_reserve_id((parsec_taskpool_t*)__parsec_tp);\n"
-            "}\n\n",
+    coutput("  __parsec_tp->super.super.startup_hook = (parsec_startup_fn_t)%s_startup;\n",
             jdf_basename);
+    if( JDF_COMPILER_GLOBAL_ARGS.direct_calls ) {
+        coutput("  __parsec_tp->super.super.task_dispatch = __parsec_%s_task_dispatch;\n",
+                jdf_basename);
+    }
+    coutput("  (void)parsec_taskpool_reserve_id((parsec_taskpool_t*)__parsec_tp);\n"
+            "}\n\n");
 
     string_arena_free(sa1);
     string_arena_free(sa2);
 }
 
+static void jdf_generate_estimate( const jdf_t *jdf )
+{
+    string_arena_t *sa = string_arena_new(64);
+    const jdf_function_entry_t *f;
+
+    coutput("int parsec_%s_estimate(parsec_%s_taskpool_t *tp, int nb_ranks, parsec_estimate_t *estimate)\n"
+            "{\n"
+            "  __parsec_%s_internal_taskpool_t *__parsec_tp = (__parsec_%s_internal_taskpool_t*)tp;\n"
+            "  parsec_sim_cost_fct_t *costs[PARSEC_%s_NB_TASK_CLASSES];\n",
+            jdf_basename, jdf_basename,
+            jdf_basename, jdf_basename,
+            jdf_basename);
+    jdf_generate_hoisted_bounds(jdf, sa);
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        if( NULL != f->simcost )
+            coutput("  costs[%d] = (parsec_sim_cost_fct_t*)simulation_cost_of_%s_%s;\n",
+                    f->task_class_id, jdf_basename, f->fname);
+        else
+            coutput("  costs[%d] = NULL;\n", f->task_class_id);
+    }
+    coutput("  return parsec_estimate_taskpool(&tp->super, nb_ranks, costs, estimate);\n"
+            "}\n\n");
+    string_arena_free(sa);
+}
+
 static void jdf_generate_new_function( const jdf_t* jdf )
 {
     string_arena_t *sa1,*sa2;
@@ -6445,6 +7096,17 @@ jdf_generate_code_time_estimate(const jdf_t *jdf,
         return;
     }
 
+    /* The mean duration measured by the profile, relative to the power of the device */
+    if( f->profile_duration > 0.0 ) {
+        coutput("static int64_t %s(const parsec_task_t *this_task, parsec_device_module_t *dev)\n"
+                "{\n"
+                "  (void)this_task;\n"
+                "  return (int64_t)(%.17g * dev->time_estimate_default);\n"
+                "}\n\n",
+                name, f->profile_duration);
+        return;
+    }
+
     sprintf(name, "NULL");
 }
 
@@ -7268,8 +7930,9 @@ static void jdf_generate_code_release_deps(const jdf_t *jdf, const jdf_function_
                     "      __parsec_tp->super.super.tdm.module->taskpool_addto_nb_tasks((parsec_taskpool_t*)__parsec_tp, __nb_tasks);\n"
                     "    }\n");
         }
-        coutput("    __parsec_schedule_vp(es, arg.ready_lists, 0);\n"
-                "  }\n");
+        coutput("    %s(es, arg.ready_lists, 0);\n"
+                "  }\n",
+                (f->flags & JDF_FUNCTION_FLAG_COARSENED) ? "__parsec_schedule_chained" : "__parsec_schedule_vp");
     } else {
         coutput("  /* No successors, don't call iterate_successors and don't release any local deps */\n");
     }
@@ -7300,6 +7963,49 @@ static void jdf_generate_code_release_deps(const jdf_t *jdf, const jdf_function_
         "\n");
 }
 
+/**
+ * Returns 1 if the process of the tasks of f depends neither on the local
+ * vl nor on the locals after it: all the tasks of a range of vl are then on
+ * the same process.
+ */
+static int jdf_rank_is_invariant_from(const jdf_function_entry_t *f,
+                                      const jdf_variable_list_t *vl)
+{
+    const jdf_expr_t *param;
+
+    for( ; NULL != vl; vl = vl->next )
+        for( param = f->predicate->parameters; NULL != param; param = param->next )
+            if( jdf_expr_may_use_local(vl->name, param) )
+                return 0;
+    return 1;
+}
+
+/**
+ * Dumps the computation of the process and of the virtual process of the
+ * task targetf being assigned.
+ */
+static void jdf_dump_rank_dst(string_arena_t *sa_open, string_arena_t *sa,
+                              const jdf_function_entry_t *targetf, expr_info_t *dest_info,
+                              const char *prefix, int nbopen)
+{
+    string_arena_add_string(sa_open,
+                            "#if defined(DISTRIBUTED)\n"
+                            "%s%s  rank_dst = rank_of_%s(%s);\n",
+                            prefix, indent(nbopen), targetf->predicate->func_or_mem,
+                            UTIL_DUMP_LIST(sa, targetf->predicate->parameters, next,
+                                           dump_expr, (void*)dest_info,
+                                           "", "", ", ", ""));
+    string_arena_add_string(sa_open,
+                            "%s%s  if( (NULL != es) && (rank_dst == es->virtual_process->parsec_context->my_rank) )\n"
+                            "#endif /* DISTRIBUTED */\n"
+                            "%s%s    vpid_dst = ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->vpid_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s, %s);\n",
+                            prefix, indent(nbopen),
+                            prefix, indent(nbopen), targetf->predicate->func_or_mem, targetf->predicate->func_or_mem,
+                            UTIL_DUMP_LIST(sa, targetf->predicate->parameters, next,
+                                           dump_expr, (void*)dest_info,
+                                           "", "", ", ", ""));
+}
+
 static char *jdf_dump_context_assignment(string_arena_t *sa_open,
                                          const jdf_t *jdf,
                                          const jdf_function_entry_t *sourcef,
@@ -7312,7 +8018,7 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
                                          const char *var)
 {
     expr_info_t local_info = EMPTY_EXPR_INFO, dest_info = EMPTY_EXPR_INFO;
-    int nbparam_given, nbparam_required, i, nbopen;
+    int nbparam_given, nbparam_required, i, nbopen, dense, rank_dumped = 0;
     const jdf_function_entry_t *targetf;
     string_arena_t *sa2, *sa1, *sa_close;
     jdf_variable_list_t *vl;
@@ -7483,18 +8189,58 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
                 }
             }
 
+            /* A dense range of a parameter with a range is clamped to this range, once
+             * for all its values, instead of checking each of them */
+            dense = (JDF_RANGE == el->op) && (JDF_RANGE == vl->expr->op) &&
+                JDF_OP_IS_CST(el->jdf_ta3->op) && (1 == el->jdf_ta3->jdf_cst);
             if( JDF_RANGE == el->op ) {
+                /* The process of the tasks does not change with the values of the range */
+                if( !rank_dumped && jdf_rank_is_invariant_from(targetf, vl) ) {
+                    jdf_dump_rank_dst(sa_open, sa2, targetf, &dest_info, prefix, nbopen);
+                    rank_dumped = 1;
+                }
                 string_arena_add_string(sa_open,
                                         "%s%s  int %s_%s;\n",
                                         prefix, indent(nbopen), targetf->fname, nl->name);
-
-                string_arena_add_string(sa_open,
-                                        "%s%sfor( %s_%s = %s;",
-                                        prefix, indent(nbopen), targetf->fname, nl->name, dump_expr((void**)el->jdf_ta1, &local_info));
-                string_arena_add_string(sa_open, "%s_%s <= %s; %s_%s+=",
-                                        targetf->fname, nl->name, dump_expr((void**)el->jdf_ta2, &local_info), targetf->fname, nl->name);
-                string_arena_add_string(sa_open, "%s) {\n",
-                                        dump_expr((void**)el->jdf_ta3, &local_info));
+                if( dense ) {
+                    string_arena_add_string(sa_open,
+                                            "%s%s  int %s_%s_first = %s;\n",
+                                            prefix, indent(nbopen), targetf->fname, nl->name,
+                                            dump_expr((void**)el->jdf_ta1, &local_info));
+                    string_arena_add_string(sa_open,
+                                            "%s%s  int %s_%s_last = %s;\n",
+                                            prefix, indent(nbopen), targetf->fname, nl->name,
+                                            dump_expr((void**)el->jdf_ta2, &local_info));
+                    string_arena_add_string(sa_open,
+                                            "%s%s  if( %s_%s_first < (%s) )",
+                                            prefix, indent(nbopen), targetf->fname, nl->name,
+                                            jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta1, &dest_info));
+                    string_arena_add_string(sa_open,
+                                            " %s_%s_first = (%s);\n",
+                                            targetf->fname, nl->name,
+                                            jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta1, &dest_info));
+                    string_arena_add_string(sa_open,
+                                            "%s%s  if( %s_%s_last > (%s) )",
+                                            prefix, indent(nbopen), targetf->fname, nl->name,
+                                            jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta2, &dest_info));
+                    string_arena_add_string(sa_open,
+                                            " %s_%s_last = (%s);\n",
+                                            targetf->fname, nl->name,
+                                            jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta2, &dest_info));
+                    string_arena_add_string(sa_open,
+                                            "%s%sfor( %s_%s = %s_%s_first; %s_%s <= %s_%s_last; %s_%s++ ) {\n",
+                                            prefix, indent(nbopen), targetf->fname, nl->name,
+                                            targetf->fname, nl->name, targetf->fname, nl->name,
+                                            targetf->fname, nl->name, targetf->fname, nl->name);
+                } else {
+                    string_arena_add_string(sa_open,
+                                            "%s%sfor( %s_%s = %s;",
+                                            prefix, indent(nbopen), targetf->fname, nl->name, dump_expr((void**)el->jdf_ta1, &local_info));
+                    string_arena_add_string(sa_open, "%s_%s <= %s; %s_%s+=",
+                                            targetf->fname, nl->name, dump_expr((void**)el->jdf_ta2, &local_info), targetf->fname, nl->name);
+                    string_arena_add_string(sa_open, "%s) {\n",
+                                            dump_expr((void**)el->jdf_ta3, &local_info));
+                }
                 nbopen++;
             } else {
                 string_arena_add_string(sa_open,
@@ -7502,15 +8248,17 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
                                         prefix, indent(nbopen), targetf->fname, nl->name, dump_expr((void**)el, &local_info));
             }
 
-            if( vl->expr->op == JDF_RANGE ) {
+            if( dense ) {
+                /* Already within the range */
+            } else if( vl->expr->op == JDF_RANGE ) {
                 /* This is a place where we consider iterators must be from low to high */
                 string_arena_add_string(sa_open,
                                         "%s%s  if( (%s_%s >= (%s))",
                                         prefix, indent(nbopen), targetf->fname, nl->name,
-                                        dump_expr((void**)vl->expr->jdf_ta1, &dest_info));
+                                        jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta1, &dest_info));
                 string_arena_add_string(sa_open, " && (%s_%s <= (%s)) ) {\n",
                                         targetf->fname, nl->name,
-                                        dump_expr((void**)vl->expr->jdf_ta2, &dest_info));
+                                        jdf_dump_param_bound(targetf, vl, vl->expr->jdf_ta2, &dest_info));
                 nbopen++;
             } else if( NULL != vl->expr->local_variables ) {
                 string_arena_add_string(sa_open, "%s%s  /* We cannot check if %s_%s is within the iterator space, because that space is defined with local indices. We need to trust */\n",
@@ -7532,22 +8280,8 @@ static char *jdf_dump_context_assignment(string_arena_t *sa_open,
         }
     }
 
-    string_arena_add_string(sa_open,
-                            "#if defined(DISTRIBUTED)\n"
-                            "%s%s  rank_dst = rank_of_%s(%s);\n",
-                            prefix, indent(nbopen), targetf->predicate->func_or_mem,
-                            UTIL_DUMP_LIST(sa2, targetf->predicate->parameters, next,
-                                           dump_expr, (void*)&dest_info,
-                                           "", "", ", ", ""));
-    string_arena_add_string(sa_open,
-                            "%s%s  if( (NULL != es) && (rank_dst == es->virtual_process->parsec_context->my_rank) )\n"
-                            "#endif /* DISTRIBUTED */\n"
-                            "%s%s    vpid_dst = ((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s)->vpid_of((parsec_data_collection_t*)"TASKPOOL_GLOBAL_PREFIX"_g_%s, %s);\n",
-                            prefix, indent(nbopen),
-                            prefix, indent(nbopen), targetf->predicate->func_or_mem, targetf->predicate->func_or_mem,
-                            UTIL_DUMP_LIST(sa2, targetf->predicate->parameters, next,
-                                           dump_expr, (void*)&dest_info,
-                                           "", "", ", ", ""));
+    if( !rank_dumped )
+        jdf_dump_rank_dst(sa_open, sa2, targetf, &dest_info, prefix, nbopen);
 
     if( NULL != targetf->priority ) {
         string_arena_add_string(sa_open,
@@ -7624,6 +8358,53 @@ static void jdf_check_relatives( jdf_function_entry_t *f, jdf_dep_flags_t flow_t
     f->flags |= flag;
 }
 
+static int jdf_call_is_single_task( const jdf_call_t *call )
+{
+    const jdf_expr_t *e;
+
+    if( NULL != call->local_defs ) return 0;
+    for( e = call->parameters; NULL != e; e = e->next )
+        if( JDF_RANGE == e->op ) return 0;
+    return 1;
+}
+
+/**
+ * Tag the function if its tasks have at most one input from another task:
+ * a single flow has inputs from other tasks, and it is either a data flow
+ * (whose inputs are mutually exclusive) or a control flow with a single
+ * input, none of them naming a range of tasks. These tasks are ready as
+ * soon as their predecessor releases them.
+ */
+static void jdf_check_single_input( jdf_function_entry_t *f )
+{
+    jdf_dataflow_t *fl;
+    jdf_dep_t *dl;
+    int nb_flows = 0, nb_deps;
+
+    for(fl = f->dataflow; fl != NULL; fl = fl->next) {
+        nb_deps = 0;
+        for(dl = fl->deps; dl != NULL; dl = dl->next) {
+            if( !(dl->dep_flags & JDF_DEP_FLOW_IN) ) continue;
+            if( JDF_IS_DEP_WRITE_ONLY_INPUT_TYPE(dl) ) continue;
+            if( (NULL == dl->guard->calltrue->var) &&
+                ((JDF_GUARD_TERNARY != dl->guard->guard_type) ||
+                 (NULL == dl->guard->callfalse->var)) )
+                continue;  /* from the memory only */
+            if( (NULL != dl->local_defs) ||
+                ((NULL != dl->guard->calltrue->var) && !jdf_call_is_single_task(dl->guard->calltrue)) ||
+                ((JDF_GUARD_TERNARY == dl->guard->guard_type) && (NULL != dl->guard->callfalse->var) &&
+                 !jdf_call_is_single_task(dl->guard->callfalse)) )
+                return;
+            nb_deps++;
+        }
+        if( 0 == nb_deps ) continue;
+        if( (++nb_flows > 1) || ((JDF_FLOW_TYPE_CTL & fl->flow_flags) && (nb_deps > 1)) )
+            return;
+    }
+    if( 1 == nb_flows )
+        f->flags |= JDF_FUNCTION_FLAG_SINGLE_INPUT;
+}
+
 #define OUTPUT_PREV_DEPS(MASK, SA_DATATYPE, SA_DEPS)                    \
     if( strlen(string_arena_get_string((SA_DEPS))) ) {                  \
         if( (JDF_DEP_FLOW_OUT & flow_type) && fl->flow_dep_mask_out == (MASK) ) { \
@@ -7645,6 +8426,146 @@ static void jdf_check_relatives( jdf_function_entry_t *f, jdf_dep_flags_t flow_t
         string_arena_init((SA_DATATYPE));                               \
     }
 
+/**
+ * The guards shared by several dependencies of a task class are evaluated at
+ * most once when iterating over its successors or predecessors: the first
+ * dependency needing one stores its value in a local variable, initialized
+ * to -1. Only the guards evaluated in the context of the task itself, without
+ * local definitions of the dependency, are shared.
+ */
+typedef struct jdf_shared_guards_s {
+    int    nb;
+    char **code;   /**< the C code of each distinct guard */
+    int   *uses;   /**< the number of dependencies evaluating it */
+} jdf_shared_guards_t;
+
+static int jdf_dep_guard_is_shareable(const jdf_dep_t *dl)
+{
+    if( JDF_GUARD_UNCONDITIONAL == dl->guard->guard_type ||
+        NULL != dl->local_defs || NULL != dl->guard->guard->local_variables )
+        return 0;
+    return (NULL != dl->guard->calltrue->var) ||
+        ((JDF_GUARD_TERNARY == dl->guard->guard_type) && (NULL != dl->guard->callfalse->var));
+}
+
+static void jdf_collect_shared_guards(const jdf_function_entry_t *f, jdf_dep_flags_t flow_type,
+                                      expr_info_t *info, jdf_shared_guards_t *guards)
+{
+    const jdf_dataflow_t *fl;
+    const jdf_dep_t *dl;
+    const char *code;
+    int i, nb_deps = 0;
+
+    for(fl = f->dataflow; fl != NULL; fl = fl->next)
+        for(dl = fl->deps; dl != NULL; dl = dl->next, nb_deps++) /* nothing */;
+    guards->nb   = 0;
+    guards->code = (char**)calloc(nb_deps + 1, sizeof(char*));
+    guards->uses = (int*)calloc(nb_deps + 1, sizeof(int));
+    for(fl = f->dataflow; fl != NULL; fl = fl->next) {
+        for(dl = fl->deps; dl != NULL; dl = dl->next) {
+            if( !(dl->dep_flags & flow_type) || JDF_IS_DEP_WRITE_ONLY_INPUT_TYPE(dl) ||
+                !jdf_dep_guard_is_shareable(dl) )
+                continue;
+            code = dump_expr((void**)dl->guard->guard, info);
+            for(i = 0; (i < guards->nb) && strcmp(guards->code[i], code); i++) /* nothing */;
+            if( i == guards->nb )
+                guards->code[guards->nb++] = strdup(code);
+            guards->uses[i]++;
+        }
+    }
+}
+
+static void jdf_free_shared_guards(jdf_shared_guards_t *guards)
+{
+    int i;
+    for(i = 0; i < guards->nb; i++)
+        free(guards->code[i]);
+    free(guards->code);
+    free(guards->uses);
+}
+
+/**
+ * Dumps the guard of a dependency, reading or setting its shared value if
+ * other dependencies evaluate the same guard.
+ */
+static const char *jdf_dump_guard(string_arena_t *sa, const jdf_dep_t *dl,
+                                  expr_info_t *info, const jdf_shared_guards_t *guards)
+{
+    const char *code = dump_expr((void**)dl->guard->guard, info);
+    int i;
+
+    if( !jdf_dep_guard_is_shareable(dl) )
+        return code;
+    for(i = 0; (i < guards->nb) && strcmp(guards->code[i], code); i++) /* nothing */;
+    if( (i == guards->nb) || (guards->uses[i] < 2) )
+        return code;
+    string_arena_init(sa);
+    string_arena_add_string(sa, "(-1 != "JDF2C_NAMESPACE"guard%d ? "JDF2C_NAMESPACE"guard%d : ("JDF2C_NAMESPACE"guard%d = !!(%s)))",
+                            i, i, i, code);
+    return string_arena_get_string(sa);
+}
+
+/**
+ * Returns true if the call targets a task class that never executed in the
+ * profile given to the compiler.
+ */
+static int jdf_call_is_cold(const jdf_t *jdf, const jdf_call_t *call)
+{
+    const jdf_function_entry_t *targetf;
+
+    if( (NULL == call) || (NULL == call->var) )
+        return 0;
+    targetf = find_target_function(jdf, call->func_or_mem);
+    return (NULL != targetf) && (targetf->flags & JDF_FUNCTION_FLAG_COLD);
+}
+
+/**
+ * Dumps the condition selecting the call of a guarded dependency, unlikely if
+ * the call goes to a task class that never executed in the profile, likely if
+ * only the other call of the guard does.
+ */
+static const char *jdf_dump_guard_hint(string_arena_t *sa, const jdf_t *jdf, const char *cond,
+                                       const jdf_call_t *call, const jdf_call_t *other)
+{
+    int cold = jdf_call_is_cold(jdf, call), other_cold = jdf_call_is_cold(jdf, other);
+
+    if( cold == other_cold )
+        return cond;
+    string_arena_init(sa);
+    string_arena_add_string(sa, "%s(%s)", cold ? JDF2C_NAMESPACE"unlikely" : JDF2C_NAMESPACE"likely", cond);
+    return string_arena_get_string(sa);
+}
+
+/**
+ * Dump the call to ontask for the dependency dep to the task or data call.
+ * With direct calls, the functions of the runtime passed by release_deps are
+ * called directly when they are the ontask: the release of the dependencies
+ * of a successor goes through the generated release_dep of its task class,
+ * which looks up and updates its dependencies directly.
+ */
+static void jdf_dump_ontask_call(string_arena_t *sa, const jdf_call_t *call, const char *dep)
+{
+    if( JDF_COMPILER_GLOBAL_ARGS.direct_calls && NULL != call->var ) {
+        string_arena_add_string(sa,
+                                "if( PARSEC_ITERATE_STOP == ((parsec_release_dep_fct == ontask) ?\n"
+                                "      release_dep_of_%s_%s(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
+                                " successor_repo, successor_repo_key, ontask_arg) :\n"
+                                "    (parsec_set_up_reshape_promise == ontask) ?\n"
+                                "      parsec_set_up_reshape_promise(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
+                                " successor_repo, successor_repo_key, ontask_arg) :\n"
+                                "      ontask(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
+                                " successor_repo, successor_repo_key, ontask_arg)) )\n"
+                                "  return;\n",
+                                jdf_basename, call->func_or_mem, dep, dep, dep);
+        return;
+    }
+    string_arena_add_string(sa,
+                            "if( PARSEC_ITERATE_STOP == ontask(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
+                            " successor_repo, successor_repo_key, ontask_arg) )\n"
+                            "  return;\n",
+                            dep);
+}
+
 static void
 jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
                                                      const jdf_function_entry_t *f,
@@ -7673,9 +8594,13 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
     string_arena_t *sa_tmp_type_r = string_arena_new(256);
     string_arena_t *sa_temp_r       = string_arena_new(1024);
 
+    string_arena_t *sa_guard      = string_arena_new(256);
+    string_arena_t *sa_hint       = string_arena_new(256);
+    jdf_shared_guards_t guards;
+
     assignment_info_t ai;
     expr_info_t info = EMPTY_EXPR_INFO;
-    int nb_open_ldef;
+    int nb_open_ldef, i;
 
     info.sa = sa2;
     info.prefix = "";
@@ -7708,6 +8633,12 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
             UTIL_DUMP_LIST_FIELD(sa1, f->locals, next, name,
                                  dump_string, NULL, "", "  (void)", ";", ";\n"));
 
+    jdf_collect_shared_guards(f, flow_type, &info, &guards);
+    for(i = 0; i < guards.nb; i++) {
+        if( guards.uses[i] > 1 )
+            coutput("  int "JDF2C_NAMESPACE"guard%d = -1;\n", i);
+    }
+
     coutput("  PARSEC_OBJ_CONSTRUCT(&nc, parsec_task_t);\n"
             "  nc.taskpool  = this_task->taskpool;\n"
             "  nc.priority  = this_task->priority;\n"
@@ -7851,11 +8782,7 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
             string_arena_add_string(sa_datatype,"  }\n");
 
             string_arena_init(sa_ontask);
-            string_arena_add_string(sa_ontask,
-                                    "if( PARSEC_ITERATE_STOP == ontask(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
-                                    " successor_repo, successor_repo_key, ontask_arg) )\n"
-                                    "  return;\n",
-                                    JDF_OBJECT_ONAME(dl->guard->calltrue));
+            jdf_dump_ontask_call(sa_ontask, dl->guard->calltrue, JDF_OBJECT_ONAME(dl->guard->calltrue));
 
             if( NULL != dl->local_defs ) {
                 jdf_expr_t *ld;
@@ -7910,7 +8837,8 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
                                             "    if( %s ) {\n"
                                             "%s"
                                             "    }\n",
-                                            dump_expr((void**)dl->guard->guard, &info),
+                                            jdf_dump_guard_hint(sa_hint, jdf, jdf_dump_guard(sa_guard, dl, &info, &guards),
+                                                                dl->guard->calltrue, NULL),
                                             jdf_dump_context_assignment(sa1, jdf, f, fl, string_arena_get_string(sa_ontask),
                                                                         dl->guard->calltrue, dl, JDF_OBJECT_LINENO(dl),
                                                                         "      ", "nc") );
@@ -7932,17 +8860,14 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
                                             "    if( %s ) {\n"
                                             "%s"
                                             "    }",
-                                            dump_expr((void**)dl->guard->guard, &info),
+                                            jdf_dump_guard_hint(sa_hint, jdf, jdf_dump_guard(sa_guard, dl, &info, &guards),
+                                                                dl->guard->calltrue, dl->guard->callfalse),
                                             jdf_dump_context_assignment(sa1, jdf, f, fl, string_arena_get_string(sa_ontask),
                                                                         dl->guard->calltrue, dl, JDF_OBJECT_LINENO(dl),
                                                                         "      ", "nc"));
 
                     string_arena_init(sa_ontask);
-                    string_arena_add_string(sa_ontask,
-                                            "if( PARSEC_ITERATE_STOP == ontask(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
-                                            " successor_repo, successor_repo_key, ontask_arg) )\n"
-                                            "  return;\n",
-                                            JDF_OBJECT_ONAME(dl->guard->callfalse));
+                    jdf_dump_ontask_call(sa_ontask, dl->guard->callfalse, JDF_OBJECT_ONAME(dl->guard->callfalse));
 
                     if( NULL != dl->guard->callfalse->var ) {
                         string_arena_add_string(sa_deps,
@@ -7958,19 +8883,18 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
                     }
                 } else {
                     string_arena_init(sa_ontask);
-                    string_arena_add_string(sa_ontask,
-                                            "if( PARSEC_ITERATE_STOP == ontask(es, &nc, (const parsec_task_t *)this_task, &%s, &data, rank_src, rank_dst, vpid_dst,"
-                                            " successor_repo, successor_repo_key, ontask_arg) )\n"
-                                            "  return;\n",
-                                            JDF_OBJECT_ONAME(dl->guard->callfalse));
+                    jdf_dump_ontask_call(sa_ontask, dl->guard->callfalse, JDF_OBJECT_ONAME(dl->guard->callfalse));
 
                     if( NULL != dl->guard->callfalse->var ) {
                         flowempty = 0;
+                        string_arena_init(sa_temp);
+                        string_arena_add_string(sa_temp, "!(%s)", jdf_dump_guard(sa_guard, dl, &info, &guards));
                         string_arena_add_string(sa_deps,
-                                                "    if( !(%s) ) {\n"
+                                                "    if( %s ) {\n"
                                                 "%s"
                                                 "    }\n",
-                                                dump_expr((void**)dl->guard->guard, &info),
+                                                jdf_dump_guard_hint(sa_hint, jdf, string_arena_get_string(sa_temp),
+                                                                    dl->guard->callfalse, NULL),
                                                 jdf_dump_context_assignment(sa1, jdf, f, fl, string_arena_get_string(sa_ontask),
                                                                             dl->guard->callfalse, dl, JDF_OBJECT_LINENO(dl),
                                                                             "      ", "nc") );
@@ -8028,6 +8952,9 @@ jdf_generate_code_iterate_successors_or_predecessors(const jdf_t *jdf,
     string_arena_free(sa_tmp_displ_r);
     string_arena_free(sa_tmp_type_r);
     string_arena_free(sa_temp_r);
+    string_arena_free(sa_guard);
+    string_arena_free(sa_hint);
+    jdf_free_shared_guards(&guards);
 
 }
 
@@ -8161,6 +9088,12 @@ static void jdf_generate_inline_c_functions(jdf_t* jdf)
         jdf_generate_inline_c_function(jdf->inline_c_functions);
 
     for(f = jdf->functions; NULL != f; f = f->next) {
+        /* The estimation of the taskpool also uses the simulation cost */
+        if( JDF_COMPILER_GLOBAL_ARGS.estimate && (NULL != f->simcost) &&
+            (NULL != f->simcost->protected_by) ) {
+            free(f->simcost->protected_by);
+            f->simcost->protected_by = NULL;
+        }
         for( le = f->inline_c_functions; NULL != le; le = le->next_inline ) {
             jdf_generate_inline_c_function(le);
         }
@@ -8281,6 +9214,8 @@ static void jdf_check_user_defined_internals(jdf_t *jdf)
                 var_to_c_code(expr);
             }
             f->user_defines |= JDF_FUNCTION_HAS_UD_DEPENDENCIES_FUNS;
+            /* The user-defined dependencies must be tracked */
+            f->flags &= ~JDF_FUNCTION_FLAG_SINGLE_INPUT;
         } else {
             if( JDF_COMPILER_GLOBAL_ARGS.dep_management == DEP_MANAGEMENT_INDEX_ARRAY ) {
                 (void)jdf_add_function_property(&f->properties, JDF_PROP_UD_FIND_DEPS_FN_NAME, "parsec_default_find_deps");
@@ -8331,6 +9266,38 @@ jdf_generate_code_find_deps(const jdf_t *jdf,
             TASKPOOL_GLOBAL_PREFIX);
 
     l2p = build_l2p(f);
+    if( jdf_function_has_lazy_dep_pages(f) ) {
+        /* The arrays of a page are allocated by the first of its tasks activated,
+         * and the other threads use the one they find, or the first one installed */
+        coutput("  const __parsec_%s_internal_taskpool_t *__parsec_itp = (const __parsec_%s_internal_taskpool_t*)__tp;\n"
+                "  parsec_dependencies_t *next;\n"
+                "  (void)__parsec_tp;\n",
+                jdf_basename, jdf_basename);
+        for(l2p_item = l2p; NULL != l2p_item->next; l2p_item = l2p_item->next) {
+            coutput("  next = deps->u.next[task->locals.%s.value - deps->min];\n"
+                    "  if( NULL == next ) {\n"
+                    "    ALLOCATE_DEP_TRACKING(next, __parsec_itp->%s_%s_min,\n"
+                    "                          __parsec_itp->%s_%s_min + __parsec_itp->%s_%s_range - 1,\n"
+                    "                          \"%s\", %s);\n"
+                    "    if( !parsec_atomic_cas_ptr(&deps->u.next[task->locals.%s.value - deps->min], NULL, next) ) {\n"
+                    "      free(next);\n"
+                    "      next = deps->u.next[task->locals.%s.value - deps->min];\n"
+                    "    }\n"
+                    "  }\n"
+                    "  deps = next;\n",
+                    l2p_item->pl->name,
+                    f->fname, l2p_item->next->pl->name,
+                    f->fname, l2p_item->next->pl->name, f->fname, l2p_item->next->pl->name,
+                    l2p_item->next->pl->name,
+                    NULL == l2p_item->next->next ? "PARSEC_DEPENDENCIES_FLAG_FINAL" : "PARSEC_DEPENDENCIES_FLAG_NEXT",
+                    l2p_item->pl->name, l2p_item->pl->name);
+        }
+        coutput("  return &(deps->u.dependencies[task->locals.%s.value - deps->min]);\n",
+                l2p_item->pl->name);
+        free_l2p(l2p);
+        coutput("}\n\n");
+        return;
+    }
     for(l2p_item = l2p; NULL != l2p_item->next; l2p_item = l2p_item->next) {
         coutput("  assert( (deps->flags & PARSEC_DEPENDENCIES_FLAG_NEXT) != 0 );\n");
         coutput("  deps = deps->u.next[task->locals.%s.value - deps->min];\n"
@@ -8344,6 +9311,137 @@ jdf_generate_code_find_deps(const jdf_t *jdf,
     (void)jdf;
 }
 
+static int jdf_expr_has_c_code(const jdf_expr_t *e)
+{
+    if( NULL == e ) return 0;
+    if( JDF_OP_IS_C_CODE(e->op) ) return 1;
+    if( JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) || JDF_OP_IS_VAR(e->op) ) return 0;
+    if( JDF_OP_IS_UNARY(e->op) ) return jdf_expr_has_c_code(e->jdf_ua);
+    if( JDF_OP_IS_TERNARY(e->op) || JDF_RANGE == e->op )
+        return jdf_expr_has_c_code(e->jdf_ta1) || jdf_expr_has_c_code(e->jdf_ta2) ||
+            jdf_expr_has_c_code(e->jdf_ta3);
+    return jdf_expr_has_c_code(e->jdf_ba1) || jdf_expr_has_c_code(e->jdf_ba2);
+}
+
+#define JDF_EXPR_IS_INT32_CST(e) (JDF_OP_IS_CST((e)->op) && (EXPR_TYPE_INT32 == (e)->jdf_type))
+
+/**
+ * Folds the operations on integer constants of an expression, and the
+ * ternaries with a constant condition, in place. The operations follow the
+ * C semantics, and are left to the C compiler when their result is not
+ * defined or does not fit in an int.
+ */
+static void jdf_fold_expr(jdf_expr_t *e)
+{
+    int64_t a, b, r;
+    jdf_expr_t *taken;
+
+    if( NULL == e || JDF_OP_IS_CST(e->op) || JDF_OP_IS_STRING(e->op) ||
+        JDF_OP_IS_VAR(e->op) || JDF_OP_IS_C_CODE(e->op) )
+        return;
+    if( JDF_OP_IS_UNARY(e->op) ) {
+        jdf_fold_expr(e->jdf_ua);
+        if( !JDF_EXPR_IS_INT32_CST(e->jdf_ua) ) return;
+        r = !e->jdf_ua->jdf_cst;
+        goto fold;
+    }
+    if( JDF_OP_IS_TERNARY(e->op) || JDF_RANGE == e->op ) {
+        jdf_fold_expr(e->jdf_tat);
+        jdf_fold_expr(e->jdf_ta1);
+        jdf_fold_expr(e->jdf_ta2);
+        if( JDF_RANGE == e->op || !JDF_EXPR_IS_INT32_CST(e->jdf_tat) ) return;
+        taken = e->jdf_tat->jdf_cst ? e->jdf_ta1 : e->jdf_ta2;
+        /* The inline C functions and the local definitions are bound to their own expression */
+        if( NULL != taken->alias || NULL != taken->local_variables || jdf_expr_has_c_code(taken) )
+            return;
+        e->op = taken->op;
+        e->u  = taken->u;
+        return;
+    }
+    jdf_fold_expr(e->jdf_ba1);
+    jdf_fold_expr(e->jdf_ba2);
+    if( !JDF_EXPR_IS_INT32_CST(e->jdf_ba1) || !JDF_EXPR_IS_INT32_CST(e->jdf_ba2) )
+        return;
+    a = e->jdf_ba1->jdf_cst;
+    b = e->jdf_ba2->jdf_cst;
+    switch( e->op ) {
+    case JDF_EQUAL:    r = (a == b); break;
+    case JDF_NOTEQUAL: r = (a != b); break;
+    case JDF_AND:      r = (a && b); break;
+    case JDF_OR:       r = (a || b); break;
+    case JDF_XOR:      r = (a ^ b);  break;
+    case JDF_LESS:     r = (a < b);  break;
+    case JDF_LEQ:      r = (a <= b); break;
+    case JDF_MORE:     r = (a > b);  break;
+    case JDF_MEQ:      r = (a >= b); break;
+    case JDF_PLUS:     r = a + b;    break;
+    case JDF_MINUS:    r = a - b;    break;
+    case JDF_TIMES:    r = a * b;    break;
+    case JDF_DIV:
+        if( 0 == b ) return;
+        r = a / b; break;
+    case JDF_MODULO:
+        if( 0 == b ) return;
+        r = a % b; break;
+    case JDF_SHL:
+        if( a < 0 || b < 0 || b > 30 ) return;
+        r = a << b; break;
+    case JDF_SHR:
+        if( b < 0 || b > 30 ) return;
+        r = a >> b; break;
+    default:
+        return;
+    }
+  fold:
+    if( r < INT32_MIN || r > INT32_MAX )
+        return;
+    e->op = JDF_CST;
+    e->jdf_type = EXPR_TYPE_INT32;
+    e->jdf_cst = (int32_t)r;
+}
+
+static void jdf_fold_expr_list(jdf_expr_t *e)
+{
+    for( ; NULL != e; e = e->next )
+        jdf_fold_expr(e);
+}
+
+static void jdf_fold_datatype(jdf_datatransfer_type_t *dt)
+{
+    jdf_fold_expr(dt->count);
+    jdf_fold_expr(dt->displ);
+}
+
+/**
+ * Folds the constant expressions of a task class: the ranges of its locals,
+ * its affinity, priority, and the guards, parameters and datatypes of its
+ * dependencies. The generated code evaluates less, and the analyses looking
+ * for constant expressions find more of them.
+ */
+static void jdf_fold_function_exprs(jdf_function_entry_t *f)
+{
+    jdf_variable_list_t *vl;
+    jdf_dataflow_t *fl;
+    jdf_dep_t *dl;
+
+    for( vl = f->locals; NULL != vl; vl = vl->next )
+        jdf_fold_expr(vl->expr);
+    if( NULL != f->predicate )
+        jdf_fold_expr_list(f->predicate->parameters);
+    jdf_fold_expr(f->priority);
+    for( fl = f->dataflow; NULL != fl; fl = fl->next ) {
+        for( dl = fl->deps; NULL != dl; dl = dl->next ) {
+            jdf_fold_expr(dl->guard->guard);
+            jdf_fold_expr_list(dl->guard->calltrue->parameters);
+            if( NULL != dl->guard->callfalse )
+                jdf_fold_expr_list(dl->guard->callfalse->parameters);
+            jdf_fold_datatype(&dl->datatype_local);
+            jdf_fold_datatype(&dl->datatype_remote);
+            jdf_fold_datatype(&dl->datatype_data);
+        }
+    }
+}
+
 /**
  * Analyze the code to optimize the output
  */
@@ -8362,14 +9460,20 @@ int jdf_optimize( jdf_t* jdf )
      * potential startup.
      */
     for(i = 0, f = jdf->functions; NULL != f; f = f->next, i++) {
+        jdf_fold_function_exprs(f);
         /* Check if the function has the HIGH_PRIORITY property on */
         high_priority = jdf_property_get_int(f->properties, "high_priority", 0);
         if( high_priority ) {
             f->flags |= JDF_FUNCTION_FLAG_HIGH_PRIORITY;
         }
+        /* The ready local successors of the coarsened tasks are executed right after them */
+        if( jdf_property_get_int(f->properties, "coarsen", 0) ) {
+            f->flags |= JDF_FUNCTION_FLAG_COARSENED;
+        }
         /* Check if the function has any successors and predecessors */
         jdf_check_relatives(f, JDF_DEP_FLOW_OUT, JDF_FUNCTION_FLAG_NO_SUCCESSORS);
         jdf_check_relatives(f, JDF_DEP_FLOW_IN, JDF_FUNCTION_FLAG_NO_PREDECESSORS);
+        jdf_check_single_input(f);
 
         can_be_startup = 1;
         UTIL_DUMP_LIST(sa, f->dataflow, next, has_ready_input_dependency, &can_be_startup, "", "", "", "");
@@ -8430,6 +9534,71 @@ int jdf_force_termdet_dynamic(jdf_t* jdf)
     return rc;
 }
 
+/**
+ * Apply the profile of a previous run to the task classes: each line of the
+ * profile is '<task class> <executions> <mean duration>', the task class being
+ * named either by its name or by '<basename>::<name>' as in the traces, and the
+ * lines of the task classes of other taskpools are ignored. A task class
+ * missing from the profile never executed.
+ */
+int jdf_apply_profile(jdf_t* jdf, const char *filename, const char *_basename)
+{
+    jdf_function_entry_t *f;
+    char line[1024], name[256], *fname;
+    long long executions;
+    double duration;
+    int lineno = 0, matched = 0;
+    size_t len = strlen(_basename);
+    FILE *fp;
+
+    fp = fopen(filename, "r");
+    if( NULL == fp ) {
+        fprintf(stderr, "unable to open profile %s: %s\n", filename, strerror(errno));
+        return -1;
+    }
+    for( f = jdf->functions; NULL != f; f = f->next ) {
+        f->flags |= JDF_FUNCTION_FLAG_COLD;
+    }
+    while( NULL != fgets(line, sizeof(line), fp) ) {
+        lineno++;
+        if( (1 != sscanf(line, " %1[^#]", name)) )
+            continue;  /* empty line or comment */
+        if( (3 != sscanf(line, "%255s %lld %lf", name, &executions, &duration)) ||
+            (executions < 0) || (duration < 0.0) ) {
+            fprintf(stderr, "%s:%d: expected '<task class> <executions> <mean duration>'\n",
+                    filename, lineno);
+            fclose(fp);
+            return -1;
+        }
+        fname = strstr(name, "::");
+        if( NULL != fname ) {
+            if( (len != (size_t)(fname - name)) || strncmp(name, _basename, len) )
+                continue;  /* a task class of another taskpool */
+            fname += 2;
+        } else {
+            fname = name;
+        }
+        for( f = jdf->functions; (NULL != f) && strcmp(f->fname, fname); f = f->next ) /* nothing */;
+        if( NULL == f )
+            continue;
+        matched++;
+        if( 0 == executions )
+            continue;
+        f->flags &= ~JDF_FUNCTION_FLAG_COLD;
+        f->profile_duration = duration;
+    }
+    fclose(fp);
+
+    if( 0 == matched ) {
+        fprintf(stderr, "Warning: the profile %s has no task class of %s, it is ignored\n",
+                filename, _basename);
+        for( f = jdf->functions; NULL != f; f = f->next ) {
+            f->flags &= ~JDF_FUNCTION_FLAG_COLD;
+        }
+    }
+    return 0;
+}
+
 /** Main Function */
 
 #if defined(PARSEC_HAVE_INDENT) && !(defined(__WINDOWS__) || defined(__MING64__) || defined(__CYGWIN__))
@@ -8565,7 +9734,11 @@ int jdf2c(const char *output_c, const char *output_h, const char *_jdf_basename,
     jdf_generate_inline_c_functions(jdf);
     jdf_generate_makekey_and_hashstruct(jdf);
     jdf_generate_priority_prototypes(jdf);
+    if( JDF_COMPILER_GLOBAL_ARGS.direct_calls )
+        jdf_generate_release_dep_prototypes(jdf);
     jdf_generate_functions_statics(jdf); // PETER generates startup tasks
+    if( JDF_COMPILER_GLOBAL_ARGS.direct_calls )
+        jdf_generate_task_dispatch(jdf);
     jdf_generate_startup_hook(jdf);
 
     /**
@@ -8581,6 +9754,8 @@ int jdf2c(const char *output_c, const char *output_h, const char *_jdf_basename,
             jdf_basename, jdf_basename,
             jdf_basename, jdf_basename);
 
+    if( JDF_COMPILER_GLOBAL_ARGS.estimate )
+        jdf_generate_estimate(jdf);
     jdf_generate_new_function(jdf);
 
     free_name_placeholders();
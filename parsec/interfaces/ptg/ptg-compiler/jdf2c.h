@@ -12,6 +12,8 @@ int jdf_optimize( jdf_t* jdf );
 
 int jdf_force_termdet_dynamic(jdf_t* jdf);
 
+int jdf_apply_profile(jdf_t* jdf, const char *filename, const char *_basename);
+
 int jdf2c(const char *output_c, const char *output_h, const char *_basename, jdf_t *jdf);
 
 #endif  /* _jdf2c_h */
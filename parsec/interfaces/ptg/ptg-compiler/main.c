@@ -92,6 +92,25 @@ static void usage(void)
             "                     in the source code (default don't)\n"
             "  --ignore-property  List (comma separated) of properties to ignore in the JDF\n"
             "                     (default none)\n"
+            "  --direct-calls     Execute the tasks and update the dependencies of their\n"
+            "                     successors through direct calls to the generated functions\n"
+            "                     instead of the function pointers of the task classes\n"
+            "                     (default don't)\n"
+            "  --estimate         Generate parsec_<name>_estimate, estimating the tasks, the\n"
+            "                     communications and the critical path of a taskpool on a\n"
+            "                     number of processes without executing it (default don't)\n"
+            "  --profile=FILE     Guide the generated code with the profile of a previous run:\n"
+            "                     lines '<task class> <executions> <mean duration in ns>', as\n"
+            "                     produced by the ptgpp_profile.py profiling tool. The guards\n"
+            "                     leading to task classes that never executed are marked\n"
+            "                     unlikely, and the task classes without time_estimate get\n"
+            "                     one from their mean duration (default none)\n"
+            "  --lazy-dep-pages   With the index-array dependencies tracking, allocate the\n"
+            "                     dependencies of the tasks of a task class for each value of\n"
+            "                     its first parameter (a page) when the first of them is\n"
+            "                     activated, and release them when the last local task of the\n"
+            "                     page completes. The local tasks of each page are still\n"
+            "                     counted at startup (default don't)\n"
             "\n",
             DEFAULTS.input,
             DEFAULTS.output_c,
@@ -195,6 +214,10 @@ static void parse_args(int argc, char *argv[])
         { "force-profile", no_argument,             NULL,   2  },
         { "ignore-properties", required_argument,   NULL,  'I' },
         { "dynamic-termdet", no_argument,           NULL,  'D' },
+        { "direct-calls",  no_argument,             NULL,   3  },
+        { "estimate",      no_argument,             NULL,   4  },
+        { "profile",       required_argument,       NULL,   5  },
+        { "lazy-dep-pages", no_argument,            NULL,   6  },
         { NULL,            0,                       NULL,   0  }
     };
 
@@ -251,6 +274,20 @@ static void parse_args(int argc, char *argv[])
         case 2:
             add_to_ignore_properties("profile");
             break;
+        case 3:
+            JDF_COMPILER_GLOBAL_ARGS.direct_calls = 1;
+            break;
+        case 4:
+            JDF_COMPILER_GLOBAL_ARGS.estimate = 1;
+            break;
+        case 5:
+            if( NULL != JDF_COMPILER_GLOBAL_ARGS.profile )
+                free(JDF_COMPILER_GLOBAL_ARGS.profile);
+            JDF_COMPILER_GLOBAL_ARGS.profile = strdup(optarg);
+            break;
+        case 6:
+            JDF_COMPILER_GLOBAL_ARGS.lazy_dep_pages = 1;
+            break;
         case 'E':
             /* Don't compile the preprocessed file, instead stop after the preprocessing stage */
             JDF_COMPILER_GLOBAL_ARGS.compile = 0;
@@ -431,6 +468,14 @@ int main(int argc, char *argv[])
     /* Lets try to optimize the jdf */
     jdf_optimize( &current_jdf );
 
+    if( NULL != JDF_COMPILER_GLOBAL_ARGS.profile ) {
+        rc = jdf_apply_profile(&current_jdf, JDF_COMPILER_GLOBAL_ARGS.profile,
+                               JDF_COMPILER_GLOBAL_ARGS.funcid);
+        if(rc != 0) {
+            return 1;
+        }
+    }
+
     if( jdf2c(JDF_COMPILER_GLOBAL_ARGS.output_c,
               JDF_COMPILER_GLOBAL_ARGS.output_h,
               JDF_COMPILER_GLOBAL_ARGS.funcid,
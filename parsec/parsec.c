@@ -74,6 +74,7 @@ const char* parsec_hostname = parsec_hostname_array;
 
 size_t parsec_task_startup_iter = 64;
 size_t parsec_task_startup_chunk = 256;
+size_t parsec_task_startup_slices = 0;
 
 parsec_data_allocate_t parsec_data_allocate = malloc;
 parsec_data_free_t     parsec_data_free = free;
@@ -177,6 +178,7 @@ static void __parsec_taskpool_constructor(parsec_taskpool_t* tp)
     tp->nb_pending_actions = 0;
     tp->context = NULL;  /* not atached to any context */
     tp->startup_hook = NULL;
+    tp->task_dispatch = NULL;
     tp->task_classes_array = NULL;
     tp->on_enqueue = NULL;
     tp->on_enqueue_data = NULL;
@@ -671,6 +673,10 @@ parsec_context_t* parsec_init( int nb_cores, int* pargc, char** pargv[] )
                                    "before delaying the remaining of the startup. The startup process will be "
                                    "continued at a later moment once the number of ready tasks decreases.",
                                    false, false, parsec_task_startup_chunk, &parsec_task_startup_chunk);
+    parsec_mca_param_reg_sizet_name("task", "startup_slices", "The number of startup tasks enumerating in parallel the "
+                                   "execution space of each task class whose outermost parameter is a plain range "
+                                   "(0 for one per execution stream).",
+                                   false, false, parsec_task_startup_slices, &parsec_task_startup_slices);
 
     parsec_mca_param_reg_string_name("profile", "filename",
 #if defined(PARSEC_PROF_TRACE)
@@ -1661,8 +1667,13 @@ void parsec_dependencies_mark_task_as_startup(parsec_task_t* PARSEC_RESTRICT tas
 {
     const parsec_task_class_t* tc = task->task_class;
     parsec_taskpool_t *tp = task->taskpool;
-    parsec_dependency_t *deps = tc->find_deps(tp, es, task);
+    parsec_dependency_t *deps;
 
+    if( tc->flags & PARSEC_SINGLE_INPUT_TASK ) {
+        /* The dependencies of these tasks are not tracked */
+        return;
+    }
+    deps = tc->find_deps(tp, es, task);
     if( tc->flags & PARSEC_USE_DEPS_MASK ) {
         *deps = PARSEC_DEPENDENCIES_STARTUP_TASK | tc->dependencies_goal;
     } else {
@@ -1673,32 +1684,41 @@ void parsec_dependencies_mark_task_as_startup(parsec_task_t* PARSEC_RESTRICT tas
 /*
  * Release the OUT dependencies for a single instance of a task. No ranges are
  * supported and the task is supposed to be valid (no input/output tasks) and
- * local.
+ * local. If completed is -1 the dependencies of the task are looked up and
+ * updated through its task class, otherwise the caller already updated them
+ * and completed tells if the task is ready.
  */
-int
-parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
-                                      const parsec_task_t* PARSEC_RESTRICT origin,
-                                      const parsec_flow_t* PARSEC_RESTRICT origin_flow,
-                                      const parsec_task_t* PARSEC_RESTRICT task,
-                                      const parsec_flow_t* PARSEC_RESTRICT dest_flow,
-                                      parsec_dep_data_description_t* data,
-                                      parsec_task_t** pready_ring,
-                                      data_repo_t* target_repo,
-                                      parsec_data_copy_t* target_dc,
-                                      data_repo_entry_t* target_repo_entry)
+static inline int
+parsec_release_local_OUT_dependencies_completed(parsec_execution_stream_t* es,
+                                                const parsec_task_t* PARSEC_RESTRICT origin,
+                                                const parsec_flow_t* PARSEC_RESTRICT origin_flow,
+                                                const parsec_task_t* PARSEC_RESTRICT task,
+                                                const parsec_flow_t* PARSEC_RESTRICT dest_flow,
+                                                parsec_dep_data_description_t* data,
+                                                parsec_task_t** pready_ring,
+                                                data_repo_t* target_repo,
+                                                parsec_data_copy_t* target_dc,
+                                                data_repo_entry_t* target_repo_entry,
+                                                int completed)
 {
     const parsec_task_class_t* tc = task->task_class;
-    parsec_dependency_t *deps;
-    int completed;
+    parsec_dependency_t *deps = NULL;
 #if defined(PARSEC_DEBUG_NOISIER)
     char tmp1[MAX_TASK_STRLEN], tmp2[MAX_TASK_STRLEN];
     parsec_task_snprintf(tmp1, MAX_TASK_STRLEN, task);
 #endif
 
     PARSEC_DEBUG_VERBOSE(10, parsec_debug_output, "Activate dependencies for %s flags = 0x%04x", tmp1, tc->flags);
-    deps = tc->find_deps(origin->taskpool, es, task);
-
-    completed = tc->update_deps(origin->taskpool, task, deps, origin, origin_flow, dest_flow);
+    if( -1 != completed ) {
+        /* The dependencies have been updated by the caller */
+    } else if( tc->flags & PARSEC_SINGLE_INPUT_TASK ) {
+        /* The origin is the only predecessor of the task: it is ready, without
+         * looking up and updating its dependencies */
+        completed = 1;
+    } else {
+        deps = tc->find_deps(origin->taskpool, es, task);
+        completed = tc->update_deps(origin->taskpool, task, deps, origin, origin_flow, dest_flow);
+    }
 
 #if defined(PARSEC_PROF_GRAPHER)
     parsec_prof_grapher_dep(origin, task, completed, origin_flow, dest_flow);
@@ -1720,7 +1740,7 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                    tmp1,
                    parsec_task_snprintf(tmp2, MAX_TASK_STRLEN, origin),
                    es->th_id, es->virtual_process->vp_id,
-                   *deps);
+                   (NULL != deps) ? *deps : 0);
 
             assert( dest_flow->flow_index <= new_context->task_class->nb_flows);
             memset( new_context->data, 0, sizeof(parsec_data_pair_t) * new_context->task_class->nb_flows);
@@ -1762,15 +1782,32 @@ parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
     return PARSEC_SUCCESS;
 }
 
-parsec_ontask_iterate_t
-parsec_release_dep_fct(parsec_execution_stream_t *es,
-                      const parsec_task_t *newcontext,
-                      const parsec_task_t *oldcontext,
-                      const parsec_dep_t* dep,
-                      parsec_dep_data_description_t* data,
-                      int src_rank, int dst_rank, int dst_vpid,
-                      data_repo_t *successor_repo, parsec_key_t successor_repo_key,
-                      void *param)
+int
+parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
+                                      const parsec_task_t* PARSEC_RESTRICT origin,
+                                      const parsec_flow_t* PARSEC_RESTRICT origin_flow,
+                                      const parsec_task_t* PARSEC_RESTRICT task,
+                                      const parsec_flow_t* PARSEC_RESTRICT dest_flow,
+                                      parsec_dep_data_description_t* data,
+                                      parsec_task_t** pready_ring,
+                                      data_repo_t* target_repo,
+                                      parsec_data_copy_t* target_dc,
+                                      data_repo_entry_t* target_repo_entry)
+{
+    return parsec_release_local_OUT_dependencies_completed(es, origin, origin_flow, task, dest_flow, data,
+                                                           pready_ring, target_repo, target_dc,
+                                                           target_repo_entry, -1);
+}
+
+static inline parsec_ontask_iterate_t
+parsec_release_dep_completed(parsec_execution_stream_t *es,
+                             const parsec_task_t *newcontext,
+                             const parsec_task_t *oldcontext,
+                             const parsec_dep_t* dep,
+                             parsec_dep_data_description_t* data,
+                             int src_rank, int dst_rank, int dst_vpid,
+                             data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                             void *param, int completed)
 {
     parsec_release_dep_fct_arg_t *arg = (parsec_release_dep_fct_arg_t *)param;
     const parsec_flow_t* src_flow = dep->belongs_to;
@@ -1890,19 +1927,50 @@ parsec_release_dep_fct(parsec_execution_stream_t *es,
          * We are doing this in order for dtd to be able to track control dependences.
          * Usage count of the repo is dealt with when setting up reshape promises.
          */
-        parsec_release_local_OUT_dependencies(es,
-                                              oldcontext,
-                                              src_flow,
-                                              newcontext,
-                                              dep->flow,
-                                              data,
-                                              &arg->ready_lists[dst_vpid],
-                                              target_repo, target_dc, target_repo_entry);
+        parsec_release_local_OUT_dependencies_completed(es,
+                                                        oldcontext,
+                                                        src_flow,
+                                                        newcontext,
+                                                        dep->flow,
+                                                        data,
+                                                        &arg->ready_lists[dst_vpid],
+                                                        target_repo, target_dc, target_repo_entry,
+                                                        completed);
     }
 
     return PARSEC_ITERATE_CONTINUE;
 }
 
+parsec_ontask_iterate_t
+parsec_release_dep_fct(parsec_execution_stream_t *es,
+                      const parsec_task_t *newcontext,
+                      const parsec_task_t *oldcontext,
+                      const parsec_dep_t* dep,
+                      parsec_dep_data_description_t* data,
+                      int src_rank, int dst_rank, int dst_vpid,
+                      data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                      void *param)
+{
+    return parsec_release_dep_completed(es, newcontext, oldcontext, dep, data,
+                                        src_rank, dst_rank, dst_vpid,
+                                        successor_repo, successor_repo_key, param, -1);
+}
+
+parsec_ontask_iterate_t
+parsec_release_dep_completed_fct(parsec_execution_stream_t *es,
+                                 const parsec_task_t *newcontext,
+                                 const parsec_task_t *oldcontext,
+                                 const parsec_dep_t* dep,
+                                 parsec_dep_data_description_t* data,
+                                 int src_rank, int dst_rank, int dst_vpid,
+                                 data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                                 void *param, int completed)
+{
+    return parsec_release_dep_completed(es, newcontext, oldcontext, dep, data,
+                                        src_rank, dst_rank, dst_vpid,
+                                        successor_repo, successor_repo_key, param, completed);
+}
+
 /*
  * Convert the execution context to a string.
  */
@@ -2497,8 +2565,8 @@ static int32_t parsec_expr_eval32(const parsec_expr_t *expr, parsec_task_t *cont
     return expr->inline_func32(tp, context->locals);
 }
 
-static int parsec_debug_enumerate_next_in_execution_space(parsec_task_t *context,
-                                                         int init, int li)
+int parsec_debug_enumerate_next_in_execution_space(parsec_task_t *context,
+                                                  int init, int li)
 {
     const parsec_task_class_t *tc = context->task_class;
     int cur, max, incr, min;
@@ -2593,7 +2661,7 @@ parsec_debug_taskpool_count_local_tasks( parsec_taskpool_t *tp,
         tc->data_affinity(&task, &ref);
         if( ref.dc->rank_of_key(ref.dc, ref.key) == ref.dc->myrank ) {
             (*nlocal)++;
-            dep = tc->find_deps(tp, NULL, &task);
+            dep = (tc->flags & PARSEC_SINGLE_INPUT_TASK) ? NULL : tc->find_deps(tp, NULL, &task);
             if( NULL == dep ) {
                 parsec_debug_verbose(0, parsec_debug_output,
                                      "  Task %s uses a dependency lookup mechanism that does not allow it to remember executed / waiting / ready tasks\n",
@@ -2811,6 +2879,15 @@ int parsec_context_query(parsec_context_t *context, parsec_context_query_cmd_t c
 
         case PARSEC_CONTEXT_QUERY_ACTIVE_TASKPOOLS:
             return context->active_taskpools;
+
+        case PARSEC_CONTEXT_QUERY_COMM_STATS:
+            {
+                int peer = va_arg(args, int);
+                parsec_comm_stats_t* stats = va_arg(args, parsec_comm_stats_t*);
+                if( (peer < -1) || (peer >= context->nb_nodes) || (NULL == stats) )
+                    return PARSEC_ERR_BAD_PARAM;
+                return parsec_remote_dep_get_stats(peer, stats);
+            }
         /* no default */
     }
     return PARSEC_ERR_NOT_SUPPORTED;  /* unknown command */
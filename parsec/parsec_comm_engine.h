@@ -196,6 +196,9 @@ struct parsec_comm_engine_s {
     parsec_ce_sync_fn_t                    sync;
     parsec_ce_can_serve_fn_t               can_serve;
     parsec_ce_send_active_message_fn_t     send_am;
+    int                                   *rank_to_node; /**< for each rank, an identifier of the node hosting it
+                                                              (ranks sharing memory share the same identifier),
+                                                              or NULL if the locality is unknown */
 };
 
 /* global comm_engine */
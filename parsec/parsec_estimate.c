@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2024      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#include "parsec/parsec_config.h"
+#include "parsec/parsec_internal.h"
+#include "parsec/parsec_estimate.h"
+
+#include "parsec/arena.h"
+#include "parsec/datatype.h"
+#include "parsec/remote_dep.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_distribution.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A task of the estimated taskpool. The tasks are stored in the order of
+ * their enumeration, and found back from their locals with an open
+ * addressing table of their indexes.
+ */
+typedef struct estimate_task_s {
+    const parsec_task_class_t *tc;
+    parsec_assignment_t        locals[MAX_LOCAL_COUNT];
+    int                        rank;
+    int                        nb_preds;  /**< Predecessors not yet on the critical path */
+    int64_t                    cost;
+    int64_t                    start;     /**< Cost of the longest chain before the task */
+    int64_t                    nb_chain_tasks; /**< Number of tasks on this chain */
+} estimate_task_t;
+
+typedef struct estimate_state_s {
+    parsec_estimate_t *estimate;
+    estimate_task_t   *tasks;
+    int64_t            nb_tasks;
+    int64_t            size;
+    int64_t           *index;        /**< Table of task indexes, -1 when empty */
+    int64_t            index_size;   /**< Power of 2 */
+    int64_t            current;      /**< Task whose successors are iterated */
+    int64_t           *sent_task;    /**< Last task sending to each process */
+    uint64_t          *sent_outputs; /**< Outputs of this task sent to each process */
+    int64_t           *ready;        /**< Tasks whose predecessors are all on the critical path */
+    int64_t            nb_ready;
+} estimate_state_t;
+
+static uint64_t estimate_task_hash(const parsec_task_class_t *tc,
+                                   const parsec_assignment_t *locals)
+{
+    uint64_t h = 0xcbf29ce484222325ULL ^ tc->task_class_id;
+    int i;
+
+    for( i = 0; i < tc->nb_parameters; i++ ) {
+        h ^= (uint32_t)locals[tc->params[i]->context_index].value;
+        h *= 0x100000001b3ULL;
+    }
+    return h ^ (h >> 32);
+}
+
+static int estimate_task_match(const estimate_task_t *task,
+                               const parsec_task_class_t *tc,
+                               const parsec_assignment_t *locals)
+{
+    int i, li;
+
+    if( task->tc != tc ) return 0;
+    for( i = 0; i < tc->nb_parameters; i++ ) {
+        li = tc->params[i]->context_index;
+        if( task->locals[li].value != locals[li].value ) return 0;
+    }
+    return 1;
+}
+
+static int64_t estimate_find(const estimate_state_t *state,
+                             const parsec_task_class_t *tc,
+                             const parsec_assignment_t *locals)
+{
+    int64_t mask = state->index_size - 1, i;
+
+    for( i = (int64_t)(estimate_task_hash(tc, locals) & mask);
+         -1 != state->index[i]; i = (i + 1) & mask ) {
+        if( estimate_task_match(&state->tasks[state->index[i]], tc, locals) )
+            return state->index[i];
+    }
+    return -1;
+}
+
+static void estimate_index_insert(estimate_state_t *state, int64_t t)
+{
+    int64_t mask = state->index_size - 1, i;
+
+    i = (int64_t)(estimate_task_hash(state->tasks[t].tc, state->tasks[t].locals) & mask);
+    while( -1 != state->index[i] ) i = (i + 1) & mask;
+    state->index[i] = t;
+}
+
+static int estimate_add_task(estimate_state_t *state, const parsec_task_t *task,
+                             int rank, int64_t cost)
+{
+    estimate_task_t *t;
+    int64_t i;
+
+    if( state->nb_tasks == state->size ) {
+        state->size = 2 * state->size + 1024;
+        t = (estimate_task_t*)realloc(state->tasks, state->size * sizeof(estimate_task_t));
+        if( NULL == t ) return PARSEC_ERR_OUT_OF_RESOURCE;
+        state->tasks = t;
+    }
+    /* Keep the table at most half full */
+    if( 2 * (state->nb_tasks + 1) > state->index_size ) {
+        free(state->index);
+        state->index_size = (0 == state->index_size) ? 2048 : 2 * state->index_size;
+        state->index = (int64_t*)malloc(state->index_size * sizeof(int64_t));
+        if( NULL == state->index ) return PARSEC_ERR_OUT_OF_RESOURCE;
+        memset(state->index, -1, state->index_size * sizeof(int64_t));
+        for( i = 0; i < state->nb_tasks; i++ )
+            estimate_index_insert(state, i);
+    }
+    t = &state->tasks[state->nb_tasks];
+    t->tc = task->task_class;
+    memcpy(t->locals, task->locals, sizeof(t->locals));
+    t->rank = rank;
+    t->nb_preds = 0;
+    t->cost = cost;
+    t->start = 0;
+    t->nb_chain_tasks = 0;
+    estimate_index_insert(state, state->nb_tasks);
+    state->nb_tasks++;
+    return PARSEC_SUCCESS;
+}
+
+static int64_t estimate_output_size(const parsec_dep_data_description_t *data)
+{
+    int size;
+
+    if( PARSEC_DATATYPE_NULL != data->remote.src_datatype ) {
+        if( PARSEC_SUCCESS != parsec_type_size(data->remote.src_datatype, &size) )
+            return 0;
+        return (int64_t)size * (int64_t)data->remote.src_count;
+    }
+    if( (NULL != data->remote.arena) && (0 != data->remote.src_count) )
+        return (int64_t)data->remote.arena->elem_size;
+    return 0;
+}
+
+static parsec_ontask_iterate_t
+estimate_count_successor(parsec_execution_stream_t *es,
+                         const parsec_task_t *newcontext,
+                         const parsec_task_t *oldcontext,
+                         const parsec_dep_t *dep,
+                         parsec_dep_data_description_t *data,
+                         int rank_src, int rank_dst, int vpid_dst,
+                         data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                         void *param)
+{
+    estimate_state_t *state = (estimate_state_t*)param;
+    parsec_estimate_t *estimate = state->estimate;
+    const estimate_task_t *task = &state->tasks[state->current];
+    uint64_t output = 1ULL << (dep->dep_datatype_index % 64);
+    int64_t succ, peer;
+    int dst;
+    (void)es; (void)oldcontext; (void)rank_src; (void)rank_dst; (void)vpid_dst;
+    (void)successor_repo; (void)successor_repo_key;
+
+    succ = estimate_find(state, newcontext->task_class, newcontext->locals);
+    if( -1 == succ )  /* Not in the execution space */
+        return PARSEC_ITERATE_CONTINUE;
+    state->tasks[succ].nb_preds++;
+
+    dst = state->tasks[succ].rank;
+    if( dst == task->rank )
+        return PARSEC_ITERATE_CONTINUE;
+    peer = (int64_t)task->rank * estimate->nb_ranks + dst;
+    if( state->sent_task[dst] != state->current ) {
+        state->sent_task[dst] = state->current;
+        state->sent_outputs[dst] = 0;
+        estimate->messages[peer]++;
+    }
+    if( !(state->sent_outputs[dst] & output) ) {
+        state->sent_outputs[dst] |= output;
+        estimate->bytes[peer] += estimate_output_size(data);
+    }
+    return PARSEC_ITERATE_CONTINUE;
+}
+
+static parsec_ontask_iterate_t
+estimate_release_successor(parsec_execution_stream_t *es,
+                           const parsec_task_t *newcontext,
+                           const parsec_task_t *oldcontext,
+                           const parsec_dep_t *dep,
+                           parsec_dep_data_description_t *data,
+                           int rank_src, int rank_dst, int vpid_dst,
+                           data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                           void *param)
+{
+    estimate_state_t *state = (estimate_state_t*)param;
+    const estimate_task_t *task = &state->tasks[state->current];
+    int64_t finish = task->start + task->cost, succ;
+    estimate_task_t *s;
+    (void)es; (void)oldcontext; (void)dep; (void)data; (void)rank_src; (void)rank_dst;
+    (void)vpid_dst; (void)successor_repo; (void)successor_repo_key;
+
+    succ = estimate_find(state, newcontext->task_class, newcontext->locals);
+    if( -1 == succ )
+        return PARSEC_ITERATE_CONTINUE;
+    s = &state->tasks[succ];
+    if( (finish > s->start) ||
+        ((finish == s->start) && (task->nb_chain_tasks + 1 > s->nb_chain_tasks)) ) {
+        s->start = finish;
+        s->nb_chain_tasks = task->nb_chain_tasks + 1;
+    }
+    if( 0 == --s->nb_preds )
+        state->ready[state->nb_ready++] = succ;
+    return PARSEC_ITERATE_CONTINUE;
+}
+
+/* Iterate the successors of a task, on all its outputs */
+static void estimate_iterate_successors(parsec_taskpool_t *tp, estimate_state_t *state,
+                                        int64_t t, parsec_ontask_function_t *ontask)
+{
+    const estimate_task_t *task = &state->tasks[t];
+    parsec_task_t this_task;
+
+    if( NULL == task->tc->iterate_successors )
+        return;
+    PARSEC_OBJ_CONSTRUCT(&this_task, parsec_task_t);
+    this_task.taskpool = tp;
+    this_task.task_class = task->tc;
+    this_task.priority = 0;
+    this_task.chore_mask = PARSEC_DEV_ALL;
+    memcpy(this_task.locals, task->locals, sizeof(this_task.locals));
+    memset(this_task.data, 0, MAX_PARAM_COUNT * sizeof(parsec_data_pair_t));
+    state->current = t;
+    task->tc->iterate_successors(NULL, &this_task,
+                                 PARSEC_ACTION_SEND_REMOTE_DEPS | PARSEC_ACTION_DEPS_MASK,
+                                 ontask, state);
+}
+
+int parsec_estimate_taskpool(parsec_taskpool_t *tp, int nb_ranks,
+                             parsec_sim_cost_fct_t **costs,
+                             parsec_estimate_t *estimate)
+{
+    estimate_state_t state;
+    const parsec_task_class_t *tc;
+    parsec_data_ref_t ref;
+    parsec_task_t task;
+    int64_t t, nb_done;
+    int rc = PARSEC_SUCCESS, rank, li, init;
+    uint32_t i;
+
+    if( nb_ranks <= 0 )
+        return PARSEC_ERR_BAD_PARAM;
+    memset(estimate, 0, sizeof(parsec_estimate_t));
+    memset(&state, 0, sizeof(estimate_state_t));
+    estimate->nb_ranks = nb_ranks;
+    estimate->nb_rank_tasks = (int64_t*)calloc(nb_ranks, sizeof(int64_t));
+    estimate->messages = (int64_t*)calloc((size_t)nb_ranks * nb_ranks, sizeof(int64_t));
+    estimate->bytes = (int64_t*)calloc((size_t)nb_ranks * nb_ranks, sizeof(int64_t));
+    state.estimate = estimate;
+    state.sent_task = (int64_t*)malloc(nb_ranks * sizeof(int64_t));
+    state.sent_outputs = (uint64_t*)calloc(nb_ranks, sizeof(uint64_t));
+    if( (NULL == estimate->nb_rank_tasks) || (NULL == estimate->messages) ||
+        (NULL == estimate->bytes) || (NULL == state.sent_task) || (NULL == state.sent_outputs) ) {
+        rc = PARSEC_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    memset(state.sent_task, -1, nb_ranks * sizeof(int64_t));
+
+    /* Enumerate the tasks of the execution space */
+    PARSEC_OBJ_CONSTRUCT(&task, parsec_task_t);
+    task.taskpool = tp;
+    task.priority = 0;
+    memset(task.data, 0, MAX_PARAM_COUNT * sizeof(parsec_data_pair_t));
+    for( i = 0; i < tp->nb_task_classes; i++ ) {
+        tc = tp->task_classes_array[i];
+        if( (NULL == tc) || (NULL == tc->data_affinity) ) continue;
+        task.task_class = tc;
+        for( li = 0; li < MAX_LOCAL_COUNT; li++ )
+            task.locals[li].value = -1;
+        init = 1;
+        while( parsec_debug_enumerate_next_in_execution_space(&task, init, 0) ) {
+            init = 0;
+            tc->data_affinity(&task, &ref);
+            rank = (int)ref.dc->rank_of_key(ref.dc, ref.key);
+            if( (rank < 0) || (rank >= nb_ranks) ) {
+                char tmp[MAX_TASK_STRLEN];
+                parsec_warning("Task %s runs on process %d, out of the %d estimated processes",
+                               parsec_task_snprintf(tmp, MAX_TASK_STRLEN, &task), rank, nb_ranks);
+                rc = PARSEC_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            rc = estimate_add_task(&state, &task, rank,
+                                   ((NULL != costs) && (NULL != costs[tc->task_class_id])) ?
+                                   costs[tc->task_class_id](&task) : 1);
+            if( PARSEC_SUCCESS != rc ) goto cleanup;
+            estimate->nb_rank_tasks[rank]++;
+        }
+    }
+    estimate->nb_tasks = state.nb_tasks;
+    if( 0 == state.nb_tasks )
+        goto cleanup;
+
+    /* Count the predecessors of each task and the communications */
+    for( t = 0; t < state.nb_tasks; t++ )
+        estimate_iterate_successors(tp, &state, t, estimate_count_successor);
+
+    /* The longest chain of tasks, releasing them in a topological order */
+    state.ready = (int64_t*)malloc(state.nb_tasks * sizeof(int64_t));
+    if( NULL == state.ready ) {
+        rc = PARSEC_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for( t = 0; t < state.nb_tasks; t++ ) {
+        if( 0 == state.tasks[t].nb_preds )
+            state.ready[state.nb_ready++] = t;
+    }
+    for( nb_done = 0; nb_done < state.nb_ready; nb_done++ ) {
+        const estimate_task_t *done;
+        t = state.ready[nb_done];
+        done = &state.tasks[t];
+        if( (done->start + done->cost > estimate->critical_path) ||
+            ((done->start + done->cost == estimate->critical_path) &&
+             (done->nb_chain_tasks + 1 > estimate->critical_path_tasks)) ) {
+            estimate->critical_path = done->start + done->cost;
+            estimate->critical_path_tasks = done->nb_chain_tasks + 1;
+        }
+        estimate_iterate_successors(tp, &state, t, estimate_release_successor);
+    }
+    if( state.nb_ready != state.nb_tasks ) {
+        parsec_warning("The dependencies of %"PRId64" tasks of taskpool %s are cyclic",
+                       state.nb_tasks - state.nb_ready, tp->taskpool_name);
+        rc = PARSEC_ERROR;
+    }
+
+  cleanup:
+    free(state.tasks);
+    free(state.index);
+    free(state.sent_task);
+    free(state.sent_outputs);
+    free(state.ready);
+    if( PARSEC_SUCCESS != rc )
+        parsec_estimate_fini(estimate);
+    return rc;
+}
+
+void parsec_estimate_fini(parsec_estimate_t *estimate)
+{
+    free(estimate->nb_rank_tasks);
+    free(estimate->messages);
+    free(estimate->bytes);
+    estimate->nb_rank_tasks = NULL;
+    estimate->messages = NULL;
+    estimate->bytes = NULL;
+}
+
+void parsec_estimate_print(FILE *out, const parsec_estimate_t *estimate)
+{
+    int64_t sent, received, sent_bytes, received_bytes;
+    int r, peer;
+
+    fprintf(out, "%"PRId64" tasks on %d processes, critical path of cost %"PRId64" (%"PRId64" tasks)\n",
+            estimate->nb_tasks, estimate->nb_ranks,
+            estimate->critical_path, estimate->critical_path_tasks);
+    for( r = 0; r < estimate->nb_ranks; r++ ) {
+        sent = received = sent_bytes = received_bytes = 0;
+        for( peer = 0; peer < estimate->nb_ranks; peer++ ) {
+            sent += estimate->messages[r * estimate->nb_ranks + peer];
+            sent_bytes += estimate->bytes[r * estimate->nb_ranks + peer];
+            received += estimate->messages[peer * estimate->nb_ranks + r];
+            received_bytes += estimate->bytes[peer * estimate->nb_ranks + r];
+        }
+        fprintf(out, "  process %d: %"PRId64" tasks, %"PRId64" activations sent (%"PRId64" bytes),"
+                " %"PRId64" received (%"PRId64" bytes)\n",
+                r, estimate->nb_rank_tasks[r], sent, sent_bytes, received, received_bytes);
+        for( peer = 0; peer < estimate->nb_ranks; peer++ ) {
+            if( 0 == estimate->messages[r * estimate->nb_ranks + peer] ) continue;
+            fprintf(out, "    to process %d: %"PRId64" activations (%"PRId64" bytes)\n", peer,
+                    estimate->messages[r * estimate->nb_ranks + peer],
+                    estimate->bytes[r * estimate->nb_ranks + peer]);
+        }
+    }
+}
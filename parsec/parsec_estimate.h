@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ */
+
+#ifndef _parsec_estimate_h
+#define _parsec_estimate_h
+
+/**
+ *  @addtogroup parsec_internal_runtime
+ *  @{
+ */
+
+#include "parsec/parsec_internal.h"
+#include <stdio.h>
+
+BEGIN_C_DECLS
+
+/**
+ * @brief The static estimation of the execution of a PTG taskpool
+ *
+ * @details The tasks of the taskpool are enumerated and their successors
+ *          iterated, without executing the tasks: the process owning each
+ *          task is given by its affinity in the data collections of the
+ *          taskpool, which can describe a process grid larger than the
+ *          current run.
+ */
+typedef struct parsec_estimate_s {
+    int       nb_ranks;       /**< Number of processes of the estimation */
+    int64_t   nb_tasks;       /**< Total number of tasks */
+    int64_t  *nb_rank_tasks;  /**< Number of tasks of each process [nb_ranks] */
+    int64_t  *messages;       /**< Number of activations sent from a process to another,
+                               *   messages[src * nb_ranks + dst] */
+    int64_t  *bytes;          /**< Number of bytes sent from a process to another,
+                               *   bytes[src * nb_ranks + dst] */
+    int64_t   critical_path;  /**< Cost of the longest chain of tasks */
+    int64_t   critical_path_tasks; /**< Number of tasks on this chain */
+} parsec_estimate_t;
+
+/**
+ * @brief Estimate the execution of a taskpool on nb_ranks processes
+ *
+ * @details A task sends one activation to each process running some of its
+ *          successors, and each of its outputs once to such a process, as
+ *          the runtime does for all the successors on that process. The size
+ *          of an output is the size of its remote datatype, or the size of
+ *          the elements of its arena. The taskpool is not modified and can
+ *          still be enqueued after the estimation.
+ *
+ * @param[in] tp the taskpool, with its arenas datatypes set
+ * @param[in] nb_ranks the number of processes of the estimation
+ * @param[in] costs the cost of the tasks of each task class on the critical
+ *            path, NULL for a cost of 1 (NULL for all the task classes)
+ * @param[out] estimate the estimation, to release with parsec_estimate_fini
+ * @return PARSEC_SUCCESS, or an error if a task is owned by a process out of
+ *         the nb_ranks processes, or if the tasks have cyclic dependencies
+ */
+int parsec_estimate_taskpool(parsec_taskpool_t *tp, int nb_ranks,
+                             parsec_sim_cost_fct_t **costs,
+                             parsec_estimate_t *estimate);
+
+/**
+ * @brief Release the arrays of an estimation
+ */
+void parsec_estimate_fini(parsec_estimate_t *estimate);
+
+/**
+ * @brief Print the tasks, the communications and the critical path of an
+ *        estimation
+ */
+void parsec_estimate_print(FILE *out, const parsec_estimate_t *estimate);
+
+END_C_DECLS
+
+/** @} */
+
+#endif  /* _parsec_estimate_h */
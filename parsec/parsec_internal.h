@@ -105,6 +105,24 @@ typedef void (*parsec_startup_fn_t)(parsec_context_t *context,
  */
 typedef void (*parsec_destruct_fn_t)(parsec_taskpool_t* tp);
 
+/**
+ * @brief The steps of the execution of a task that a taskpool can dispatch
+ */
+typedef enum parsec_task_step_e {
+    PARSEC_TASK_STEP_PREPARE_INPUT = 0, /**< the prepare_input of the task class */
+    PARSEC_TASK_STEP_EXECUTE,           /**< the hook of the selected chore */
+    PARSEC_TASK_STEP_COMPLETE           /**< the complete_execution of the task class */
+} parsec_task_step_t;
+
+/**
+ * @brief The prototype of a taskpool function executing one step of its tasks
+ *        through direct calls, instead of the function pointers of their task
+ *        class. It returns the same values as the function it replaces.
+ */
+typedef int (*parsec_task_dispatch_fn_t)(parsec_execution_stream_t *es,
+                                         parsec_task_t *task,
+                                         parsec_task_step_t step);
+
 /**
  * Types of known taskpools. This should be extended as new types of taskpools are
  * to PaRSEC.
@@ -146,6 +164,8 @@ struct parsec_taskpool_s {
     parsec_context_t*           context;   /**< The PaRSEC context on which this taskpool was enqueued */
     parsec_termdet_monitor_t    tdm;       /**< Termination detection structures and pointer to module */
     parsec_startup_fn_t         startup_hook;  /**< Pointer to the function that generates initial tasks */
+    parsec_task_dispatch_fn_t   task_dispatch; /**< If not NULL, executes the steps of the tasks instead of the
+                                                *   function pointers of their task class */
     const parsec_task_class_t** task_classes_array; /**< Array of task classes that build this DAG */
 #if defined(PARSEC_PROF_TRACE)
     const int*                  profiling_array; /**< Array of profiling keys to start/stop each of the task classes
@@ -246,9 +266,7 @@ typedef int (parsec_release_deps_t)(struct parsec_execution_stream_s*,
                                    parsec_task_t*,
                                    uint32_t,
                                    parsec_remote_deps_t*);
-#if defined(PARSEC_SIM)
 typedef int (parsec_sim_cost_fct_t)(const parsec_task_t *task);
-#endif
 
 /**
  *
@@ -346,6 +364,9 @@ typedef int (parsec_data_ref_fn_t)(const parsec_task_t *task, parsec_data_ref_t
 #define PARSEC_IMMEDIATE_TASK             0x0010
 #define PARSEC_USE_DEPS_MASK              0x0020
 #define PARSEC_HAS_CTL_GATHER             0X0040
+#define PARSEC_COARSENED_TASK             0x0080  /**< the ready local successors of the tasks are chained to them */
+#define PARSEC_SINGLE_INPUT_TASK          0x0100  /**< the tasks are ready once their only predecessor releases them,
+                                                   *   their dependencies are not tracked */
 
 #define PARSEC_TASK_CLASS_TYPE_PTG        0x01
 #define PARSEC_TASK_CLASS_TYPE_DTD        0x02
@@ -474,6 +495,7 @@ struct parsec_data_pair_s {
  */
 PARSEC_DECLSPEC extern size_t parsec_task_startup_iter;
 PARSEC_DECLSPEC extern size_t parsec_task_startup_chunk;
+PARSEC_DECLSPEC extern size_t parsec_task_startup_slices;
 
 /**
  * @brief Global configuration variable controlling the getrusage report.
@@ -652,6 +674,22 @@ parsec_release_dep_fct(struct parsec_execution_stream_s *es,
                        data_repo_t *successor_repo, parsec_key_t successor_repo_key,
                        void *param);
 
+/**
+ * Same as parsec_release_dep_fct, for a successor whose dependencies were
+ * already looked up and updated by the caller when they are released
+ * locally: completed tells if the successor is ready. The generated code
+ * uses it to update the dependencies of a known successor class directly.
+ */
+parsec_ontask_iterate_t
+parsec_release_dep_completed_fct(struct parsec_execution_stream_s *es,
+                                 const parsec_task_t *newcontext,
+                                 const parsec_task_t *oldcontext,
+                                 const parsec_dep_t* dep,
+                                 parsec_dep_data_description_t* data,
+                                 int rank_src, int rank_dst, int vpid_dst,
+                                 data_repo_t *successor_repo, parsec_key_t successor_repo_key,
+                                 void *param, int completed);
+
 /**
  * Function to create reshaping promises during iterate_successors.
  */
@@ -696,6 +734,15 @@ int32_t parsec_add_fetch_runtime_task( parsec_taskpool_t *tp, int32_t nb_tasks )
 
 void parsec_dependencies_mark_task_as_startup(parsec_task_t* task, parsec_execution_stream_t *es);
 
+/**
+ * Move the locals of context to the next task of its task class, in the
+ * order of the execution space. The first task is obtained with init set,
+ * starting from the local li (0 for all the locals). Returns 0 once all the
+ * tasks have been enumerated.
+ */
+int parsec_debug_enumerate_next_in_execution_space(parsec_task_t *context,
+                                                  int init, int li);
+
 int
 parsec_release_local_OUT_dependencies(parsec_execution_stream_t* es,
                                       const parsec_task_t* origin,
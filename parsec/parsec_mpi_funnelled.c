@@ -58,6 +58,8 @@ PARSEC_OBJ_CLASS_INSTANCE(mpi_funnelled_mem_reg_handle_t, parsec_list_item_t,
  * if the layer has been initialized or not.
  */
 static int MAX_MPI_TAG = -1, mca_tag_ub = -1;
+/* mpi_ranks_per_node: see the corresponding mca_register */
+static int mca_ranks_per_node = 0;
 static volatile int __VAL_NEXT_TAG = 0;
 #if INT_MAX == INT32_MAX
 #define next_tag_cas(t, o, n) parsec_atomic_cas_int32(t, o, n)
@@ -492,6 +494,14 @@ static int mpi_funneled_init_once(parsec_context_t* context)
     parsec_mca_param_reg_int_name("mpi", "tag_ub",
                                   "The upper bound of the TAG used by the MPI communication engine. Bounded by the MPI_TAG_UB attribute on the MPI implementation MPI_COMM_WORLD. (-1 for MPI default)",
                                   false, false, -1, &mca_tag_ub);
+    parsec_mca_param_reg_int_name("mpi", "ranks_per_node",
+                                  "Number of consecutive ranks considered as sharing a node by the locality aware algorithms (such as the hierarchical broadcast), "
+                                  "overriding the shared memory domains reported by MPI (0 to use the MPI locality). Mostly useful to emulate a multi-node run on a single node.",
+                                  false, false, 0, &mca_ranks_per_node);
+    if( mca_ranks_per_node < 0 ) {
+        parsec_warning("Invalid number of ranks per node %d requested; using the MPI locality", mca_ranks_per_node);
+        mca_ranks_per_node = 0;
+    }
 
     if( !mpi_tag_ub_exists ) {
         MAX_MPI_TAG = (-1 == mca_tag_ub) ? INT_MAX : mca_tag_ub;
@@ -554,6 +564,7 @@ mpi_funnelled_init(parsec_context_t *context)
     parsec_ce.reshape             = NULL;
     parsec_ce.can_serve           = NULL;
     parsec_ce.send_am             = NULL;
+    parsec_ce.rank_to_node        = NULL;
 
     parsec_ce.parsec_context      = context;
     parsec_ce.capabilites.sided   = 2;
@@ -608,6 +619,7 @@ mpi_funnelled_fini(parsec_comm_engine_t *ce)
     free(array_of_requests);  array_of_requests  = NULL;
     free(array_of_indices);   array_of_indices   = NULL;
     free(array_of_statuses);  array_of_statuses  = NULL;
+    free(ce->rank_to_node);   ce->rank_to_node   = NULL;
 
     if( NULL != mpi_funnelled_mem_reg_handle_mempool ) {
         PARSEC_OBJ_DESTRUCT(&mpi_funnelled_dynamic_sendreq_fifo);
@@ -1319,6 +1331,33 @@ parsec_check_overlapping_binding(parsec_context_t *context)
 #endif
 }
 
+/**
+ * Build the rank_to_node map of the communication engine. Each node is
+ * identified by the lowest rank (in the PaRSEC communicator) of the processes
+ * sharing its memory, or of the mpi_ranks_per_node consecutive ranks grouped
+ * together when this MCA parameter is set. This is a collective operation on
+ * parsec_ce_mpi_comm, unless the locality is emulated.
+ */
+static void
+mpi_funnelled_discover_locality(parsec_comm_engine_t *ce)
+{
+    parsec_context_t *context = ce->parsec_context;
+    MPI_Comm comml = MPI_COMM_NULL;
+    int node = context->my_rank;
+
+    free(ce->rank_to_node);
+    ce->rank_to_node = (int*)malloc(context->nb_nodes * sizeof(int));
+    if( 0 < mca_ranks_per_node ) {
+        for( int r = 0; r < context->nb_nodes; r++ )
+            ce->rank_to_node[r] = r - (r % mca_ranks_per_node);
+        return;
+    }
+    MPI_Comm_split_type(parsec_ce_mpi_comm, MPI_COMM_TYPE_SHARED, context->my_rank, MPI_INFO_NULL, &comml);
+    MPI_Bcast(&node, 1, MPI_INT, 0, comml);
+    MPI_Comm_free(&comml);
+    MPI_Allgather(&node, 1, MPI_INT, ce->rank_to_node, 1, MPI_INT, parsec_ce_mpi_comm);
+}
+
 int
 mpi_no_thread_enable(parsec_comm_engine_t *ce)
 {
@@ -1383,6 +1422,7 @@ mpi_no_thread_enable(parsec_comm_engine_t *ce)
     MPI_Comm_rank(parsec_ce_mpi_comm, &(context->my_rank));
 
     parsec_check_overlapping_binding(context);
+    mpi_funnelled_discover_locality(ce);
 
 #if defined(PARSEC_HAVE_MPI_OVERTAKE)
     if( parsec_param_enable_mpi_overtake ) {
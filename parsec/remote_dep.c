@@ -36,13 +36,27 @@ int comm_yield_ns = 5000;
 /* comm_thread_multiple: see values in the corresponding mca_register */
 int parsec_param_comm_thread_multiple = -1;
 
+/* Broadcast topologies, as selected by the root of the collective and
+ * carried by the activation message (msg.bcast_topology). */
+#define REMOTE_DEP_BCAST_STAR         0
+#define REMOTE_DEP_BCAST_CHAIN        1
+#define REMOTE_DEP_BCAST_BINOMIAL     2
+#define REMOTE_DEP_BCAST_HIERARCHICAL 3
+
 static int remote_dep_bcast_star_child(int me, int him);
 #ifdef PARSEC_DIST_COLLECTIVES
 /* comm_coll_bcast: see values in the corresponding mca_register */
-static int parsec_param_comm_coll_bcast = 1;
+static int parsec_param_comm_coll_bcast = REMOTE_DEP_BCAST_CHAIN;
+/* comm_coll_bcast_small_limit / large_limit (bytes): 0 disables the size based selection */
+static size_t parsec_param_comm_coll_bcast_small_limit = 0;
+static size_t parsec_param_comm_coll_bcast_large_limit = 0;
 static int remote_dep_bcast_chainpipeline_child(int me, int him);
 static int remote_dep_bcast_binomial_child(int me, int him);
-static int (*remote_dep_bcast_child)(int me, int him) = remote_dep_bcast_chainpipeline_child;
+static int (*remote_dep_bcast_child[])(int me, int him) = {
+    [REMOTE_DEP_BCAST_STAR]     = remote_dep_bcast_star_child,
+    [REMOTE_DEP_BCAST_CHAIN]    = remote_dep_bcast_chainpipeline_child,
+    [REMOTE_DEP_BCAST_BINOMIAL] = remote_dep_bcast_binomial_child,
+};
 #else
 #define remote_dep_bcast_child(me, him) remote_dep_bcast_start_child(me, him)
 #endif
@@ -167,6 +181,8 @@ parsec_remote_deps_t* remote_deps_allocate( parsec_lifo_t* lifo )
             remote_deps->output[i].deps_mask  = 0;
             remote_deps->output[i].count_bits = 0;
             remote_deps->output[i].priority   = 0xffffffff;
+            remote_deps->output[i].pipeline_buffer = NULL;
+            remote_deps->output[i].pipeline_layout = NULL;
             ptr += rank_bit_size;
         }
         /* fw_mask immediately follows outputs */
@@ -195,6 +211,14 @@ inline void remote_deps_free(parsec_remote_deps_t* deps)
     assert(0 == deps->incoming_mask);
     assert(0 == deps->outgoing_mask);
     for( k = 0; k < parsec_remote_dep_context.max_dep_count; k++ ) {
+        if( NULL != deps->output[k].pipeline_buffer ) {
+            free(deps->output[k].pipeline_buffer);
+            deps->output[k].pipeline_buffer = NULL;
+        }
+        if( NULL != deps->output[k].pipeline_layout ) {
+            free(deps->output[k].pipeline_layout);
+            deps->output[k].pipeline_layout = NULL;
+        }
         if( 0 == deps->output[k].count_bits ) continue;
         for(a = 0; a < (parsec_remote_dep_context.max_nodes_number + 31)/32; a++)
             deps->output[k].rank_bits[a] = 0;
@@ -263,23 +287,25 @@ int parsec_remote_dep_init(parsec_context_t* context)
     parsec_mca_param_reg_int_name("runtime", "comm_coll_bcast", "Controls the default broadcast algorithm topology.\n"
                                                                 "  0: star topology (direct one to all).\n"
                                                                 "  1: chain topology.\n"
-                                                                "  2: binomial topology.\n",
+                                                                "  2: binomial topology.\n"
+                                                                "  3: hierarchical topology (one copy per node, then\n"
+                                                                "     forwarded to the other processes of the node).\n",
                                   false, false, parsec_param_comm_coll_bcast, &parsec_param_comm_coll_bcast);
-    switch(parsec_param_comm_coll_bcast) {
-    case 0:
-        remote_dep_bcast_child = remote_dep_bcast_star_child;
-        break;
-    case 1:
-        remote_dep_bcast_child = remote_dep_bcast_chainpipeline_child;
-        break;
-    case 2:
-        remote_dep_bcast_child = remote_dep_bcast_binomial_child;
-        break;
-    default:
+    if( (parsec_param_comm_coll_bcast < REMOTE_DEP_BCAST_STAR) ||
+        (parsec_param_comm_coll_bcast > REMOTE_DEP_BCAST_HIERARCHICAL) ) {
         parsec_warning("Invalid collective type requested %d; using star topology.", parsec_param_comm_coll_bcast);
-        remote_dep_bcast_child = remote_dep_bcast_star_child;
-        break;
+        parsec_param_comm_coll_bcast = REMOTE_DEP_BCAST_STAR;
     }
+    parsec_mca_param_reg_sizet_name("runtime", "comm_coll_bcast_small_limit",
+                                    "Broadcasts of messages smaller than this size (in bytes) use the star topology,\n"
+                                    "independently of comm_coll_bcast (0 to disable).\n",
+                                    false, false, parsec_param_comm_coll_bcast_small_limit,
+                                    &parsec_param_comm_coll_bcast_small_limit);
+    parsec_mca_param_reg_sizet_name("runtime", "comm_coll_bcast_large_limit",
+                                    "Broadcasts of messages of at least this size (in bytes) use the chain topology,\n"
+                                    "independently of comm_coll_bcast (0 to disable).\n",
+                                    false, false, parsec_param_comm_coll_bcast_large_limit,
+                                    &parsec_param_comm_coll_bcast_large_limit);
 #endif
 
     (void)remote_dep_dequeue_init(context);
@@ -317,6 +343,17 @@ int parsec_remote_dep_set_ctx( parsec_context_t* context, intptr_t opaque_comm_c
     return parsec_ce.set_ctx(&parsec_ce, opaque_comm_ctx);
 }
 
+/* Mark the node as participating in the current hierarchical broadcast,
+ * and return true if it was the first participant on this node. */
+static inline int
+remote_dep_bcast_node_first_seen(uint32_t* nodes, int node)
+{
+    uint32_t mask = ((uint32_t)1) << (node % 32);
+    int first = !(nodes[node / 32] & mask);
+    nodes[node / 32] |= mask;
+    return first;
+}
+
 static int remote_dep_bcast_star_child(int me, int him)
 {
     (void)him;
@@ -357,6 +394,40 @@ static int remote_dep_bcast_binomial_child(int me, int him)
     return him == me;
 }
 
+/**
+ * Select the broadcast topology of a collective, on its root. The decision is
+ * based on the largest data propagated by the message, and is carried by the
+ * activation message such that all participants rebuild the same tree.
+ */
+static uint32_t
+remote_dep_bcast_select_topology(parsec_remote_deps_t* remote_deps,
+                                 uint32_t propagation_mask)
+{
+    struct remote_dep_output_param_s* output;
+    size_t size = 0;
+    int i, dtt_size;
+
+    for( i = 0; propagation_mask >> i; i++ ) {
+        if( !((1U << i) & propagation_mask) ) continue;
+        output = &remote_deps->output[i];
+        if( (NULL == output->data.data) ||
+            (PARSEC_DATATYPE_NULL == output->data.remote.src_datatype) ) continue;
+        parsec_type_size(output->data.remote.src_datatype, &dtt_size);
+        if( (size_t)dtt_size * output->data.remote.src_count > size )
+            size = (size_t)dtt_size * output->data.remote.src_count;
+    }
+    if( (0 != parsec_param_comm_coll_bcast_small_limit) &&
+        (size < parsec_param_comm_coll_bcast_small_limit) )
+        return REMOTE_DEP_BCAST_STAR;
+    if( (0 != parsec_param_comm_coll_bcast_large_limit) &&
+        (size >= parsec_param_comm_coll_bcast_large_limit) )
+        return REMOTE_DEP_BCAST_CHAIN;
+    if( (REMOTE_DEP_BCAST_HIERARCHICAL == parsec_param_comm_coll_bcast) &&
+        (NULL == parsec_ce.rank_to_node) )
+        return REMOTE_DEP_BCAST_STAR;  /* no locality information */
+    return parsec_param_comm_coll_bcast;
+}
+
 /**
  * This function is called from the successor iterator in order to rebuilt
  * the information needed to propagate the collective in a meaningful way. In
@@ -444,11 +515,15 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                                uint32_t propagation_mask)
 {
     const parsec_task_class_t* tc = task->task_class;
+    parsec_context_t* context = es->virtual_process->parsec_context;
     int i, my_idx, idx, current_mask, keeper = 0;
     unsigned int array_index, count, bit_index;
     struct remote_dep_output_param_s* output;
+    uint32_t topology = REMOTE_DEP_BCAST_STAR;
+    uint32_t* seen_nodes = NULL;
+    int my_node = -1, my_node_leader = 0;
 
-    assert(es->virtual_process->parsec_context->nb_nodes > 1);
+    assert(context->nb_nodes > 1);
 
 #if defined(PARSEC_DEBUG_NOISIER)
     char tmp[MAX_TASK_STRLEN];
@@ -474,6 +549,22 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
     remote_dep_mark_forwarded(es, remote_deps, remote_deps->root);
     assert((propagation_mask & remote_deps->outgoing_mask) == remote_deps->outgoing_mask);
 
+#ifdef PARSEC_DIST_COLLECTIVES
+    /* The root decides the topology, everybody else follows. Right now DTD
+     * only supports a star broadcast topology. */
+    if( remote_deps->root == context->my_rank ) {
+        remote_deps->msg.bcast_topology =
+            (PARSEC_TASKPOOL_TYPE_DTD == task->taskpool->taskpool_type) ? REMOTE_DEP_BCAST_STAR :
+            remote_dep_bcast_select_topology(remote_deps, propagation_mask);
+    }
+    topology = remote_deps->msg.bcast_topology;
+#endif  /* PARSEC_DIST_COLLECTIVES */
+    if( REMOTE_DEP_BCAST_HIERARCHICAL == topology ) {
+        assert(NULL != parsec_ce.rank_to_node);
+        seen_nodes = (uint32_t*)alloca(context->remote_dep_fw_mask_sizeof);
+        my_node = parsec_ce.rank_to_node[context->my_rank];
+    }
+
     for( i = 0; propagation_mask >> i; i++ ) {
         if( !((1U << i) & propagation_mask )) continue;
         output = &remote_deps->output[i];
@@ -481,6 +572,11 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
 
         my_idx = (remote_deps->root == es->virtual_process->parsec_context->my_rank) ? 0 : -1;
         idx = 0;
+        if( NULL != seen_nodes ) {
+            memset(seen_nodes, 0, context->remote_dep_fw_mask_sizeof);
+            (void)remote_dep_bcast_node_first_seen(seen_nodes, parsec_ce.rank_to_node[remote_deps->root]);
+            my_node_leader = (0 == my_idx);
+        }
         /**
          * Increase the refcount of each local output data once, to ensure the
          * data is protected during the entire execution of the communication,
@@ -517,8 +613,11 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                 if(my_idx == -1) {
                     PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "[%d:%d] task %s my_idx %d idx %d rank %d -- skip",
                             remote_deps->root, i, tmp, my_idx, idx, rank);
+                    int first_on_node = (NULL != seen_nodes) &&
+                        remote_dep_bcast_node_first_seen(seen_nodes, parsec_ce.rank_to_node[rank]);
                     if(rank == es->virtual_process->parsec_context->my_rank) {
                         my_idx = idx;
+                        my_node_leader = first_on_node;
                     }
                     remote_dep_mark_forwarded(es, remote_deps, rank);
                     continue;
@@ -527,12 +626,20 @@ int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                         tmp, remote_deps->root, es->virtual_process->parsec_context->my_rank, my_idx, rank);
 
                 int remote_dep_bcast_child_permits = 0;
-                /* Right now DTD only supports a star broadcast topology */
-                if( PARSEC_TASKPOOL_TYPE_DTD == task->taskpool->taskpool_type ) {
-                    remote_dep_bcast_child_permits = remote_dep_bcast_star_child(my_idx, idx);
+                if( REMOTE_DEP_BCAST_HIERARCHICAL == topology ) {
+                    /* The root sends one copy to the first participant of each
+                     * other node, and directly to the participants sharing its
+                     * own node. These node leaders then forward to the remaining
+                     * participants of their node. */
+                    int him_node = parsec_ce.rank_to_node[rank];
+                    int him_node_leader = remote_dep_bcast_node_first_seen(seen_nodes, him_node);
+                    if( 0 == my_idx )
+                        remote_dep_bcast_child_permits = him_node_leader || (him_node == my_node);
+                    else
+                        remote_dep_bcast_child_permits = my_node_leader && (him_node == my_node);
                 } else {
 #ifdef PARSEC_DIST_COLLECTIVES
-                    remote_dep_bcast_child_permits = remote_dep_bcast_child(my_idx, idx);
+                    remote_dep_bcast_child_permits = remote_dep_bcast_child[topology](my_idx, idx);
 #else
                     remote_dep_bcast_child_permits = remote_dep_bcast_star_child(my_idx, idx);
 #endif  /* PARSEC_DIST_COLLECTIVES */
@@ -46,17 +46,41 @@ typedef struct remote_dep_wire_activate_s {
     uint16_t             task_class_id;
     uint16_t             length;
     uint32_t             root;
+    uint32_t             bcast_topology; /**< the broadcast topology selected by the root of the collective */
+    uint32_t             flags;        /**< REMOTE_DEP_WIRE_* flags describing the content of the message */
     parsec_assignment_t  locals[MAX_LOCAL_COUNT];
 } remote_dep_wire_activate_t;
 
+/* The identity of each data follows the sizes of the data in the activation */
+#define REMOTE_DEP_WIRE_DATA_IDS  0x1
+
 typedef struct remote_dep_wire_get_s {
     remote_dep_datakey_t       source_deps;
     remote_dep_datakey_t       remote_callback_data;
     remote_dep_datakey_t       output_mask;
     uintptr_t                  callback_fn;
     parsec_ce_mem_reg_handle_t remote_memory_handle;
+    uint64_t                   frag_offset;  /**< offset (in bytes) of the fragment in the packed data */
+    uint32_t                   frag_length;  /**< length (in bytes) of the fragment, 0 if the entire data is requested */
+    uint32_t                   frag_last;    /**< non zero for the last fragment of a pipelined transfer */
+    uint32_t                   cached;       /**< non zero if the receiver already holds the data: nothing
+                                              *   is to be transferred, the source only releases it */
 } remote_dep_wire_get_t;
 
+/**
+ * Identity of a data on the source of an activation, sent along with the size
+ * of each data. Two data with the same identity sent by the same process hold
+ * the same values, which allows the receiver to reuse a previously received copy.
+ */
+typedef struct remote_dep_wire_data_id_s {
+    uint64_t data;          /**< the parsec_data_t on the source */
+    uint64_t src_datatype;  /**< the layout of the data sent by the source */
+    uint64_t src_count;
+    int64_t  src_displ;
+    uint32_t version;       /**< the version of the data copy sent */
+    uint32_t valid;         /**< zero if the data cannot be identified (temporary data) */
+} remote_dep_wire_data_id_t;
+
 struct parsec_dep_type_description_s {
     struct parsec_arena_s     *arena;
     parsec_datatype_t          src_datatype;
@@ -127,6 +151,14 @@ struct remote_dep_output_param_s {
     int32_t                              priority;    /**< the priority of the message */
     uint32_t                             count_bits;  /**< The number of participants */
     uint32_t*                            rank_bits;   /**< The array of bits representing the propagation path */
+    void*                                pipeline_buffer; /**< Packed copy of a non-dense data served by fragments
+                                                           (pipelined transfers only, NULL otherwise) */
+    void*                                pipeline_layout; /**< Flattened layout of a non-dense data served by fragments
+                                                           in place (pipelined transfers only, NULL otherwise) */
+    remote_dep_wire_data_id_t            data_id;     /**< Identity of the data on the source (receiver side) */
+    uint32_t                             written;     /**< Non zero if a local successor may modify the
+                                                           received data (receiver side) */
+    uint32_t                             src_size;    /**< Size of the data packed by the source (receiver side) */
 };
 
 struct parsec_remote_deps_s {
@@ -185,6 +217,7 @@ int remote_dep_dequeue_on(parsec_context_t* context);
 int remote_dep_dequeue_off(parsec_context_t* context);
 
 int remote_dep_dequeue_new_taskpool(parsec_taskpool_t* tp);
+int remote_dep_dequeue_taskpool_fini(parsec_taskpool_t* tp);
 int remote_dep_dequeue_nothread_progress(parsec_execution_stream_t* es, int cycles);
 
 /* This returns the deps to the freelist, no use counter */
@@ -215,6 +248,12 @@ static inline int parsec_remote_dep_new_taskpool(parsec_taskpool_t* tp)
     return remote_dep_dequeue_new_taskpool(tp);
 }
 
+/* Inform the communication engine from the termination of a taskpool */
+static inline int parsec_remote_dep_taskpool_fini(parsec_taskpool_t* tp)
+{
+    return remote_dep_dequeue_taskpool_fini(tp);
+}
+
 /* Send remote dependencies to target processes */
 int parsec_remote_dep_activate(parsec_execution_stream_t* es,
                                const parsec_task_t* origin,
@@ -236,6 +275,10 @@ int remote_dep_dequeue_delayed_dep_release(parsec_remote_deps_t *deps);
 /* Reconfigure the remote_dep part of the communication engine */
 int parsec_remote_dep_reconfigure(parsec_context_t* context);
 
+/* Retrieve the communication statistics with a peer (-1 for all peers) */
+int remote_dep_mpi_get_stats(int peer, parsec_comm_stats_t* stats);
+#define parsec_remote_dep_get_stats(peer, stats) remote_dep_mpi_get_stats((peer), (stats))
+
 #if defined(PARSEC_DIST_COLLECTIVES)
 /* Propagate an activation order from the current node down the original tree */
 int parsec_remote_dep_propagate(parsec_execution_stream_t* es,
@@ -251,6 +294,8 @@ int parsec_remote_dep_propagate(parsec_execution_stream_t* es,
 #define parsec_remote_dep_progress(ctx)        0
 #define parsec_remote_dep_activate(ctx, o, r) -1
 #define parsec_remote_dep_new_taskpool(ctx)    0
+#define parsec_remote_dep_taskpool_fini(tp)    0
+#define parsec_remote_dep_get_stats(peer, stats) PARSEC_ERR_NOT_FOUND
 #define remote_dep_mpi_initialize_execution_stream(ctx) 0
 #endif /* DISTRIBUTED */
 
@@ -329,6 +374,7 @@ struct dep_cmd_item_s {
     parsec_list_item_t pos_list;
     dep_cmd_action_t  action;
     int               priority;
+    double            timestamp;  /**< when the command was queued (communication statistics only) */
     dep_cmd_t         cmd;
 };
 
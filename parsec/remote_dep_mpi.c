@@ -8,6 +8,7 @@
 #include "parsec/parsec_config.h"
 
 #include <mpi.h>
+#include <limits.h>
 #include "profiling.h"
 #include "parsec/class/list.h"
 #include "parsec/utils/output.h"
@@ -48,9 +49,47 @@ static int parsec_param_nb_tasks_extracted = 20;
  */
 static size_t parsec_param_short_limit = RDEP_MSG_SHORT_LIMIT;
 static int parsec_param_enable_aggregate = 0;
+/* For the meaning of the pipeline fragment size and depth, refer to the param
+ * register help text for comm_pipeline_fragment_size and comm_pipeline_depth.
+ */
+static size_t parsec_param_pipeline_frag_size = 0;
+static int parsec_param_pipeline_depth = 4;
+/* Number of entries of the received data cache, see comm_recv_cache_size */
+static int parsec_param_recv_cache_size = 0;
+/* Collect the communication statistics, see comm_stats */
+static int parsec_param_comm_stats = 0;
 
 parsec_mempool_t *parsec_remote_dep_cb_data_mempool = NULL;
 
+/**
+ * Receiver side state of a pipelined transfer. A data larger than the
+ * pipeline fragment size is retrieved as a sequence of fragments of its packed
+ * representation, with up to parsec_param_pipeline_depth fragments in flight
+ * concurrently. If the destination layout is dense, or can be flattened into a
+ * list of contiguous blocks, the fragments land directly in the destination.
+ * Otherwise they land in a staging buffer and are unpacked as soon as a prefix
+ * of the data covering entire elements of the destination datatype is
+ * available.
+ */
+typedef struct remote_dep_pipeline_s {
+    parsec_remote_deps_t *deps;
+    int                   k;
+    char                 *buffer;      /**< where the fragments land */
+    int                   staged;      /**< 1 if buffer is a staging buffer to be unpacked */
+    size_t                length;      /**< total length of the packed data */
+    size_t                frag_size;
+    uint32_t              nb_frags;
+    uint32_t              next_frag;   /**< next fragment to be requested */
+    uint32_t              inflight;    /**< number of fragments requested but not yet received */
+    uint32_t              done_prefix; /**< fragments [0, done_prefix) are all received */
+    uint32_t              done_count;  /**< number of fragments received */
+    int                   position;    /**< unpack position in the staging buffer */
+    uint64_t              unpacked;    /**< number of dst_datatype elements already unpacked */
+    uint8_t              *done;        /**< received status of each fragment */
+    struct remote_dep_layout_s *layout; /**< flattened destination layout when the fragments
+                                             land in place in a non-dense destination */
+} remote_dep_pipeline_t;
+
 typedef struct remote_dep_cb_data_s {
     parsec_list_item_t        super;
     parsec_thread_mempool_t *mempool_owner;
@@ -60,10 +99,206 @@ typedef struct remote_dep_cb_data_s {
     uint64_t event_id;
 #endif /* PARSEC_PROF_TRACE */
     int k;
+    remote_dep_pipeline_t *pipeline;  /* NULL unless this is a fragment of a pipelined transfer */
+    uint32_t frag;
+    parsec_datatype_t fragment_type;  /* describes a fragment in place, released with the transfer */
+    int peer;                         /* communication statistics only */
+    size_t bytes;
+    double start;
 } remote_dep_cb_data_t;
 
 PARSEC_DECLSPEC PARSEC_OBJ_CLASS_DECLARATION(remote_dep_cb_data_t);
 
+/**
+ * Communication statistics (comm_stats), maintained by the communication
+ * thread. They are protected by a lock for the communication engines allowing
+ * the computation threads to send activations directly, and to be gathered by
+ * parsec_context_query. The latencies are accumulated in histograms of powers
+ * of two microseconds, from which their percentiles are estimated.
+ */
+#define REMOTE_DEP_STATS_BUCKETS 32
+
+typedef struct remote_dep_protocol_stats_s {
+    uint64_t msgs_sent;
+    uint64_t msgs_recv;
+    uint64_t bytes_sent;
+    uint64_t bytes_recv;
+    uint64_t latency_count;
+    double   latency_sum;
+    uint64_t latency_hist[REMOTE_DEP_STATS_BUCKETS];  /**< bucket b counts the latencies below 2^b us */
+} remote_dep_protocol_stats_t;
+
+typedef struct remote_dep_depth_stats_s {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+} remote_dep_depth_stats_t;
+
+static remote_dep_protocol_stats_t (*remote_dep_stats)[PARSEC_COMM_PROTOCOL_COUNT] = NULL;  /* per peer */
+static int remote_dep_stats_nb_peers = 0;
+static remote_dep_depth_stats_t remote_dep_stats_depths[PARSEC_COMM_PROTOCOL_COUNT];
+static parsec_atomic_lock_t remote_dep_stats_lock = PARSEC_ATOMIC_UNLOCKED;
+static int32_t remote_dep_stats_pending_activations = 0;
+
+static inline void
+remote_dep_stats_count(int peer, parsec_comm_protocol_t protocol, int sent, size_t bytes)
+{
+    remote_dep_protocol_stats_t* st;
+
+    if( NULL == remote_dep_stats ) return;
+    parsec_atomic_lock(&remote_dep_stats_lock);
+    st = &remote_dep_stats[peer][protocol];
+    if( sent ) {
+        st->msgs_sent++;
+        st->bytes_sent += bytes;
+    } else {
+        st->msgs_recv++;
+        st->bytes_recv += bytes;
+    }
+    parsec_atomic_unlock(&remote_dep_stats_lock);
+}
+
+static inline void
+remote_dep_stats_latency(int peer, parsec_comm_protocol_t protocol, double start)
+{
+    remote_dep_protocol_stats_t* st;
+    double latency;
+    uint64_t us;
+    int b = 0;
+
+    if( NULL == remote_dep_stats ) return;
+    latency = MPI_Wtime() - start;
+    us = (latency > 0.0) ? (uint64_t)(latency * 1e6) : 0;
+    while( (b < (REMOTE_DEP_STATS_BUCKETS - 1)) && (us >= (1ULL << b)) ) b++;
+    parsec_atomic_lock(&remote_dep_stats_lock);
+    st = &remote_dep_stats[peer][protocol];
+    st->latency_count++;
+    st->latency_sum += latency;
+    st->latency_hist[b]++;
+    parsec_atomic_unlock(&remote_dep_stats_lock);
+}
+
+/* Account for the number of operations already pending when a new one starts */
+static inline void
+remote_dep_stats_depth(parsec_comm_protocol_t protocol, int64_t depth)
+{
+    remote_dep_depth_stats_t* st = &remote_dep_stats_depths[protocol];
+
+    if( NULL == remote_dep_stats ) return;
+    if( depth < 0 ) depth = 0;
+    parsec_atomic_lock(&remote_dep_stats_lock);
+    st->count++;
+    st->sum += (uint64_t)depth;
+    if( (uint64_t)depth > st->max ) st->max = (uint64_t)depth;
+    parsec_atomic_unlock(&remote_dep_stats_lock);
+}
+
+static double
+remote_dep_stats_percentile(const uint64_t* hist, uint64_t count, double p)
+{
+    uint64_t target = (uint64_t)(p * (double)count), acc = 0;
+
+    if( (double)target < p * (double)count ) target++;
+    for( int b = 0; b < REMOTE_DEP_STATS_BUCKETS; b++ ) {
+        acc += hist[b];
+        if( (0 != acc) && (acc >= target) )
+            return (double)(1ULL << b) * 1e-6;
+    }
+    return 0.0;
+}
+
+int remote_dep_mpi_get_stats(int peer, parsec_comm_stats_t* stats)
+{
+    remote_dep_protocol_stats_t sum[PARSEC_COMM_PROTOCOL_COUNT];
+    int first = (-1 == peer) ? 0 : peer;
+    int last  = (-1 == peer) ? remote_dep_stats_nb_peers : peer + 1;
+
+    if( NULL == remote_dep_stats ) return PARSEC_ERR_NOT_FOUND;
+    if( last > remote_dep_stats_nb_peers ) return PARSEC_ERR_BAD_PARAM;
+
+    memset(sum, 0, sizeof(sum));
+    memset(stats, 0, sizeof(parsec_comm_stats_t));
+    parsec_atomic_lock(&remote_dep_stats_lock);
+    for( int p = first; p < last; p++ ) {
+        for( int i = 0; i < PARSEC_COMM_PROTOCOL_COUNT; i++ ) {
+            const remote_dep_protocol_stats_t* st = &remote_dep_stats[p][i];
+            sum[i].msgs_sent     += st->msgs_sent;
+            sum[i].msgs_recv     += st->msgs_recv;
+            sum[i].bytes_sent    += st->bytes_sent;
+            sum[i].bytes_recv    += st->bytes_recv;
+            sum[i].latency_count += st->latency_count;
+            sum[i].latency_sum   += st->latency_sum;
+            for( int b = 0; b < REMOTE_DEP_STATS_BUCKETS; b++ )
+                sum[i].latency_hist[b] += st->latency_hist[b];
+        }
+    }
+    for( int i = 0; (-1 == peer) && (i < PARSEC_COMM_PROTOCOL_COUNT); i++ ) {
+        const remote_dep_depth_stats_t* depth = &remote_dep_stats_depths[i];
+        stats->protocol[i].depth_avg = (0 == depth->count) ? 0.0 : (double)depth->sum / (double)depth->count;
+        stats->protocol[i].depth_max = depth->max;
+    }
+    parsec_atomic_unlock(&remote_dep_stats_lock);
+
+    for( int i = 0; i < PARSEC_COMM_PROTOCOL_COUNT; i++ ) {
+        parsec_comm_protocol_stats_t* out = &stats->protocol[i];
+        out->msgs_sent     = sum[i].msgs_sent;
+        out->msgs_recv     = sum[i].msgs_recv;
+        out->bytes_sent    = sum[i].bytes_sent;
+        out->bytes_recv    = sum[i].bytes_recv;
+        out->latency_count = sum[i].latency_count;
+        if( 0 != sum[i].latency_count ) {
+            out->latency_avg = sum[i].latency_sum / (double)sum[i].latency_count;
+            out->latency_p50 = remote_dep_stats_percentile(sum[i].latency_hist, sum[i].latency_count, 0.50);
+            out->latency_p99 = remote_dep_stats_percentile(sum[i].latency_hist, sum[i].latency_count, 0.99);
+        }
+    }
+    return PARSEC_SUCCESS;
+}
+
+/* (Re)size the statistics for nb_peers processes, keeping the counters already collected */
+static void
+remote_dep_stats_resize(int nb_peers)
+{
+    void* stats;
+
+    if( nb_peers <= remote_dep_stats_nb_peers ) return;
+    parsec_atomic_lock(&remote_dep_stats_lock);
+    stats = realloc(remote_dep_stats, nb_peers * sizeof(*remote_dep_stats));
+    if( NULL != stats ) {
+        remote_dep_stats = stats;
+        memset(&remote_dep_stats[remote_dep_stats_nb_peers], 0,
+               (nb_peers - remote_dep_stats_nb_peers) * sizeof(*remote_dep_stats));
+        remote_dep_stats_nb_peers = nb_peers;
+    }
+    parsec_atomic_unlock(&remote_dep_stats_lock);
+}
+
+static void
+remote_dep_stats_report(parsec_context_t* context)
+{
+    static const char* names[PARSEC_COMM_PROTOCOL_COUNT] = { "ACTIVATE", "GET", "PUT" };
+    parsec_comm_stats_t stats;
+
+    for( int peer = 0; peer < remote_dep_stats_nb_peers; peer++ ) {
+        remote_dep_mpi_get_stats(peer, &stats);
+        for( int i = 0; i < PARSEC_COMM_PROTOCOL_COUNT; i++ ) {
+            parsec_comm_protocol_stats_t* st = &stats.protocol[i];
+            if( 0 == (st->msgs_sent + st->msgs_recv) ) continue;
+            parsec_inform("comm stats %d<->%d %-8s sent %" PRIu64 " msgs %" PRIu64 " bytes, received %" PRIu64 " msgs %" PRIu64 " bytes, "
+                          "latency avg %.1f us p50 <= %.0f us p99 <= %.0f us (%" PRIu64 " timed)",
+                          context->my_rank, peer, names[i],
+                          st->msgs_sent, st->bytes_sent, st->msgs_recv, st->bytes_recv,
+                          st->latency_avg * 1e6, st->latency_p50 * 1e6, st->latency_p99 * 1e6, st->latency_count);
+        }
+    }
+    remote_dep_mpi_get_stats(-1, &stats);
+    for( int i = 0; i < PARSEC_COMM_PROTOCOL_COUNT; i++ ) {
+        if( 0 == stats.protocol[i].depth_max ) continue;
+        parsec_inform("comm stats %d %-8s pending operations avg %.2f max %" PRIu64,
+                      context->my_rank, names[i], stats.protocol[i].depth_avg, stats.protocol[i].depth_max);
+    }
+}
+
 PARSEC_OBJ_CLASS_INSTANCE(remote_dep_cb_data_t, parsec_list_item_t,
                    NULL, NULL);
 
@@ -209,6 +444,30 @@ static void remote_dep_mpi_params(parsec_context_t* context) {
 #endif
     parsec_mca_param_reg_int_name("runtime", "comm_aggregate", "Aggregate multiple dependencies in the same short message (1=true,0=false).",
                                   false, false, parsec_param_enable_aggregate, &parsec_param_enable_aggregate);
+    parsec_mca_param_reg_sizet_name("runtime", "comm_pipeline_fragment_size", "Data larger than this size (in bytes) are retrieved by the receiver as multiple fragments of this size, "
+                                    "with several fragments in flight concurrently and the reception of the data overlapping with the unpacking of the already received fragments (0 disables the pipelined transfers).",
+                                    false, false, parsec_param_pipeline_frag_size, &parsec_param_pipeline_frag_size);
+    parsec_mca_param_reg_int_name("runtime", "comm_pipeline_depth", "Maximum number of fragments of a pipelined transfer in flight at any time.",
+                                  false, false, parsec_param_pipeline_depth, &parsec_param_pipeline_depth);
+    if( parsec_param_pipeline_depth < 1 ) {
+        parsec_warning("Invalid pipeline depth %d requested; value reset to 1", parsec_param_pipeline_depth);
+        parsec_param_pipeline_depth = 1;
+    }
+    if( parsec_param_pipeline_frag_size > UINT32_MAX ) {
+        parsec_warning("Pipeline fragment size %zu exceeds the maximum fragment size; value reset to %u", parsec_param_pipeline_frag_size, UINT32_MAX);
+        parsec_param_pipeline_frag_size = UINT32_MAX;
+    }
+    parsec_mca_param_reg_int_name("runtime", "comm_recv_cache_size", "Number of entries of the cache of received data. A data already received from a process "
+                                  "(same data, same version, same layout) satisfies later activations locally instead of being transferred again (0 disables the cache). "
+                                  "The identity of the data is only sent along the activations when the cache is enabled, thus all processes must use the same setting.",
+                                  false, false, parsec_param_recv_cache_size, &parsec_param_recv_cache_size);
+    if( parsec_param_recv_cache_size < 0 ) {
+        parsec_warning("Invalid received data cache size %d requested; cache disabled", parsec_param_recv_cache_size);
+        parsec_param_recv_cache_size = 0;
+    }
+    parsec_mca_param_reg_int_name("runtime", "comm_stats", "Collect per peer communication statistics (messages, bytes and latencies of the activations, data requests and data transfers, "
+                                  "and depth of their queues), available through parsec_context_query and reported when PaRSEC is finalized (1=true,0=false).",
+                                  false, false, parsec_param_comm_stats, &parsec_param_comm_stats);
 }
 
 int
@@ -523,6 +782,10 @@ remote_dep_dequeue_send(parsec_execution_stream_t* es, int rank,
     item->cmd.activate.task.callback_fn = 0;
     item->cmd.activate.task.remote_memory_handle = NULL; /* we don't have it yet */
     item->cmd.activate.task.remote_callback_data = (remote_dep_datakey_t)NULL;
+    if( NULL != remote_dep_stats ) {
+        item->timestamp = MPI_Wtime();
+        (void)parsec_atomic_fetch_inc_int32(&remote_dep_stats_pending_activations);
+    }
 
     /* if MPI is multithreaded do not thread-shift the send activate */
     if( parsec_comm_es.virtual_process->parsec_context->flags & PARSEC_CONTEXT_FLAG_COMM_MT ) {
@@ -542,6 +805,9 @@ void parsec_remote_dep_memcpy(parsec_execution_stream_t* es,
                               parsec_dep_data_description_t* data)
 {
     assert( dst );
+    /* The content of dst changes: a later send of dst must not be mistaken
+     * for the data previously sent by the receivers caching it */
+    dst->version++;
     /* if the communication engine supports multithread do the reshaping in place */
     if( parsec_ce.parsec_context->flags & PARSEC_CONTEXT_FLAG_COMM_MT ) {
         if( 0 == parsec_ce.reshape(&parsec_ce, es,
@@ -606,6 +872,186 @@ reshape_copy_allocate(parsec_dep_type_description_t* data)
     return dc;
 }
 
+/**
+ * Received data cache. The data retrieved from a peer is kept in a
+ * direct-mapped table, indexed by their identity on the source and by their
+ * local layout. A later activation carrying the same identity is then
+ * satisfied locally, without a new transfer. The cached copy is read-only:
+ * it is shared by reference with the local successors when none of them
+ * modifies the data, and copied (outside of the cache lock) for the ones that
+ * do. Likewise, a received copy is only duplicated on insertion when one of
+ * its local successors is about to modify it. Entries are scoped to a
+ * taskpool and dropped upon its termination, when they are replaced by
+ * another data, or when the arena they come from is running out of memory.
+ */
+typedef struct remote_dep_recv_cache_entry_s {
+    parsec_data_copy_t           *copy;          /**< the read-only copy, NULL for an empty entry */
+    uint32_t                      taskpool_id;
+    int                           from;
+    remote_dep_wire_data_id_t     id;
+    parsec_dep_type_description_t layout;        /**< the local layout of the copy */
+} remote_dep_recv_cache_entry_t;
+
+static remote_dep_recv_cache_entry_t *remote_dep_recv_cache = NULL;
+static parsec_atomic_lock_t remote_dep_recv_cache_lock = PARSEC_ATOMIC_UNLOCKED;
+
+/* Size of the identity of each data in the activation messages sent by this
+ * process. The receivers find out from the REMOTE_DEP_WIRE_DATA_IDS flag of
+ * the message, they do not depend on the local setting of the sender. */
+#define REMOTE_DEP_DATA_ID_SIZE ((parsec_param_recv_cache_size > 0) ? (int)sizeof(remote_dep_wire_data_id_t) : 0)
+
+/* Build the identity of an output on the source side. Only data belonging
+ * to a data collection can be identified, temporaries are never cached. */
+static inline void
+remote_dep_mpi_data_identify(struct remote_dep_output_param_s* output,
+                             remote_dep_wire_data_id_t* id)
+{
+    parsec_data_copy_t* copy = output->data.data;
+
+    memset(id, 0, sizeof(remote_dep_wire_data_id_t));
+    if( (NULL == copy) || (NULL == copy->original) || (NULL == copy->original->dc) )
+        return;
+#ifdef PARSEC_RESHAPE_BEFORE_SEND_TO_REMOTE
+    if( NULL != output->data.data_future )  /* the data sent is the result of a reshape */
+        return;
+#endif
+    id->data         = (uint64_t)(uintptr_t)copy->original;
+    id->src_datatype = (uint64_t)(uintptr_t)output->data.remote.src_datatype;
+    id->src_count    = output->data.remote.src_count;
+    id->src_displ    = output->data.remote.src_displ;
+    id->version      = copy->version;
+    id->valid        = 1;
+}
+
+static inline remote_dep_recv_cache_entry_t*
+remote_dep_recv_cache_slot(int from, const remote_dep_wire_data_id_t* id,
+                           const parsec_dep_type_description_t* layout)
+{
+    uint64_t h = id->data ^ ((uint64_t)id->version << 32) ^ ((uint64_t)from << 48);
+    h ^= id->src_datatype + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= (uint64_t)(uintptr_t)layout->dst_datatype + (h << 6) + (h >> 2);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return &remote_dep_recv_cache[h % (uint64_t)parsec_param_recv_cache_size];
+}
+
+static inline void
+remote_dep_recv_cache_drop(remote_dep_recv_cache_entry_t* entry)
+{
+    if( NULL != entry->copy ) {
+        PARSEC_DATA_COPY_RELEASE(entry->copy);
+        entry->copy = NULL;
+    }
+}
+
+/* Allocate a new copy with the given layout holding the content of src */
+static parsec_data_copy_t*
+remote_dep_recv_cache_clone(parsec_dep_type_description_t* layout,
+                            parsec_data_copy_t* src)
+{
+    parsec_data_copy_t* copy = parsec_arena_get_copy(layout->arena, layout->dst_count, 0, layout->dst_datatype);
+    if( NULL == copy )  /* the arena is exhausted */
+        return NULL;
+    copy->coherency_state = PARSEC_DATA_COHERENCY_EXCLUSIVE;
+    memcpy(copy->device_private, src->device_private,
+           layout->arena->elem_size * layout->dst_count);
+    return copy;
+}
+
+/* Return the cached output k of deps, or NULL. The cached copy itself is
+ * returned, retained, unless a local successor modifies the data */
+static parsec_data_copy_t*
+remote_dep_recv_cache_lookup(parsec_remote_deps_t* deps, int k)
+{
+    struct remote_dep_output_param_s* output = &deps->output[k];
+    parsec_dep_type_description_t* layout = &output->data.remote;
+    remote_dep_recv_cache_entry_t* entry;
+    parsec_data_copy_t* cached = NULL, *copy;
+
+    if( (NULL == remote_dep_recv_cache) || !output->data_id.valid ||
+        (PARSEC_TASKPOOL_TYPE_DTD == deps->taskpool->taskpool_type) )
+        return NULL;
+    parsec_atomic_lock(&remote_dep_recv_cache_lock);
+    entry = remote_dep_recv_cache_slot(deps->from, &output->data_id, layout);
+    if( (NULL != entry->copy) &&
+        (entry->taskpool_id == deps->taskpool->taskpool_id) && (entry->from == deps->from) &&
+        (0 == memcmp(&entry->id, &output->data_id, sizeof(remote_dep_wire_data_id_t))) &&
+        (entry->layout.arena == layout->arena) && (entry->layout.dst_datatype == layout->dst_datatype) &&
+        (entry->layout.dst_count == layout->dst_count) && (entry->layout.dst_displ == layout->dst_displ) ) {
+        cached = entry->copy;
+        PARSEC_OBJ_RETAIN(cached);
+    }
+    parsec_atomic_unlock(&remote_dep_recv_cache_lock);
+    if( (NULL == cached) || !output->written )
+        return cached;
+    /* copy on write: the cached copy remains untouched */
+    copy = remote_dep_recv_cache_clone(layout, cached);
+    PARSEC_DATA_COPY_RELEASE(cached);
+    return copy;
+}
+
+/* Drop the cached copies allocated from an arena close to its memory limit */
+static void
+remote_dep_recv_cache_reclaim(parsec_arena_t* arena)
+{
+    if( (NULL == remote_dep_recv_cache) || (NULL == arena) ||
+        (0 == arena->max_used) || (INT32_MAX == arena->max_used) ||
+        (arena->used < arena->max_used - arena->max_used / 4) )
+        return;
+    parsec_atomic_lock(&remote_dep_recv_cache_lock);
+    for( int i = 0; i < parsec_param_recv_cache_size; i++ ) {
+        if( remote_dep_recv_cache[i].layout.arena == arena )
+            remote_dep_recv_cache_drop(&remote_dep_recv_cache[i]);
+    }
+    parsec_atomic_unlock(&remote_dep_recv_cache_lock);
+}
+
+/* Keep the freshly received output k of deps. It is shared with the local
+ * successors, unless one of them modifies it: the cache then keeps a copy
+ * made before any local successor had a chance to do so */
+static void
+remote_dep_recv_cache_insert(parsec_remote_deps_t* deps, int k)
+{
+    struct remote_dep_output_param_s* output = &deps->output[k];
+    remote_dep_recv_cache_entry_t* entry;
+    parsec_data_copy_t* copy;
+
+    if( (NULL == remote_dep_recv_cache) || !output->data_id.valid || (NULL == output->data.data) ||
+        (PARSEC_TASKPOOL_TYPE_DTD == deps->taskpool->taskpool_type) )
+        return;
+    remote_dep_recv_cache_reclaim(output->data.remote.arena);
+    if( !output->written ) {
+        copy = output->data.data;
+        PARSEC_OBJ_RETAIN(copy);
+    } else if( NULL == (copy = remote_dep_recv_cache_clone(&output->data.remote, output->data.data)) )
+        return;
+    parsec_atomic_lock(&remote_dep_recv_cache_lock);
+    entry = remote_dep_recv_cache_slot(deps->from, &output->data_id, &output->data.remote);
+    remote_dep_recv_cache_drop(entry);
+    entry->copy         = copy;
+    entry->taskpool_id  = deps->taskpool->taskpool_id;
+    entry->from         = deps->from;
+    entry->id           = output->data_id;
+    entry->layout       = output->data.remote;
+    parsec_atomic_unlock(&remote_dep_recv_cache_lock);
+}
+
+/* Release all the cached data of a taskpool, or of all taskpools if tp is NULL */
+int
+remote_dep_dequeue_taskpool_fini(parsec_taskpool_t* tp)
+{
+    if( NULL == remote_dep_recv_cache )
+        return PARSEC_SUCCESS;
+    parsec_atomic_lock(&remote_dep_recv_cache_lock);
+    for( int i = 0; i < parsec_param_recv_cache_size; i++ ) {
+        if( (NULL == tp) || (remote_dep_recv_cache[i].taskpool_id == tp->taskpool_id) )
+            remote_dep_recv_cache_drop(&remote_dep_recv_cache[i]);
+    }
+    parsec_atomic_unlock(&remote_dep_recv_cache_lock);
+    return PARSEC_SUCCESS;
+}
+
 /**
  *
  * Routine to fulfilled a reshape promise by the current thread
@@ -740,6 +1186,10 @@ remote_dep_mpi_retrieve_datatype(parsec_execution_stream_t *eu,
 
     parsec_datatype_t old_dtt = output->data.remote.dst_datatype;
 
+    /* The received data is shared with the successors that only read it */
+    if( dep->flow->flow_flags & PARSEC_FLOW_ACCESS_WRITE )
+        output->written = 1;
+
     /* Extract the datatype, count and displacement from the target task */
 
     fct->get_datatype(eu, newcontext, oldcontext, &flow_mask, &output->data);
@@ -793,6 +1243,7 @@ remote_dep_mpi_retrieve_datatype(parsec_execution_stream_t *eu,
             parsec_ce.pack_size(&parsec_ce, output->data.remote.dst_count, output->data.remote.dst_datatype, &dsize);
             output->data.remote.src_count = output->data.remote.dst_count = dsize;
             output->data.remote.src_datatype = output->data.remote.dst_datatype = PARSEC_DATATYPE_PACKED;
+            output->written = 1;  /* the remaining successors are not visited */
 
             return PARSEC_ITERATE_STOP;
         }
@@ -886,6 +1337,7 @@ remote_dep_get_datatypes(parsec_execution_stream_t* es,
             PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI:\tRetrieve datatype with mask 0x%x (remote_dep_get_datatypes)", (1U<<k));
             origin->msg.task_class_id = dtd_task->super.task_class->task_class_id;
             origin->output[k].data.remote.src_datatype = origin->output[k].data.remote.dst_datatype = PARSEC_DATATYPE_NULL;
+            origin->output[k].written = 0;
             dtd_task->super.task_class->iterate_successors(es, (parsec_task_t *)dtd_task,
                                                (1U<<k),
                                                remote_dep_mpi_retrieve_datatype,
@@ -922,6 +1374,7 @@ remote_dep_get_datatypes(parsec_execution_stream_t* es,
             }
 
             origin->output[k].data.remote.src_datatype = origin->output[k].data.remote.dst_datatype = PARSEC_DATATYPE_NULL;
+            origin->output[k].written = 0;
             assert(idx <= data_sizes[0]);
             origin->output[k].data.remote.src_count = data_sizes[idx+1];
             PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream,
@@ -1277,6 +1730,8 @@ static int remote_dep_mpi_pack_dep(int peer,
     remote_dep_wire_activate_t* msg = &deps->msg;
     int k, dsize, data_idx, saved_position = *position;
     uint32_t peer_bank, peer_bit, peer_mask, expected = 0, *data_sizes;
+    remote_dep_wire_data_id_t data_id;
+    char *data_ids;
 #if defined(PARSEC_DEBUG) || defined(PARSEC_DEBUG_NOISIER)
     char tmp[MAX_TASK_STRLEN];
     remote_dep_cmd_to_string(&deps->msg, tmp, 128);
@@ -1295,12 +1750,14 @@ static int remote_dep_mpi_pack_dep(int peer,
         if( !(deps->output[k].rank_bits[peer_bank] & peer_mask) ) continue;
         data_idx++;
     }
-    if( (length - (*position)) < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)) ) {  /* no room. bail out */
+    if( (length - (*position)) < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)
+                                  + data_idx * REMOTE_DEP_DATA_ID_SIZE) ) {  /* no room. bail out */
         PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "Can't pack at %d/%d. Bail out!", *position, length);
-        if( length < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)) ) {
+        if( length < (dsize + (data_idx + 1) * (int)sizeof(uint32_t)
+                      + data_idx * REMOTE_DEP_DATA_ID_SIZE) ) {
             parsec_fatal("The header plus data cannot be sent on a single message "
                          "(need %zd but have %zd)\n",
-                         length, dsize + data_idx * sizeof(uint32_t));
+                         length, dsize + data_idx * (sizeof(uint32_t) + REMOTE_DEP_DATA_ID_SIZE));
         }
         return 1;
     }
@@ -1309,11 +1766,16 @@ static int remote_dep_mpi_pack_dep(int peer,
     data_sizes = (uint32_t*)(packed_buffer + *position);
     assert(0 == (((uintptr_t)data_sizes) & (sizeof(uint32_t)-1)));
     data_sizes[0] = data_idx;  /* save the total number of data */
+    /* the identity of each data follows their sizes, when the receivers cache them */
+    data_ids = (char*)(data_sizes + data_idx + 1);
+    memset(data_ids, 0, data_idx * REMOTE_DEP_DATA_ID_SIZE);
     assert((0 != msg->output_mask) &&   /* this should be preset */
            (msg->output_mask & deps->outgoing_mask) == deps->outgoing_mask);
     /* update the length of the message */
     msg->length  = deps->taskpool->tdm.module->outgoing_message_piggyback_size;
     msg->length += (data_idx + 1) * (uint32_t)sizeof(uint32_t);
+    msg->length += data_idx * (uint32_t)REMOTE_DEP_DATA_ID_SIZE;
+    msg->flags   = (0 != REMOTE_DEP_DATA_ID_SIZE) ? REMOTE_DEP_WIRE_DATA_IDS : 0;
     *position += msg->length;
     item->cmd.activate.task.output_mask = 0;  /* clean start */
     /* Treat for special cases: CTL, Short, etc... */
@@ -1341,6 +1803,10 @@ static int remote_dep_mpi_pack_dep(int peer,
         assert(type_desc->src_count > 0);
         /* Embed data (up to short size) with the activate msg */
         parsec_ce.pack_size( &parsec_ce, type_desc->src_count, type_desc->src_datatype, &dsize);
+        if( 0 != REMOTE_DEP_DATA_ID_SIZE ) {
+            remote_dep_mpi_data_identify(&deps->output[k], &data_id);
+            memcpy(data_ids + (data_idx - 1) * sizeof(remote_dep_wire_data_id_t), &data_id, sizeof(remote_dep_wire_data_id_t));
+        }
         data_sizes[data_idx++] = dsize;
 #ifdef PARSEC_RESHAPE_BEFORE_SEND_TO_REMOTE
         /* If we want to reshape before sending, we don't do short messages. */
@@ -1501,12 +1967,19 @@ static int remote_dep_nothread_send(parsec_execution_stream_t* es,
     parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG, peer, packed_buffer, position);
     TAKE_TIME(es->es_profile, MPI_Activate_ek, 0);
     DEBUG_MARK_CTL_MSG_ACTIVATE_SENT(peer, (void*)&deps->msg, &deps->msg);
+    remote_dep_stats_count(peer, PARSEC_COMM_PROTOCOL_ACTIVATE, 1, position);
 
     do {
         item = (dep_cmd_item_t*)ring;
         ring = parsec_list_item_ring_chop(ring);
         deps = (parsec_remote_deps_t*)item->cmd.activate.task.source_deps;
 
+        if( NULL != remote_dep_stats ) {
+            remote_dep_stats_depth(PARSEC_COMM_PROTOCOL_ACTIVATE,
+                                   parsec_atomic_fetch_dec_int32(&remote_dep_stats_pending_activations) - 1);
+            remote_dep_stats_latency(peer, PARSEC_COMM_PROTOCOL_ACTIVATE, item->timestamp);
+        }
+
         free(item);  /* only large messages are left */
 
         remote_dep_complete_and_cleanup(&deps, 1);
@@ -1563,6 +2036,8 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     PARSEC_OBJ_CONSTRUCT(&item->super, parsec_list_item_t);
     item->action = DEP_GET_DATA;
     item->cmd.activate.peer = src;
+    remote_dep_stats_count(src, PARSEC_COMM_PROTOCOL_GET, 0, msg_size);
+    if( NULL != remote_dep_stats ) item->timestamp = MPI_Wtime();
 
     task = &(item->cmd.activate.task);
     /* copy the static part of the message, the part after this contains the memory_handle
@@ -1573,6 +2048,20 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     /* we are expecting exactly one wire_get_t + remote memory handle */
     assert(msg_size == sizeof(remote_dep_wire_get_t) + ce->get_mem_handle_size());
 
+    if( task->cached ) {
+        /* The receiver already holds these data, release them without any transfer */
+        deps = (parsec_remote_deps_t*)(remote_dep_datakey_t)task->source_deps;
+        PARSEC_DEBUG_VERBOSE(6, parsec_debug_output, "MPI: Put cached for %s from %d which 0x%x (deps %p)",
+                remote_dep_cmd_to_string(&deps->msg, tmp, MAX_TASK_STRLEN), src,
+                task->output_mask, (void*)deps);
+        int k, ncompleted = 0;
+        for(k = 0; task->output_mask >> k; k++)
+            if( (1U<<k) & task->output_mask ) ncompleted++;
+        free(item);
+        remote_dep_complete_and_cleanup(&deps, ncompleted);
+        return 1;
+    }
+
     item->cmd.activate.remote_memory_handle = malloc(ce->get_mem_handle_size());
     memcpy( item->cmd.activate.remote_memory_handle,
             ((char*)msg) + sizeof(remote_dep_wire_get_t),
@@ -1583,6 +2072,14 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     assert(0 != deps->outgoing_mask);
     item->priority = deps->max_priority;
 
+    /* Each fragment of a pipelined transfer, except the last, holds its own
+     * reference on the deps. The last fragment is only requested once all the
+     * others have been delivered, and it consumes the reference accounted for
+     * the entire data when the activation was sent.
+     */
+    if( (0 != task->frag_length) && !task->frag_last )
+        (void)parsec_atomic_fetch_inc_int32(&deps->pending_ack);
+
     PARSEC_DEBUG_VERBOSE(6, parsec_debug_output, "MPI: Put cb_received for %s from %d tag %u which 0x%x (deps %p)",
                 remote_dep_cmd_to_string(&deps->msg, tmp, MAX_TASK_STRLEN), item->cmd.activate.peer,
                 -1, task->output_mask, (void*)deps);
@@ -1600,6 +2097,182 @@ remote_dep_mpi_save_put_cb(parsec_comm_engine_t *ce,
     return 1;
 }
 
+/**
+ * Return 1 if the elements of the datatype are laid out densely in memory,
+ * in which case the packed representation of the data is the memory region
+ * itself and can be transferred by slices.
+ */
+static int
+remote_dep_mpi_layout_is_dense(parsec_datatype_t dtt)
+{
+    ptrdiff_t lb, extent;
+    int size;
+
+    parsec_type_size(dtt, &size);
+    parsec_type_extent(dtt, &lb, &extent);
+    return (0 == lb) && ((ptrdiff_t)size == extent);
+}
+
+/**
+ * Register a contiguous memory region of length bytes with the communication
+ * engine.
+ */
+static void
+remote_dep_mpi_register_bytes(void *ptr, size_t length,
+                              parsec_ce_mem_reg_handle_t *handle,
+                              size_t *handle_size)
+{
+    if(parsec_ce.capabilites.supports_noncontiguous_datatype) {
+        parsec_ce.mem_register(ptr, PARSEC_MEM_TYPE_NONCONTIGUOUS,
+                               length, parsec_datatype_uint8_t,
+                               -1,
+                               handle, handle_size);
+    } else {
+        parsec_ce.mem_register(ptr, PARSEC_MEM_TYPE_CONTIGUOUS,
+                               -1, parsec_datatype_uint8_t,
+                               length,
+                               handle, handle_size);
+    }
+}
+
+/**
+ * A datatype flattened into the list of the contiguous blocks it spans, each
+ * annotated with its position in the packed representation of the data, such
+ * that any slice of the packed representation can be described in place.
+ * Allocated as a single block.
+ */
+typedef struct remote_dep_layout_s {
+    int             niov;
+    parsec_iovec_t *iov;
+    size_t         *packed;  /**< position of each block in the packed representation */
+} remote_dep_layout_t;
+
+/**
+ * Flatten count elements of the datatype dtt, or return NULL if the datatype
+ * cannot be flattened or the communication engine cannot transfer the
+ * resulting non-contiguous slices.
+ */
+static remote_dep_layout_t*
+remote_dep_mpi_layout_flatten(parsec_datatype_t dtt, uint64_t count)
+{
+    remote_dep_layout_t* layout;
+    parsec_iovec_t* iov;
+    size_t position = 0;
+    int niov;
+
+    if( !parsec_ce.capabilites.supports_noncontiguous_datatype ||
+        (count > INT_MAX) || (parsec_param_pipeline_frag_size > INT_MAX) )
+        return NULL;
+    if( PARSEC_SUCCESS != parsec_type_flatten(dtt, (int)count, &iov, &niov) )
+        return NULL;
+    layout = (remote_dep_layout_t*)malloc(sizeof(remote_dep_layout_t) +
+                                          niov * (sizeof(parsec_iovec_t) + sizeof(size_t)));
+    layout->niov   = niov;
+    layout->iov    = (parsec_iovec_t*)(layout + 1);
+    layout->packed = (size_t*)(layout->iov + niov);
+    for( int i = 0; i < niov; i++ ) {
+        layout->iov[i]    = iov[i];
+        layout->packed[i] = position;
+        position += iov[i].length;
+    }
+    free(iov);
+    return layout;
+}
+
+/**
+ * Register with the communication engine, in place, the slice [offset,
+ * offset+length) of the packed representation of a data with the given
+ * layout located at base.
+ *
+ * @return the datatype describing the slice, to be released once the transfer
+ * completes, or PARSEC_DATATYPE_NULL if the slice is contiguous.
+ */
+static parsec_datatype_t
+remote_dep_mpi_register_slice(char* base, const remote_dep_layout_t* layout,
+                              size_t offset, size_t length,
+                              parsec_ce_mem_reg_handle_t *handle,
+                              size_t *handle_size)
+{
+    size_t end = offset + length;
+    int lo = 0, hi = layout->niov - 1, n, *blocklens;
+    ptrdiff_t* displs;
+    parsec_datatype_t dtt;
+
+    while( lo < hi ) {  /* the last block starting at or before offset */
+        int mid = (lo + hi + 1) / 2;
+        if( layout->packed[mid] <= offset ) lo = mid;
+        else hi = mid - 1;
+    }
+    for( n = 1; (lo + n < layout->niov) && (layout->packed[lo + n] < end); n++ ) ;
+    if( 1 == n ) {
+        remote_dep_mpi_register_bytes(base + layout->iov[lo].displ + (offset - layout->packed[lo]), length,
+                                      handle, handle_size);
+        return PARSEC_DATATYPE_NULL;
+    }
+
+    blocklens = (int*)malloc(n * sizeof(int));
+    displs    = (ptrdiff_t*)malloc(n * sizeof(ptrdiff_t));
+    for( int i = 0; i < n; i++ ) {
+        size_t first = layout->packed[lo + i], last = first + layout->iov[lo + i].length;
+        if( first < offset ) first = offset;
+        if( last > end ) last = end;
+        displs[i]    = layout->iov[lo + i].displ + (ptrdiff_t)(first - layout->packed[lo + i]);
+        blocklens[i] = (int)(last - first);
+    }
+    parsec_type_create_hindexed(n, blocklens, displs, parsec_datatype_uint8_t, &dtt);
+    free(blocklens);
+    free(displs);
+    parsec_ce.mem_register(base, PARSEC_MEM_TYPE_NONCONTIGUOUS,
+                           1, dtt,
+                           -1,
+                           handle, handle_size);
+    return dtt;
+}
+
+/**
+ * Register the fragment [offset, offset+length) of the packed representation
+ * of the output k. Dense data are served directly from the data copy, and the
+ * layouts that can be flattened are described in place. All others are packed
+ * once in a buffer shared by all the peers retrieving this output, and
+ * released with the deps.
+ *
+ * @return the datatype to release once the fragment is sent, or
+ * PARSEC_DATATYPE_NULL.
+ */
+static parsec_datatype_t
+remote_dep_mpi_pipeline_register_source(parsec_remote_deps_t* deps,
+                                        int k, uint64_t offset, size_t length,
+                                        parsec_ce_mem_reg_handle_t *handle,
+                                        size_t *handle_size)
+{
+    struct remote_dep_output_param_s* output = &deps->output[k];
+    parsec_dep_type_description_t* type_desc = &output->data.remote;
+    char* dataptr = (char*)PARSEC_DATA_COPY_GET_PTR(output->data.data) + type_desc->src_displ;
+
+    if( remote_dep_mpi_layout_is_dense(type_desc->src_datatype) ) {
+        remote_dep_mpi_register_bytes(dataptr + offset, length, handle, handle_size);
+        return PARSEC_DATATYPE_NULL;
+    }
+
+    if( (NULL == output->pipeline_buffer) && (NULL == output->pipeline_layout) ) {
+        output->pipeline_layout = remote_dep_mpi_layout_flatten(type_desc->src_datatype, type_desc->src_count);
+        if( NULL == output->pipeline_layout ) {
+            int dsize, position = 0;
+            parsec_ce.pack_size(&parsec_ce, type_desc->src_count, type_desc->src_datatype, &dsize);
+            output->pipeline_buffer = malloc(dsize);
+            parsec_ce.pack(&parsec_ce, dataptr, type_desc->src_count, type_desc->src_datatype,
+                           output->pipeline_buffer, dsize, &position);
+            PARSEC_DEBUG_VERBOSE(20, parsec_comm_output_stream, "MPI:\tPacked %d bytes of deps %p[%d] for a pipelined transfer",
+                                 dsize, deps, k);
+        }
+    }
+    if( NULL != output->pipeline_layout )
+        return remote_dep_mpi_register_slice(dataptr, output->pipeline_layout, offset, length,
+                                             handle, handle_size);
+    remote_dep_mpi_register_bytes((char*)output->pipeline_buffer + offset, length, handle, handle_size);
+    return PARSEC_DATATYPE_NULL;
+}
+
 static void
 remote_dep_mpi_put_start(parsec_execution_stream_t* es,
                          dep_cmd_item_t* item)
@@ -1682,8 +2355,15 @@ remote_dep_mpi_put_start(parsec_execution_stream_t* es,
 
         parsec_ce_mem_reg_handle_t source_memory_handle;
         size_t source_memory_handle_size;
-
-        if(parsec_ce.capabilites.supports_noncontiguous_datatype) {
+        parsec_datatype_t fragment_type = PARSEC_DATATYPE_NULL;
+
+        if( 0 != task->frag_length ) {
+            /* a fragment of a pipelined transfer: serve a slice of the packed data */
+            fragment_type = remote_dep_mpi_pipeline_register_source(deps, k, task->frag_offset, task->frag_length,
+                                                                    &source_memory_handle, &source_memory_handle_size);
+            dtt     = parsec_datatype_uint8_t;
+            nbdtt   = task->frag_length;
+        } else if(parsec_ce.capabilites.supports_noncontiguous_datatype) {
             parsec_ce.mem_register(dataptr, PARSEC_MEM_TYPE_NONCONTIGUOUS,
                                    nbdtt, dtt,
                                    -1,
@@ -1711,8 +2391,18 @@ remote_dep_mpi_put_start(parsec_execution_stream_t* es,
 
         remote_dep_cb_data_t *cb_data = (remote_dep_cb_data_t *) parsec_thread_mempool_allocate
                                             (parsec_remote_dep_cb_data_mempool->thread_mempools);
-        cb_data->deps  = deps;
-        cb_data->k     = k;
+        cb_data->deps     = deps;
+        cb_data->k        = k;
+        cb_data->pipeline = NULL;
+        cb_data->fragment_type = fragment_type;
+        cb_data->peer     = item->cmd.activate.peer;
+        if( NULL != remote_dep_stats ) {
+            int dtt_size;
+            parsec_type_size(dtt, &dtt_size);
+            cb_data->bytes = (size_t)dtt_size * nbdtt;
+            cb_data->start = item->timestamp;
+            remote_dep_stats_depth(PARSEC_COMM_PROTOCOL_PUT, parsec_comm_puts);
+        }
 
 #if defined(PARSEC_PROF_TRACE)
         uint64_t event_id = remote_dep_mpi_profiling_event_id();
@@ -1763,9 +2453,17 @@ remote_dep_mpi_put_end_cb(parsec_comm_engine_t *ce,
               ((remote_dep_cb_data_t *)cb_data)->event_id);
 #endif /* PARSEC_PROF_TRACE */
 
+    if( NULL != remote_dep_stats ) {
+        remote_dep_cb_data_t* data = (remote_dep_cb_data_t*)cb_data;
+        remote_dep_stats_count(data->peer, PARSEC_COMM_PROTOCOL_PUT, 1, data->bytes);
+        remote_dep_stats_latency(data->peer, PARSEC_COMM_PROTOCOL_PUT, data->start);
+    }
+
     remote_dep_complete_and_cleanup(&deps, 1);
 
     ce->mem_unregister(&lreg);
+    if( PARSEC_DATATYPE_NULL != ((remote_dep_cb_data_t *)cb_data)->fragment_type )
+        parsec_type_free(&((remote_dep_cb_data_t *)cb_data)->fragment_type);
     parsec_thread_mempool_free(parsec_remote_dep_cb_data_mempool->thread_mempools, cb_data);
 
     parsec_comm_puts--;
@@ -1773,6 +2471,25 @@ remote_dep_mpi_put_end_cb(parsec_comm_engine_t *ce,
 }
 
 
+/**
+ * Let the source know that the data in mask are already available locally,
+ * such that it can release them without any transfer.
+ */
+static void
+remote_dep_mpi_send_cached(parsec_remote_deps_t* deps,
+                           remote_dep_datakey_t mask)
+{
+    int buf_size = sizeof(remote_dep_wire_get_t) + parsec_ce.get_mem_handle_size();
+    remote_dep_wire_get_t* msg = (remote_dep_wire_get_t*)calloc(1, buf_size);
+
+    msg->source_deps = deps->msg.deps;
+    msg->output_mask = mask;
+    msg->cached      = 1;
+    parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_GET_DATA_TAG, deps->from, msg, buf_size);
+    remote_dep_stats_count(deps->from, PARSEC_COMM_PROTOCOL_GET, 1, buf_size);
+    free(msg);
+}
+
 /**
  * An activation message has been received, and the remote_dep_wire_activate_t
  * part has already been extracted into the deps->msg. This function handles the
@@ -1788,9 +2505,12 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
 {
     (void) length; (void) position;
     (void) packed_buffer;
-    remote_dep_datakey_t complete_mask = 0;
+    remote_dep_datakey_t complete_mask = 0, cached_mask = 0;
     int k, dsize, ds_idx;
     uint32_t *data_sizes = (uint32_t*)(packed_buffer + *position);
+    /* the identities of the data are present only if the source sent them */
+    uint32_t data_id_size = (deps->msg.flags & REMOTE_DEP_WIRE_DATA_IDS) ? (uint32_t)sizeof(remote_dep_wire_data_id_t) : 0;
+    char *data_ids;
 #if defined(PARSEC_DEBUG) || defined(PARSEC_DEBUG_NOISIER)
     char tmp[MAX_TASK_STRLEN];
     remote_dep_cmd_to_string(&deps->msg, tmp, MAX_TASK_STRLEN);
@@ -1806,8 +2526,10 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
     deps->taskpool->tdm.module->incoming_message_start(deps->taskpool, deps->from, packed_buffer, position,
                                                        length, deps);
 
-    /* move the position after the data sizes */
+    /* move the position after the data sizes and identities */
     *position += (data_sizes[0] + 1) * (uint32_t)sizeof(uint32_t);
+    data_ids = packed_buffer + *position;
+    *position += data_sizes[0] * data_id_size;
     ds_idx = 0;
 
     for(k = 0; deps->incoming_mask>>k; k++) {
@@ -1825,6 +2547,12 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
         }
 
         ds_idx++;
+        deps->output[k].src_size = data_sizes[ds_idx];
+        if( 0 != data_id_size )
+            memcpy(&deps->output[k].data_id, data_ids + (ds_idx - 1) * data_id_size,
+                   sizeof(remote_dep_wire_data_id_t));
+        else
+            deps->output[k].data_id.valid = 0;
 
         if( parsec_param_short_limit && (length > *position) ) {
             parsec_ce.pack_size( &parsec_ce, 1, type_desc->dst_datatype, &dsize);  /* for a single type */
@@ -1870,12 +2598,24 @@ static void remote_dep_mpi_recv_activate(parsec_execution_stream_t* es,
                 continue;
             }
         }
+        /* The same data might have already been received from this peer */
+        if( NULL != (data_desc->data = remote_dep_recv_cache_lookup(deps, k)) ) {
+            PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "MPI:\tFROM\t%d\tGet CACHED\t% -8s\tk=%d\twith datakey %lx at %p",
+                                 deps->from, tmp, k, deps->msg.deps, data_desc->data);
+            complete_mask |= (1U<<k);
+            cached_mask |= (1U<<k);
+            continue;
+        }
         PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "MPI:\tFROM\t%d\tGet DATA\t% -8s\tk=%d\twith datakey %lx (to be posted)",
                              deps->from, tmp, k, deps->msg.deps);
     }
 
     assert(length == *position);
 
+    /* The source must not wait for the data satisfied by the cache */
+    if(cached_mask)
+        remote_dep_mpi_send_cached(deps, cached_mask);
+
     /* Release all the already satisfied deps without posting the RDV */
     if(complete_mask) {
 #if defined(PARSEC_DEBUG_NOISIER)
@@ -1917,6 +2657,7 @@ remote_dep_mpi_save_activate_cb(parsec_comm_engine_t *ce, parsec_ce_tag_t tag,
     int position = 0, length = msg_size, rc;
     parsec_remote_deps_t* deps = NULL;
 
+    remote_dep_stats_count(src, PARSEC_COMM_PROTOCOL_ACTIVATE, 0, msg_size);
     while(position < length) {
         deps = remote_deps_allocate(&parsec_remote_dep_context.freelist);
 
@@ -2039,11 +2780,246 @@ remote_dep_mpi_release_delayed_deps(parsec_execution_stream_t* es,
     PARSEC_PINS(es, ACTIVATE_CB_END, NULL);
 }
 
+/**
+ * Send to the source of deps the request to put the data described by msg in
+ * the memory registered by the receiver in callback_data->memory_handle. The
+ * callback data is forwarded back to us upon completion of the transfer.
+ */
+static void
+remote_dep_mpi_send_get_request(parsec_execution_stream_t* es,
+                                parsec_remote_deps_t* deps,
+                                remote_dep_wire_get_t* msg,
+                                remote_dep_cb_data_t* callback_data,
+                                size_t receiver_memory_handle_size,
+                                int nbdtt, parsec_datatype_t dtt)
+{
+    remote_dep_wire_activate_t* task = &(deps->msg);
+    int from = deps->from;
+
+    /* We need multiple information to be passed to the callback_fn we have assigned above.
+     * We pack the pointer to this callback_data and pass to the other side so we can complete
+     * cleanup and take necessary action when the data is available on our side */
+    msg->remote_callback_data = (remote_dep_datakey_t)callback_data;
+
+    /* We pack the static message(remote_dep_wire_get_t) and our memory_handle and send this message
+     * to the source. Source is anticipating this exact configuration.
+     */
+    int buf_size = sizeof(remote_dep_wire_get_t) + receiver_memory_handle_size;
+    void *buf = malloc(buf_size);
+    memcpy( buf,
+            msg,
+            sizeof(remote_dep_wire_get_t) );
+    memcpy( ((char*)buf) +  sizeof(remote_dep_wire_get_t),
+            callback_data->memory_handle,
+            receiver_memory_handle_size );
+
+#if defined(PARSEC_PROF_TRACE)
+    uint64_t event_id = remote_dep_mpi_profiling_event_id();
+    callback_data->event_id = event_id;
+#endif /* PARSEC_PROF_TRACE */
+
+    /* Send AM */
+    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Data_pldr_sk, event_id, callback_data->k,
+                        from, es->virtual_process->parsec_context->my_rank,
+                        *task, nbdtt, dtt);
+    TAKE_TIME_WITH_INFO(es->es_profile, MPI_Data_ctl_sk, event_id, callback_data->k,
+                        from, es->virtual_process->parsec_context->my_rank,
+                        *task, nbdtt, dtt);
+    if( NULL != remote_dep_stats ) {
+        int dtt_size;
+        parsec_type_size(dtt, &dtt_size);
+        callback_data->peer  = from;
+        callback_data->bytes = (size_t)dtt_size * nbdtt;
+        callback_data->start = MPI_Wtime();
+        remote_dep_stats_depth(PARSEC_COMM_PROTOCOL_GET, parsec_comm_gets);
+    }
+    parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_GET_DATA_TAG, from, buf, buf_size);
+    TAKE_TIME(es->es_profile, MPI_Data_ctl_ek, event_id);
+    remote_dep_stats_count(from, PARSEC_COMM_PROTOCOL_GET, 1, buf_size);
+
+    free(buf);
+    (void)es; (void)task; (void)nbdtt; (void)dtt;
+
+    parsec_comm_gets++;
+}
+
+/**
+ * Request as many fragments of a pipelined transfer as allowed by the pipeline
+ * depth. The last fragment is only requested once all the others have been
+ * received, allowing the source to release its resources upon its completion.
+ */
+static void
+remote_dep_mpi_pipeline_post(parsec_execution_stream_t* es,
+                             remote_dep_pipeline_t* pipeline)
+{
+    parsec_remote_deps_t* deps = pipeline->deps;
+    remote_dep_wire_get_t msg;
+
+    msg.source_deps = deps->msg.deps;
+    msg.callback_fn = (uintptr_t)remote_dep_mpi_get_end_cb;
+    msg.output_mask = (1U << pipeline->k);
+    msg.remote_memory_handle = NULL;
+    msg.cached = 0;
+
+    while( (pipeline->inflight < (uint32_t)parsec_param_pipeline_depth) &&
+           (pipeline->next_frag < pipeline->nb_frags) ) {
+        uint32_t frag = pipeline->next_frag;
+        size_t offset = (size_t)frag * pipeline->frag_size;
+        size_t length = pipeline->length - offset;
+        size_t receiver_memory_handle_size;
+
+        if( length > pipeline->frag_size ) length = pipeline->frag_size;
+        msg.frag_last = (frag == (pipeline->nb_frags - 1));
+        if( msg.frag_last && (pipeline->done_count != frag) )
+            break;  /* wait for all the other fragments */
+        msg.frag_offset = offset;
+        msg.frag_length = (uint32_t)length;
+
+        remote_dep_cb_data_t *callback_data = (remote_dep_cb_data_t *) parsec_thread_mempool_allocate
+                                                    (parsec_remote_dep_cb_data_mempool->thread_mempools);
+        callback_data->deps     = deps;
+        callback_data->k        = pipeline->k;
+        callback_data->pipeline = pipeline;
+        callback_data->frag     = frag;
+        callback_data->fragment_type = PARSEC_DATATYPE_NULL;
+        if( NULL != pipeline->layout )
+            callback_data->fragment_type = remote_dep_mpi_register_slice(pipeline->buffer, pipeline->layout, offset, length,
+                                                                         &callback_data->memory_handle, &receiver_memory_handle_size);
+        else
+            remote_dep_mpi_register_bytes(pipeline->buffer + offset, length,
+                                          &callback_data->memory_handle, &receiver_memory_handle_size);
+
+        PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "MPI:\tTO\t%d\tGet FRAG\tk=%d\tfragment %u/%u [%zu:%zu] with datakey %lx",
+                             deps->from, pipeline->k, frag, pipeline->nb_frags, offset, offset + length, deps->msg.deps);
+
+        pipeline->next_frag++;
+        pipeline->inflight++;
+        remote_dep_mpi_send_get_request(es, deps, &msg, callback_data, receiver_memory_handle_size,
+                                        (int)length, parsec_datatype_uint8_t);
+    }
+}
+
+/**
+ * Start a pipelined transfer for the output k of deps if the data is larger
+ * than the pipeline fragment size.
+ *
+ * @return 1 if the transfer is handled by the pipeline, 0 otherwise.
+ */
+static int
+remote_dep_mpi_pipeline_start(parsec_execution_stream_t* es,
+                              parsec_remote_deps_t* deps,
+                              int k)
+{
+    parsec_dep_type_description_t* type_desc = &deps->output[k].data.remote;
+    remote_dep_pipeline_t* pipeline;
+    size_t length;
+    int staged, dsize;
+
+    if( 0 == parsec_param_pipeline_frag_size )
+        return 0;
+
+    /* The fragments are slices of the packed representation of the source,
+     * whose size is only known from the sender: the destination layout can
+     * describe more (or fewer) bytes. */
+    length = deps->output[k].src_size;
+    if( length <= parsec_param_pipeline_frag_size )
+        return 0;
+    parsec_ce.pack_size(&parsec_ce, type_desc->dst_count, type_desc->dst_datatype, &dsize);
+    staged = !remote_dep_mpi_layout_is_dense(type_desc->dst_datatype) || ((size_t)dsize != length);
+
+    pipeline = (remote_dep_pipeline_t*)calloc(1, sizeof(remote_dep_pipeline_t));
+    pipeline->deps      = deps;
+    pipeline->k         = k;
+    pipeline->staged    = staged;
+    pipeline->length    = length;
+    pipeline->frag_size = parsec_param_pipeline_frag_size;
+    pipeline->nb_frags  = (uint32_t)((length + pipeline->frag_size - 1) / pipeline->frag_size);
+    pipeline->done      = (uint8_t*)calloc(pipeline->nb_frags, sizeof(uint8_t));
+    /* Let the fragments land in place in a non-dense destination when possible */
+    if( staged && ((size_t)dsize == length) &&
+        (NULL != (pipeline->layout = remote_dep_mpi_layout_flatten(type_desc->dst_datatype, type_desc->dst_count))) )
+        pipeline->staged = staged = 0;
+    if( staged )
+        pipeline->buffer = (char*)malloc(length);
+    else
+        pipeline->buffer = (char*)PARSEC_DATA_COPY_GET_PTR(deps->output[k].data.data) + type_desc->dst_displ;
+
+    PARSEC_DEBUG_VERBOSE(10, parsec_comm_output_stream, "MPI:\tFROM\t%d\tGet PIPELINE\tk=%d\t%zu bytes in %u fragments (%s)",
+                         deps->from, k, length, pipeline->nb_frags, staged ? "staged" : "in place");
+    remote_dep_mpi_pipeline_post(es, pipeline);
+    return 1;
+}
+
+/**
+ * Unpack into the destination all the entire elements of the destination
+ * datatype covered by the prefix of the data already received.
+ */
+static void
+remote_dep_mpi_pipeline_unpack(remote_dep_pipeline_t* pipeline)
+{
+    parsec_remote_deps_t* deps = pipeline->deps;
+    parsec_dep_type_description_t* type_desc = &deps->output[pipeline->k].data.remote;
+    uint64_t count;
+    ptrdiff_t lb, extent;
+    int esize;
+
+    if( pipeline->done_prefix == pipeline->nb_frags ) {
+        count = type_desc->dst_count;
+    } else {
+        parsec_ce.pack_size(&parsec_ce, 1, type_desc->dst_datatype, &esize);
+        count = ((size_t)pipeline->done_prefix * pipeline->frag_size) / esize;
+        if( count > type_desc->dst_count ) count = type_desc->dst_count;
+    }
+    if( count <= pipeline->unpacked )
+        return;
+
+    parsec_type_extent(type_desc->dst_datatype, &lb, &extent);
+    parsec_ce.unpack(&parsec_ce, pipeline->buffer, (int)pipeline->length, &pipeline->position,
+                     (char*)PARSEC_DATA_COPY_GET_PTR(deps->output[pipeline->k].data.data)
+                         + type_desc->dst_displ + pipeline->unpacked * extent,
+                     (int)(count - pipeline->unpacked), type_desc->dst_datatype);
+    pipeline->unpacked = count;
+}
+
+/**
+ * A fragment of a pipelined transfer has been received. Unpack what can be
+ * unpacked and request the next fragments.
+ *
+ * @return 1 if the entire data has been received (the pipeline is then
+ * released), 0 otherwise.
+ */
+static int
+remote_dep_mpi_pipeline_fragment_end(parsec_execution_stream_t* es,
+                                     remote_dep_pipeline_t* pipeline,
+                                     uint32_t frag)
+{
+    assert(0 == pipeline->done[frag]);
+    pipeline->done[frag] = 1;
+    pipeline->done_count++;
+    pipeline->inflight--;
+    while( (pipeline->done_prefix < pipeline->nb_frags) && pipeline->done[pipeline->done_prefix] )
+        pipeline->done_prefix++;
+
+    if( pipeline->staged )
+        remote_dep_mpi_pipeline_unpack(pipeline);
+
+    if( pipeline->done_count < pipeline->nb_frags ) {
+        remote_dep_mpi_pipeline_post(es, pipeline);
+        return 0;
+    }
+    if( pipeline->staged )
+        free(pipeline->buffer);
+    free(pipeline->layout);
+    free(pipeline->done);
+    free(pipeline);
+    return 1;
+}
+
 static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
                                      parsec_remote_deps_t* deps)
 {
     remote_dep_wire_activate_t* task = &(deps->msg);
-    int from = deps->from, k, count, nbdtt;
+    int from = deps->from, k, nbdtt;
     remote_dep_wire_get_t msg;
     MPI_Datatype dtt;
 #if defined(PARSEC_DEBUG_NOISIER)
@@ -2051,10 +3027,8 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
     int len;
     remote_dep_cmd_to_string(task, tmp, MAX_TASK_STRLEN);
 #endif
-    for(k = count = 0; deps->incoming_mask >> k; k++)
-        if( ((1U<<k) & deps->incoming_mask) ) count++;
 
-    (void)es;
+    (void)es; (void)from;
     DEBUG_MARK_CTL_MSG_ACTIVATE_RECV(from, (void*)task, task);
 
     msg.source_deps = task->deps; /* the deps copied from activate message from source */
@@ -2063,28 +3037,40 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
                                                              * one sided case the (integer) value of this
                                                              * function pointer will be registered as the
                                                              * TAG to receive the same notification. */
+    msg.remote_memory_handle = NULL;
+    msg.frag_offset = 0;  /* the entire data */
+    msg.frag_length = 0;
+    msg.frag_last   = 0;
+    msg.cached      = 0;
 
     for(k = 0; deps->incoming_mask >> k; k++) {
         if( !((1U<<k) & deps->incoming_mask) ) continue;
         msg.output_mask = 0;  /* Only get what I need */
         msg.output_mask |= (1U<<k);
 
-        /* We pack the callback data that should be passed to us when the other side
-         * notifies us to invoke the callback_fn we have assigned above
-         */
-        remote_dep_cb_data_t *callback_data = (remote_dep_cb_data_t *) parsec_thread_mempool_allocate
-                                                    (parsec_remote_dep_cb_data_mempool->thread_mempools);
-        callback_data->deps = deps;
-        callback_data->k    = k;
-
         /* prepare the local receiving data */
         assert(NULL == deps->output[k].data.data); /* we do not support in-place tiles now, make sure it doesn't happen yet */
         if(NULL == deps->output[k].data.data) {
+            remote_dep_recv_cache_reclaim(deps->output[k].data.remote.arena);
             deps->output[k].data.data = remote_dep_copy_allocate(&deps->output[k].data.remote);
         }
         dtt   = deps->output[k].data.remote.dst_datatype;
         nbdtt = deps->output[k].data.remote.dst_count;
 
+        /* Large data are retrieved by fragments */
+        if( remote_dep_mpi_pipeline_start(es, deps, k) )
+            continue;
+
+        /* We pack the callback data that should be passed to us when the other side
+         * notifies us to invoke the callback_fn we have assigned above
+         */
+        remote_dep_cb_data_t *callback_data = (remote_dep_cb_data_t *) parsec_thread_mempool_allocate
+                                                    (parsec_remote_dep_cb_data_mempool->thread_mempools);
+        callback_data->deps     = deps;
+        callback_data->k        = k;
+        callback_data->pipeline = NULL;
+        callback_data->fragment_type = PARSEC_DATATYPE_NULL;
+
         /* We have the remote mem_handle.
          * Let's allocate our mem_reg_handle
          * and let the source know.
@@ -2121,41 +3107,8 @@ static void remote_dep_mpi_get_start(parsec_execution_stream_t* es,
 
         callback_data->memory_handle = receiver_memory_handle;
 
-        /* We need multiple information to be passed to the callback_fn we have assigned above.
-         * We pack the pointer to this callback_data and pass to the other side so we can complete
-         * cleanup and take necessary action when the data is available on our side */
-        msg.remote_callback_data = (remote_dep_datakey_t)callback_data;
-
-        /* We pack the static message(remote_dep_wire_get_t) and our memory_handle and send this message
-         * to the source. Source is anticipating this exact configuration.
-         */
-        int buf_size = sizeof(remote_dep_wire_get_t) + receiver_memory_handle_size;
-        void *buf = malloc(buf_size);
-        memcpy( buf,
-                &msg,
-                sizeof(remote_dep_wire_get_t) );
-        memcpy( ((char*)buf) +  sizeof(remote_dep_wire_get_t),
-                receiver_memory_handle,
-                receiver_memory_handle_size );
-
-#if defined(PARSEC_PROF_TRACE)
-        uint64_t event_id = remote_dep_mpi_profiling_event_id();
-        callback_data->event_id = event_id;
-#endif /* PARSEC_PROF_TRACE */
-
-        /* Send AM */
-        TAKE_TIME_WITH_INFO(es->es_profile, MPI_Data_pldr_sk, event_id, k,
-                            from, es->virtual_process->parsec_context->my_rank,
-                            *task, nbdtt, dtt);
-        TAKE_TIME_WITH_INFO(es->es_profile, MPI_Data_ctl_sk, event_id, k,
-                            from, es->virtual_process->parsec_context->my_rank,
-                            *task, nbdtt, dtt);
-        parsec_ce.send_am(&parsec_ce, PARSEC_CE_REMOTE_DEP_GET_DATA_TAG, from, buf, buf_size);
-        TAKE_TIME(es->es_profile, MPI_Data_ctl_ek, event_id);
-
-        free(buf);
-
-        parsec_comm_gets++;
+        remote_dep_mpi_send_get_request(es, deps, &msg, callback_data, receiver_memory_handle_size,
+                                        nbdtt, dtt);
     }
 }
 
@@ -2163,6 +3116,7 @@ static void remote_dep_mpi_get_end(parsec_execution_stream_t* es,
                                    int idx,
                                    parsec_remote_deps_t* deps)
 {
+    remote_dep_recv_cache_insert(deps, idx);
     /* The ref on the data will be released below */
     remote_dep_release_incoming(es, deps, (1U<<idx));
 }
@@ -2197,9 +3151,17 @@ remote_dep_mpi_get_end_cb(parsec_comm_engine_t *ce,
 #if defined(PARSEC_PROF_TRACE)
     TAKE_TIME(es->es_profile, MPI_Data_pldr_ek, callback_data->event_id);
 #endif /* PARSEC_PROF_TRACE */
-    remote_dep_mpi_get_end(es, callback_data->k, deps);
+    if( NULL != remote_dep_stats ) {
+        remote_dep_stats_count(callback_data->peer, PARSEC_COMM_PROTOCOL_PUT, 0, callback_data->bytes);
+        remote_dep_stats_latency(callback_data->peer, PARSEC_COMM_PROTOCOL_GET, callback_data->start);
+    }
+    if( (NULL == callback_data->pipeline) ||
+        remote_dep_mpi_pipeline_fragment_end(es, callback_data->pipeline, callback_data->frag) )
+        remote_dep_mpi_get_end(es, callback_data->k, deps);
 
     parsec_ce.mem_unregister(&callback_data->memory_handle);
+    if( PARSEC_DATATYPE_NULL != callback_data->fragment_type )
+        parsec_type_free(&callback_data->fragment_type);
     parsec_thread_mempool_free(parsec_remote_dep_cb_data_mempool->thread_mempools, callback_data);
 
     parsec_comm_gets--;
@@ -2228,6 +3190,8 @@ int remote_dep_ce_reconfigure(parsec_context_t* context)
      * MAX_PARAM_COUNT times nb_nodes dependencies.
      */
     remote_deps_allocation_init(context->nb_nodes, MAX_PARAM_COUNT);
+    if( NULL != remote_dep_stats )
+        remote_dep_stats_resize(context->nb_nodes);
 
     parsec_mpi_same_pos_items_size = context->nb_nodes + (int)DEP_LAST;
     assert( NULL == parsec_mpi_same_pos_items );
@@ -2275,6 +3239,15 @@ remote_dep_ce_init(parsec_context_t* context)
                              PARSEC_OBJ_CLASS(remote_dep_cb_data_t), sizeof(remote_dep_cb_data_t),
                              offsetof(remote_dep_cb_data_t, mempool_owner),
                              1);
+    if( parsec_param_recv_cache_size > 0 ) {
+        remote_dep_recv_cache = (remote_dep_recv_cache_entry_t*)calloc(parsec_param_recv_cache_size,
+                                                                        sizeof(remote_dep_recv_cache_entry_t));
+    }
+    if( parsec_param_comm_stats ) {
+        memset(remote_dep_stats_depths, 0, sizeof(remote_dep_stats_depths));
+        remote_dep_stats_pending_activations = 0;
+        remote_dep_stats_resize(context->nb_nodes);
+    }
     /* Lazy or delayed initializations */
     remote_dep_mpi_initialize_execution_stream(context);
     return PARSEC_SUCCESS;
@@ -2282,14 +3255,23 @@ remote_dep_ce_init(parsec_context_t* context)
 
 int remote_dep_ce_fini(parsec_context_t* context)
 {
-    (void)context;
     remote_dep_mpi_profiling_fini();
 
+    if( NULL != remote_dep_stats ) {
+        remote_dep_stats_report(context);
+        free(remote_dep_stats); remote_dep_stats = NULL;
+        remote_dep_stats_nb_peers = 0;
+    }
+
     // Unregister tags
     parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_ACTIVATE_TAG);
     parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_GET_DATA_TAG);
     //parsec_ce.tag_unregister(PARSEC_CE_REMOTE_DEP_PUT_END_TAG);
 
+    if( NULL != remote_dep_recv_cache ) {
+        (void)remote_dep_dequeue_taskpool_fini(NULL);
+        free(remote_dep_recv_cache); remote_dep_recv_cache = NULL;
+    }
     if( NULL != parsec_remote_dep_cb_data_mempool ) {
         parsec_mempool_destruct(parsec_remote_dep_cb_data_mempool);
         free(parsec_remote_dep_cb_data_mempool); parsec_remote_dep_cb_data_mempool = NULL;
@@ -295,9 +295,47 @@ typedef enum parsec_context_query_cmd_e {
     PARSEC_CONTEXT_QUERY_RANK,
     PARSEC_CONTEXT_QUERY_DEVICES,
     PARSEC_CONTEXT_QUERY_CORES,
-    PARSEC_CONTEXT_QUERY_ACTIVE_TASKPOOLS
+    PARSEC_CONTEXT_QUERY_ACTIVE_TASKPOOLS,
+    PARSEC_CONTEXT_QUERY_COMM_STATS
 } parsec_context_query_cmd_t;
 
+/**
+ * The stages of the communication protocol used to move the dependencies
+ * between processes.
+ */
+typedef enum parsec_comm_protocol_e {
+    PARSEC_COMM_PROTOCOL_ACTIVATE = 0,  /**< activation messages, including the short data they carry */
+    PARSEC_COMM_PROTOCOL_GET,           /**< data requests from the receivers */
+    PARSEC_COMM_PROTOCOL_PUT,           /**< data transfers */
+    PARSEC_COMM_PROTOCOL_COUNT
+} parsec_comm_protocol_t;
+
+/**
+ * Traffic statistics of one stage of the communication protocol. The
+ * latencies are measured locally, in seconds:
+ *  - ACTIVATE: from the release of the task to the emission of the activation;
+ *  - GET: from the emission of a data request to the end of the reception;
+ *  - PUT: from the reception of a data request to the end of the emission.
+ * The depth is the number of operations of the stage already pending when a
+ * new one is started, and is only reported for all the peers together.
+ */
+typedef struct parsec_comm_protocol_stats_s {
+    uint64_t msgs_sent;
+    uint64_t msgs_recv;
+    uint64_t bytes_sent;
+    uint64_t bytes_recv;
+    uint64_t latency_count;  /**< number of timed operations */
+    double   latency_avg;
+    double   latency_p50;    /**< upper bound of the median latency */
+    double   latency_p99;    /**< upper bound of the 99th percentile latency */
+    double   depth_avg;
+    uint64_t depth_max;
+} parsec_comm_protocol_stats_t;
+
+typedef struct parsec_comm_stats_s {
+    parsec_comm_protocol_stats_t protocol[PARSEC_COMM_PROTOCOL_COUNT];
+} parsec_comm_stats_t;
+
 /**
  * @brief Query PaRSEC context's properties.
  *
@@ -305,12 +343,18 @@ typedef enum parsec_context_query_cmd_e {
  * Query properties of the runtime, such as number of devices of a certain type
  * or number of cores available to the context.
  *
+ * PARSEC_CONTEXT_QUERY_COMM_STATS expects two extra arguments: the rank of a
+ * peer process (or -1 for all the peers together) and a pointer to a
+ * parsec_comm_stats_t to fill with the communication statistics with that
+ * peer. The statistics are only collected when the runtime_comm_stats MCA
+ * parameter is set, otherwise PARSEC_ERR_NOT_FOUND is returned.
+ *
  * @param[in] context the PaRSEC context
  * @param[in] device_type the type of device the query is about
  * @return PARSEC_ERR_NOT_SUPPORTED if the command is not supported, PARSEC_ERR_NOT_FOUND
  *         if the correct answer cannot yet be returned (such as when the PaRSEC context
  *         has not yet properly been initialized), or the answer to the query (always
- *         a positive number).
+ *         a positive number, PARSEC_SUCCESS for the queries filling a structure).
  */
 int parsec_context_query(parsec_context_t* context, parsec_context_query_cmd_t cmd, ... );
 
@@ -149,7 +149,10 @@ int __parsec_execute( parsec_execution_stream_t* es,
     parsec_hook_t *hook = tc->incarnations[task->selected_chore].hook;
     assert( NULL != hook );
     PARSEC_PINS(es, EXEC_BEGIN, task);
-    rc = hook( es, task );
+    if( NULL != task->taskpool->task_dispatch )
+        rc = task->taskpool->task_dispatch( es, task, PARSEC_TASK_STEP_EXECUTE );
+    else
+        rc = hook( es, task );
 #if defined(PARSEC_PROF_TRACE)
     task->prof_info.task_return_code = rc;
 #endif
@@ -191,6 +194,7 @@ static inline int all_tasks_done(parsec_context_t* context)
 
 void parsec_taskpool_termination_detected(parsec_taskpool_t *tp)
 {
+    (void)parsec_remote_dep_taskpool_fini(tp);
     if( NULL != tp->on_complete ) {
         (void)tp->on_complete( tp, tp->on_complete_data );
     }
@@ -378,6 +382,25 @@ int __parsec_schedule_vp(parsec_execution_stream_t* es,
     return ret;
 }
 
+int __parsec_schedule_chained(parsec_execution_stream_t* es,
+                              parsec_task_t** task_rings,
+                              int32_t distance)
+{
+    int vp = es->virtual_process->vp_id;
+    parsec_task_t* ring = task_rings[vp];
+
+#if  defined(PARSEC_DEBUG_PARANOID)
+    assert( parsec_my_execution_stream() == es );
+#endif  /* defined(PARSEC_DEBUG_PARANOID) */
+    /* Execution streams without a scheduler (e.g. the communication
+     * thread) never execute the next_task, nothing can be chained */
+    if( (NULL != ring) && (NULL == es->next_task) && (NULL != es->scheduler_object) ) {
+        es->next_task = ring;
+        task_rings[vp] = (parsec_task_t*)parsec_list_item_ring_chop(&ring->super);
+    }
+    return __parsec_schedule_vp(es, task_rings, distance);
+}
+
 /**
  * @brief Reschedule a task on some resource.
  *
@@ -437,8 +460,12 @@ int __parsec_complete_execution( parsec_execution_stream_t *es,
     if( NULL != task->task_class->prepare_output ) {
         task->task_class->prepare_output( es, task );
     }
-    if( NULL != task->task_class->complete_execution )
-        rc = task->task_class->complete_execution( es, task );
+    if( NULL != task->task_class->complete_execution ) {
+        if( NULL != task->taskpool->task_dispatch )
+            rc = task->taskpool->task_dispatch( es, task, PARSEC_TASK_STEP_COMPLETE );
+        else
+            rc = task->task_class->complete_execution( es, task );
+    }
 
     PARSEC_PAPI_SDE_COUNTER_ADD(PARSEC_PAPI_SDE_TASKS_RETIRED, 1);
     PARSEC_AYU_TASK_COMPLETE(task);
@@ -460,11 +487,16 @@ int __parsec_task_progress( parsec_execution_stream_t* es,
                             parsec_task_t* task,
                             int distance)
 {
-    int rc = PARSEC_HOOK_RETURN_DONE;
+    int rc, coarsened;
 
+  next_chained_task:
+    rc = PARSEC_HOOK_RETURN_DONE;
     if(task->status <= PARSEC_TASK_STATUS_PREPARE_INPUT) {
         PARSEC_PINS(es, PREPARE_INPUT_BEGIN, task);
-        rc = task->task_class->prepare_input(es, task);
+        if( NULL != task->taskpool->task_dispatch )
+            rc = task->taskpool->task_dispatch(es, task, PARSEC_TASK_STEP_PREPARE_INPUT);
+        else
+            rc = task->task_class->prepare_input(es, task);
         PARSEC_PINS(es, PREPARE_INPUT_END, task);
     }
     switch(rc) {
@@ -475,7 +507,16 @@ int __parsec_task_progress( parsec_execution_stream_t* es,
         /* We're good to go ... */
         switch(rc) {
         case PARSEC_HOOK_RETURN_DONE:    /* This execution succeeded */
+            coarsened = task->task_class->flags & PARSEC_COARSENED_TASK;
             __parsec_complete_execution( es, task );
+            if( coarsened && (NULL != es->next_task) ) {
+                /* Execute the chained successor right away, without going back
+                 * to the scheduling loop */
+                task = es->next_task;
+                es->next_task = NULL;
+                distance = 1;
+                goto next_chained_task;
+            }
             break;
         case PARSEC_HOOK_RETURN_AGAIN:   /* Reschedule later */
             task->status = PARSEC_TASK_STATUS_HOOK;
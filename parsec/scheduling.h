@@ -68,6 +68,25 @@ int __parsec_schedule_vp( parsec_execution_stream_t*,
                           parsec_task_t**,
                           int32_t distance);
 
+/**
+ * Schedule the rings of tasks released by a task of a coarsened task class
+ * (PARSEC_COARSENED_TASK). Unlike __parsec_schedule_vp, the highest priority
+ * task of the current virtual process is always chained to the releasing task:
+ * it is executed right after it by the same execution stream, without going
+ * through the scheduler. The other tasks are scheduled as by
+ * __parsec_schedule_vp.
+ *
+ * @param[in] es The execution stream completing the coarsened task.
+ * @param[in] task_rings The rings of ready tasks, one per virtual process.
+ * @param[in] distance Suggested distance for the tasks that are not chained.
+ *
+ * @return PARSEC_SUCCESS    If the tasks have been scheduled.
+ * @return less than PARSEC_SUCCESS  If something went wrong.
+ */
+int __parsec_schedule_chained( parsec_execution_stream_t* es,
+                               parsec_task_t** task_rings,
+                               int32_t distance);
+
 /**
  * @brief Reschedule a task on the most appropriate resource.
  *
@@ -0,0 +1,7 @@
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(apps/pingpong/overlap:mp ${MPI_TEST_CMD_LIST} 2 apps/pingpong/overlap -n 10 -f 4 -l 262144 -t 20 -w 200)
+  if(TEST apps/pingpong/overlap:mp)
+    set_tests_properties(apps/pingpong/overlap:mp PROPERTIES DEPENDS launch:mp
+                         ENVIRONMENT "PARSEC_MCA_runtime_comm_stats=1")
+  endif()
+endif( MPI_C_FOUND )
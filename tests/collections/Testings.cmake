@@ -14,6 +14,9 @@ parsec_addtest_cmd(collections/reshape:mt ${SHM_TEST_CMD_LIST} collections/resha
 if( MPI_C_FOUND )
   parsec_addtest_cmd(collections/reshape:mp ${MPI_TEST_CMD_LIST} 4 collections/reshape/reshape -N 120 -t 9 -c 10)
   parsec_addtest_cmd(collections/reshape:mp:mt ${MPI_TEST_CMD_LIST} 4 collections/reshape/reshape -N 120 -t 9 -c 10 -m 1 )
+  # Retrieve all data larger than 16 bytes as pipelined fragments, including the non-dense reshaped layouts
+  # transferred in place (no short messages, such that the small tiles are not sent with the activation)
+  parsec_addtest_cmd(collections/reshape:mp:pipeline ${MPI_TEST_CMD_LIST} 4 collections/reshape/reshape -N 120 -t 9 -c 10 -- --mca runtime_comm_pipeline_fragment_size 16 --mca runtime_comm_pipeline_depth 3 --mca runtime_comm_short_limit 0)
 endif( MPI_C_FOUND)
 
 parsec_addtest_cmd(collections/reshape/input_single_copy ${SHM_TEST_CMD_LIST} collections/reshape/input_dep_reshape_single_copy -N 12 -t 2 -c 2)
@@ -7,6 +7,16 @@ parsec_addtest_cmd(dsl/dtd/task_generation ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test
 parsec_addtest_cmd(dsl/dtd/task_inserting_task ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_task_inserting_task)
 parsec_addtest_cmd(dsl/dtd/task_insertion ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_task_insertion)
 parsec_addtest_cmd(dsl/dtd/war ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_war)
+parsec_addtest_cmd(dsl/dtd/atomic_write ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_atomic_write)
+parsec_addtest_cmd(dsl/dtd/graph_replay ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_graph_replay)
+parsec_addtest_cmd(dsl/dtd/prune_remote ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_prune_remote)
+parsec_addtest_cmd(dsl/dtd/concurrent_insertion ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_concurrent_insertion 4 --mca dtd_window_size 64 --mca dtd_threshold_size 32)
+parsec_addtest_cmd(dsl/dtd/adaptive_window ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_adaptive_window --mca dtd_window_adaptive 1 --mca dtd_window_min_size 8 --mca dtd_window_max_memory 1)
+parsec_addtest_cmd(dsl/dtd/task_class_args ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_task_class_args)
+parsec_addtest_cmd(dsl/dtd/batched_insertion ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_batched_insertion --mca dtd_window_size 64 --mca dtd_threshold_size 32)
+parsec_addtest_cmd(dsl/dtd/inline_tasks ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_inline_tasks --mca dtd_inline_max_duration 100000)
+parsec_addtest_cmd(dsl/dtd/tile_cache ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_tile_cache)
+parsec_addtest_cmd(dsl/dtd/batched_flush ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_batched_flush --mca dtd_flush_batch_size 4)
 parsec_addtest_cmd(dsl/dtd/new_tile:cpu ${SHM_TEST_CMD_LIST} dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 0)
 if(PARSEC_HAVE_CUDA AND CMAKE_CUDA_COMPILER)
   parsec_addtest_cmd(dsl/dtd/new_tile:gpu ${SHM_TEST_CMD_LIST} ${CTEST_CUDA_LAUNCHER_OPTIONS} dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 1 --mca device cuda)
@@ -21,6 +31,14 @@ if( MPI_C_FOUND )
   parsec_addtest_cmd(dsl/dtd/task_inserting_task:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_task_inserting_task)
   parsec_addtest_cmd(dsl/dtd/task_insertion:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_task_insertion)
   parsec_addtest_cmd(dsl/dtd/war:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_war)
+  parsec_addtest_cmd(dsl/dtd/atomic_write:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_atomic_write)
+  parsec_addtest_cmd(dsl/dtd/graph_replay:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_graph_replay)
+  parsec_addtest_cmd(dsl/dtd/prune_remote:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_prune_remote)
+  parsec_addtest_cmd(dsl/dtd/task_class_args:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_task_class_args)
+  parsec_addtest_cmd(dsl/dtd/batched_insertion:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_batched_insertion)
+  parsec_addtest_cmd(dsl/dtd/inline_tasks:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_inline_tasks --mca dtd_inline_max_duration 100000)
+  parsec_addtest_cmd(dsl/dtd/tile_cache:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_tile_cache)
+  parsec_addtest_cmd(dsl/dtd/batched_flush:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_batched_flush --mca dtd_flush_batch_size 4)
   parsec_addtest_cmd(dsl/dtd/interleave_actions:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_interleave_actions)
   parsec_addtest_cmd(dsl/dtd/allreduce:mp ${MPI_TEST_CMD_LIST} 4 dsl/dtd/dtd_test_allreduce)
   parsec_addtest_cmd(dsl/dtd/new_tile:mp:cpu ${MPI_TEST_CMD_LIST} 2 dsl/dtd/dtd_test_new_tile --mca device_cuda_enabled 0)
@@ -0,0 +1,218 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+#define PAYLOAD_SIZE 1024
+
+typedef struct payload_s {
+    int values[PAYLOAD_SIZE];
+} payload_t;
+
+static volatile int32_t count_error = 0;
+static volatile int32_t count_executed = 0;
+static volatile int64_t max_memory_in_flight = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+static void
+sample_memory_in_flight(parsec_task_t *this_task)
+{
+    int64_t memory = ((parsec_dtd_taskpool_t *)this_task->taskpool)->memory_in_flight;
+    int64_t max = max_memory_in_flight;
+
+    while( memory > max ) {
+        if( parsec_atomic_cas_int64(&max_memory_in_flight, max, memory) ) break;
+        max = max_memory_in_flight;
+    }
+}
+
+/* A wide phase: independent tasks carrying a large payload */
+int
+call_to_kernel_type_wide( parsec_execution_stream_t *es,
+                          parsec_task_t *this_task )
+{
+    (void)es;
+    payload_t payload;
+    int i;
+
+    parsec_dtd_unpack_args(this_task, &i, &payload);
+    if( payload.values[0] != i || payload.values[PAYLOAD_SIZE - 1] != i ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    sample_memory_in_flight(this_task);
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* A deep phase: a chain of updates of the same data */
+int
+call_to_kernel_type_deep( parsec_execution_stream_t *es,
+                          parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, step;
+
+    parsec_dtd_unpack_args(this_task, &step, &data);
+    if( *data != step ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    *data = step + 1;
+    sample_memory_in_flight(this_task);
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, i, j;
+    int no_of_tasks = 4000, no_of_steps = 2000;
+    int64_t max_memory;
+    parsec_tiled_matrix_t *dcA;
+    parsec_arena_datatype_t *adt;
+    payload_t *payload;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if( world != 1 ) {
+        parsec_fatal( "Nope! world is not right, we need exactly one MPI process. "
+                      "Try with \"mpirun -np 1 .....\"\n" );
+    }
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = 1; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+    parsec_dtd_taskpool_t *tp = (parsec_dtd_taskpool_t *)dtd_tp;
+
+    if( !tp->window_adaptive ) {
+        parsec_fatal( "The test expects --mca dtd_window_adaptive 1\n" );
+    }
+    max_memory = (int64_t)parsec_dtd_window_max_memory << 20;
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* The chain starves the workers and grows the window, then the wide
+     * tasks hold more memory and shrink it */
+    for( i = 0; i < no_of_steps; i++ ) {
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_deep, 0, PARSEC_DEV_CPU, "Deep_Task",
+                               sizeof(int), &i, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, 0, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+        if( tp->task_window_size > parsec_dtd_window_size ) {
+            parsec_fatal( "The window grew to %d tasks, above %d\n", tp->task_window_size, parsec_dtd_window_size );
+        }
+    }
+
+    payload = (payload_t *)malloc(sizeof(payload_t));
+    for( i = 0; i < no_of_tasks; i++ ) {
+        for( j = 0; j < PAYLOAD_SIZE; j++ ) payload->values[j] = i;
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_wide, 0, PARSEC_DEV_CPU, "Wide_Task",
+                               sizeof(int), &i, PARSEC_VALUE,
+                               sizeof(payload_t), payload, PARSEC_VALUE,
+                               PARSEC_DTD_ARG_END );
+        if( tp->task_window_size > parsec_dtd_window_size ) {
+            parsec_fatal( "The window grew to %d tasks, above %d\n", tp->task_window_size, parsec_dtd_window_size );
+        }
+    }
+    free(payload);
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    if( count_executed != no_of_tasks + no_of_steps ) {
+        parsec_fatal( "%d tasks were executed instead of %d\n", count_executed, no_of_tasks + no_of_steps );
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d tasks did not read the expected value\n\n", count_error );
+    }
+    if( 0 != tp->memory_in_flight || 0 != tp->ready_tasks ) {
+        parsec_fatal( "%" PRId64 " bytes and %d ready tasks are still accounted in flight\n",
+                      tp->memory_in_flight, tp->ready_tasks );
+    }
+    /* The window is only adapted every window, the memory can exceed
+     * the bound by the tasks of one window */
+    if( 0 != max_memory &&
+        max_memory_in_flight > max_memory + (int64_t)parsec_dtd_window_min_size * (int64_t)sizeof(payload_t) * 4 ) {
+        parsec_fatal( "%" PRId64 " bytes were in flight, above the bound of %" PRId64 "\n",
+                      max_memory_in_flight, max_memory );
+    }
+    parsec_output( 0, "Adaptive window test passed (%" PRId64 " bytes in flight at most)\n\n", max_memory_in_flight );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+#define MAX_TILES 64
+
+static volatile int32_t count_exclusion_error = 0;
+static volatile int32_t count_order_error = 0;
+static volatile int32_t updating[MAX_TILES];
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_update( parsec_execution_stream_t *es,
+                            parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, idx, rank, value;
+
+    parsec_dtd_unpack_args(this_task, &idx, &data, &rank);
+    if( 0 != parsec_atomic_fetch_inc_int32(&updating[idx]) ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_exclusion_error);
+    }
+    /* a non atomic update, racy if the runtime lets two updates overlap */
+    value = *data;
+    usleep(10);
+    *data = value + 1;
+    (void)parsec_atomic_fetch_dec_int32(&updating[idx]);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_check( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, expected, rank;
+
+    parsec_dtd_unpack_args(this_task, &expected, &data, &rank);
+    if( *data != expected ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_order_error);
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc;
+    parsec_tiled_matrix_t *dcA;
+
+    int i, j, r, other, expected;
+    int no_of_tasks, no_of_rounds = 4, no_of_updates = 8, no_of_read_tasks = 3, key;
+    parsec_arena_datatype_t *adt;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    no_of_tasks = world;
+    nb = 1; /* tile_size */
+    nt = no_of_tasks; /* total no. of tiles */
+    if( nt > MAX_TILES ) {
+        parsec_fatal( "This test supports at most %d processes\n", MAX_TILES );
+    }
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* Each round updates every tile with commutative updates from the owner
+     * of the tile, and a last one from another process, before reading it
+     * back on every process */
+    for( i = 0; i < no_of_tasks; i++ ) {
+        key = A->data_key(A, i, 0);
+        other = (i + 1) % world;
+        expected = 0;
+        for( r = 0; r < no_of_rounds; r++ ) {
+            for( j = 0; j < no_of_updates; j++ ) {
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_update, 0, PARSEC_DEV_CPU, "Update_Task",
+                                       sizeof(int), &i, PARSEC_VALUE,
+                                       PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, key), PARSEC_ATOMIC_WRITE | TILE_FULL | PARSEC_AFFINITY,
+                                       sizeof(int), &other, PARSEC_VALUE,
+                                       PARSEC_DTD_ARG_END );
+            }
+            parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_update, 0, PARSEC_DEV_CPU, "Update_Task",
+                                   sizeof(int), &i, PARSEC_VALUE,
+                                   PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, key), PARSEC_ATOMIC_WRITE | TILE_FULL,
+                                   sizeof(int), &other, PARSEC_VALUE | PARSEC_AFFINITY,
+                                   PARSEC_DTD_ARG_END );
+            expected += no_of_updates + 1;
+            for( j = 0; j < no_of_read_tasks; j++ ) {
+                int reader = (i + j) % world;
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_check, 0, PARSEC_DEV_CPU, "Check_Task",
+                                       sizeof(int), &expected, PARSEC_VALUE,
+                                       PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, key), PARSEC_INPUT | TILE_FULL,
+                                       sizeof(int), &reader, PARSEC_VALUE | PARSEC_AFFINITY,
+                                       PARSEC_DTD_ARG_END );
+            }
+        }
+    }
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    if( count_exclusion_error > 0 ) {
+        parsec_fatal( "Atomic write tasks of the same data are not executed in mutual exclusion\n\n" );
+    }
+    if( count_order_error > 0 ) {
+        parsec_fatal( "Atomic write tasks are not ordered with the readers of the same data\n\n" );
+    }
+    parsec_output( 0, "Atomic write test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_error = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_add( parsec_execution_stream_t *es,
+                         parsec_task_t *this_task )
+{
+    int rank, expected, *data;
+
+    parsec_dtd_unpack_args(this_task, &rank, &expected, &data);
+    if( *data != expected ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    if( rank != es->virtual_process->parsec_context->my_rank ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    *data += 1;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, phase, it, k;
+    int no_of_phases = 3, no_of_iterations = 2;
+    parsec_tiled_matrix_t *dcA;
+    parsec_arena_datatype_t *adt;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    /* Full and partial batches for each pair of ranks */
+    nt = 10 * world; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+    parsec_dtd_taskpool_t *tp = (parsec_dtd_taskpool_t *)dtd_tp;
+
+    if( parsec_dtd_flush_batch_size < 2 ) {
+        parsec_fatal( "The test expects --mca dtd_flush_batch_size 2 or more\n" );
+    }
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* In each phase, the tiles are updated on the next rank after their
+     * owner, and written back to their owner by the flush. One tile out
+     * of five is left untouched. */
+    for( phase = 0; phase < no_of_phases; phase++ ) {
+        for( it = 0; it < no_of_iterations; it++ ) {
+            for( k = 0; k < nt; k++ ) {
+                parsec_data_key_t key = A->data_key(A, k, 0);
+                int add_rank = ((int)A->rank_of_key(A, key) + 1) % world;
+                int expected = phase * no_of_iterations + it;
+                if( 4 == k % 5 ) continue;
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_add, 0, PARSEC_DEV_CPU, "Add",
+                                       sizeof(int), &add_rank, PARSEC_VALUE | PARSEC_AFFINITY,
+                                       sizeof(int), &expected, PARSEC_VALUE,
+                                       PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, key), PARSEC_INOUT | TILE_FULL,
+                                       PARSEC_DTD_ARG_END);
+            }
+        }
+        (void)PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, 4, 0));
+
+        parsec_dtd_data_flush_all( dtd_tp, A );
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+        for( k = 0; k < nt; k++ ) {
+            parsec_data_key_t key = A->data_key(A, k, 0);
+            int expected = (4 == k % 5) ? 0 : (phase + 1) * no_of_iterations;
+            if( (int)A->rank_of_key(A, key) != rank ) continue;
+            int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+            if( *data != expected ) {
+                parsec_fatal( "Tile %d of A holds %d instead of %d after phase %d\n", k, *data, expected, phase );
+            }
+        }
+    }
+
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    if( count_error > 0 ) {
+        parsec_fatal( "%d tasks did not read the expected value\n\n", count_error );
+    }
+    if( NULL == tp->flush_batch_tc ||
+        tp->flush_batch_tc->nb_flows != (parsec_dtd_flush_batch_size < MAX_PARAM_COUNT ? parsec_dtd_flush_batch_size : MAX_PARAM_COUNT) ) {
+        parsec_fatal( "The tiles were not flushed in batches\n" );
+    }
+    parsec_output( 0, "Batched flush test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
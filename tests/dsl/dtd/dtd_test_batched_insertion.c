@@ -0,0 +1,241 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_error = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_add( parsec_execution_stream_t *es,
+                         parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, value;
+
+    parsec_dtd_unpack_args(this_task, &data, &value);
+    *data += value;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_copy( parsec_execution_stream_t *es,
+                          parsec_task_t *this_task )
+{
+    (void)es;
+    int *dst, *src;
+
+    parsec_dtd_unpack_args(this_task, &dst, &src);
+    *dst = *src;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_check( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int rank, expected, *data;
+    int32_t *nb_checks;
+
+    parsec_dtd_unpack_args(this_task, &rank, &expected, &nb_checks, &data);
+    if( *data != expected ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    if( rank != es->virtual_process->parsec_context->my_rank ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    (void)parsec_atomic_fetch_inc_int32(nb_checks);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, it, k;
+    int no_of_iterations = 10, one = 1, expected;
+    int32_t nb_checks = 0;
+    parsec_tiled_matrix_t *dcA, *dcB;
+    parsec_arena_datatype_t *adt;
+    void **args;
+    int *check_ranks;
+    parsec_task_t **tasks;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = 100 * world; /* total no. of tiles, more than a batch */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    dcB = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcB)->mat,
+            0,
+            (size_t)dcB->nb_local_tiles *
+            (size_t)dcB->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcB->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcB, "B");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_data_collection_t *B = (parsec_data_collection_t *)dcB;
+    parsec_dtd_data_collection_init(A);
+    parsec_dtd_data_collection_init(B);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    parsec_task_class_t *add_tc = parsec_dtd_create_task_class(dtd_tp, "add",
+                                                               PASSED_BY_REF, PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                                                               sizeof(int), PARSEC_VALUE,
+                                                               PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, add_tc, PARSEC_DEV_CPU, call_to_kernel_type_add);
+
+    parsec_task_class_t *copy_tc = parsec_dtd_create_task_class(dtd_tp, "copy",
+                                                                PASSED_BY_REF, PARSEC_OUTPUT | TILE_FULL | PARSEC_AFFINITY,
+                                                                PASSED_BY_REF, PARSEC_INPUT | TILE_FULL,
+                                                                PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, copy_tc, PARSEC_DEV_CPU, call_to_kernel_type_copy);
+
+    /* The check tasks are placed by a value */
+    parsec_task_class_t *check_tc = parsec_dtd_create_task_class(dtd_tp, "check",
+                                                                 sizeof(int), PARSEC_VALUE | PARSEC_AFFINITY,
+                                                                 sizeof(int), PARSEC_VALUE,
+                                                                 sizeof(int32_t *), PARSEC_REF,
+                                                                 PASSED_BY_REF, PARSEC_INPUT | TILE_FULL,
+                                                                 PARSEC_DTD_ARG_END);
+    parsec_dtd_task_class_add_chore(dtd_tp, check_tc, PARSEC_DEV_CPU, call_to_kernel_type_check);
+
+    args = (void **)malloc(4 * nt * sizeof(void *));
+    tasks = (parsec_task_t **)malloc(nt * sizeof(parsec_task_t *));
+
+    /* Every iteration adds 1 to each tile of A, as a batch of tasks, then
+     * copies it in the next tile of B, as a batch of created tasks */
+    for( it = 0; it < no_of_iterations; it++ ) {
+        for( k = 0; k < nt; k++ ) {
+            args[2 * k] = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0));
+            args[2 * k + 1] = &one;
+        }
+        parsec_dtd_insert_tasks_with_args(dtd_tp, add_tc, 0, PARSEC_DEV_CPU, nt, args);
+        for( k = 0; k < nt; k++ ) {
+            void *copy_args[2];
+            copy_args[0] = PARSEC_DTD_TILE_OF_KEY(B, B->data_key(B, (k + 1) % nt, 0));
+            copy_args[1] = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0));
+            tasks[k] = parsec_dtd_create_task_with_args(dtd_tp, copy_tc, 0, PARSEC_DEV_CPU, copy_args);
+        }
+        parsec_insert_dtd_tasks(tasks, nt);
+    }
+
+    /* The checks are executed on the rank after the owner of the tiles of B */
+    expected = no_of_iterations;
+    check_ranks = (int *)malloc(nt * sizeof(int));
+    for( k = 0; k < nt; k++ ) {
+        check_ranks[k] = ((int)B->rank_of_key(B, B->data_key(B, k, 0)) + 1) % world;
+        args[4 * k] = &check_ranks[k];
+        args[4 * k + 1] = &expected;
+        args[4 * k + 2] = &nb_checks;
+        args[4 * k + 3] = PARSEC_DTD_TILE_OF_KEY(B, B->data_key(B, k, 0));
+    }
+    parsec_dtd_insert_tasks_with_args(dtd_tp, check_tc, 0, PARSEC_DEV_CPU, nt, args);
+    free(check_ranks);
+    free(tasks);
+    free(args);
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+    parsec_dtd_data_flush_all( dtd_tp, B );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = A->data_key(A, k, 0);
+        if( (int)A->rank_of_key(A, key) != rank ) continue;
+        int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        if( *data != no_of_iterations ) {
+            parsec_fatal( "Tile %d of A holds %d instead of %d\n", k, *data, no_of_iterations );
+        }
+    }
+    if( nb_checks != nt / world ) {
+        parsec_fatal( "%d check tasks were executed instead of %d\n", nb_checks, nt / world );
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d tasks did not read the expected value\n\n", count_error );
+    }
+    parsec_output( 0, "Batched insertion test passed\n\n" );
+
+    parsec_dtd_task_class_release(dtd_tp, add_tc);
+    parsec_dtd_task_class_release(dtd_tp, copy_tc);
+    parsec_dtd_task_class_release(dtd_tp, check_tc);
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    parsec_dtd_data_collection_fini( B );
+    free_data(dcA);
+    free_data(dcB);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
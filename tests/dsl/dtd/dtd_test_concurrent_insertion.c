@@ -0,0 +1,269 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_order_error = 0;
+static volatile int32_t count_executed = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_chain( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, step;
+
+    parsec_dtd_unpack_args(this_task, &step, &data);
+    if( *data != step ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_order_error);
+    }
+    *data = step + 1;
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_count( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int *data;
+
+    parsec_dtd_unpack_args(this_task, &data);
+    *data += 1;
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_pair( parsec_execution_stream_t *es,
+                          parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, *first, *second, step;
+
+    parsec_dtd_unpack_args(this_task, &step, &data, &first, &second);
+    if( *data != step ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_order_error);
+    }
+    *data = step + 1;
+    *first += 1;
+    *second += 1;
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* Each inserter owns a tile, on which it inserts a chain of updates, and
+ * shares the tile that follows the tiles of the inserters with the others */
+int
+task_to_insert_tasks( parsec_execution_stream_t *es,
+                      parsec_task_t *this_task )
+{
+    (void)es;
+    parsec_taskpool_t *dtd_tp = this_task->taskpool;
+    parsec_data_collection_t *A;
+    int idx, shared, no_of_steps, step;
+
+    parsec_dtd_unpack_args(this_task, &idx, &shared, &no_of_steps, &A);
+
+    for( step = 0; step < no_of_steps; step++ ) {
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_chain, 0, PARSEC_DEV_CPU, "Chain_Task",
+                               sizeof(int), &step, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, idx, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_count, 0, PARSEC_DEV_CPU, "Count_Task",
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, shared, 0)), PARSEC_ATOMIC_WRITE | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+typedef struct inserter_thread_s {
+    pthread_t                 thread;
+    parsec_taskpool_t        *dtd_tp;
+    parsec_data_collection_t *A;
+    int                       idx, shared, first_step, no_of_steps;
+} inserter_thread_t;
+
+/* An application thread inserts a chain of tasks updating its tile and the
+ * two shared tiles. Half of the threads pass the shared tiles in the other
+ * order: the tasks of two threads must be ordered the same way on both
+ * shared tiles, or they wait for each other. */
+static void *
+application_inserter( void *arg )
+{
+    inserter_thread_t *it = (inserter_thread_t *)arg;
+    parsec_data_collection_t *A = it->A;
+    int step, first = it->shared + (it->idx % 2), second = it->shared + 1 - (it->idx % 2);
+
+    for( step = it->first_step; step < it->first_step + it->no_of_steps; step++ ) {
+        parsec_dtd_insert_task(it->dtd_tp, call_to_kernel_type_pair, 0, PARSEC_DEV_CPU, "Pair_Task",
+                               sizeof(int), &step, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, it->idx, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, first, 0)), PARSEC_INOUT | TILE_FULL,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, second, 0)), PARSEC_INOUT | TILE_FULL,
+                               PARSEC_DTD_ARG_END );
+    }
+    return NULL;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, i;
+    int no_of_inserters = 8, no_of_steps = 500;
+    parsec_tiled_matrix_t *dcA;
+    parsec_arena_datatype_t *adt;
+    inserter_thread_t *threads;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if( world != 1 ) {
+        parsec_fatal( "Nope! world is not right, we need exactly one MPI process. "
+                      "Try with \"mpirun -np 1 .....\"\n" );
+    }
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = no_of_inserters + 2; /* a tile per inserter, and two shared ones */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    for( i = 0; i < no_of_inserters; i++ ) {
+        parsec_dtd_insert_task(dtd_tp, task_to_insert_tasks, 0, PARSEC_DEV_CPU, "Inserter_Task",
+                               sizeof(int), &i, PARSEC_VALUE,
+                               sizeof(int), &no_of_inserters, PARSEC_VALUE,
+                               sizeof(int), &no_of_steps, PARSEC_VALUE,
+                               sizeof(parsec_data_collection_t *), A, PARSEC_REF,
+                               PARSEC_DTD_ARG_END );
+    }
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+    /* Then application threads insert tasks with three tiles */
+    threads = (inserter_thread_t *)calloc(no_of_inserters, sizeof(inserter_thread_t));
+    for( i = 0; i < no_of_inserters; i++ ) {
+        threads[i].dtd_tp = dtd_tp;
+        threads[i].A = A;
+        threads[i].idx = i;
+        threads[i].shared = no_of_inserters;
+        threads[i].first_step = no_of_steps;
+        threads[i].no_of_steps = no_of_steps;
+        pthread_create(&threads[i].thread, NULL, application_inserter, &threads[i]);
+    }
+    for( i = 0; i < no_of_inserters; i++ ) {
+        pthread_join(threads[i].thread, NULL);
+    }
+    free(threads);
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    for( i = 0; i < nt; i++ ) {
+        parsec_data_key_t key = A->data_key(A, i, 0);
+        int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        int expected = (i < no_of_inserters) ? 2 * no_of_steps :
+                       (i == no_of_inserters) ? 2 * no_of_inserters * no_of_steps : no_of_inserters * no_of_steps;
+        if( *data != expected ) {
+            parsec_fatal( "Tile %d holds %d instead of %d\n", i, *data, expected );
+        }
+    }
+    if( count_executed != 3 * no_of_inserters * no_of_steps ) {
+        parsec_fatal( "%d tasks were executed instead of %d\n", count_executed, 3 * no_of_inserters * no_of_steps );
+    }
+    if( count_order_error > 0 ) {
+        parsec_fatal( "Tasks inserted by the same thread were not executed in order\n\n" );
+    }
+    parsec_output( 0, "Concurrent insertion test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
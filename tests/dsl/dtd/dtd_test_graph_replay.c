@@ -0,0 +1,230 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_update = 0;
+static volatile int32_t count_error = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+/* Each tile k is updated then checked at every iteration, the increment of
+ * the iteration it is (it + 1) * (k + 1) */
+static int increment_of(int it, int k)
+{
+    return (it + 1) * (k + 1);
+}
+
+static int expected_of(int it, int k)
+{
+    return (it + 1) * (it + 2) / 2 * (k + 1);
+}
+
+int
+call_to_kernel_type_update( parsec_execution_stream_t *es,
+                            parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, increment;
+
+    parsec_dtd_unpack_args(this_task, &increment, &data);
+    *data += increment;
+    (void)parsec_atomic_fetch_inc_int32(&count_update);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_check( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, expected, rank;
+
+    parsec_dtd_unpack_args(this_task, &expected, &data, &rank);
+    if( *data != expected ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* The recorded iteration inserts an update and a check per tile */
+static void
+update_values(int task_index, int nb_params, void **values, void *cb_data)
+{
+    int it = *(int *)cb_data;
+    int k = task_index / 2;
+
+    assert(nb_params >= 2);
+    (void)nb_params;
+    if( 0 == task_index % 2 ) {
+        *(int *)values[0] = increment_of(it, k);
+    } else {
+        *(int *)values[0] = expected_of(it, k);
+    }
+}
+
+static void
+insert_iteration(parsec_taskpool_t *dtd_tp, parsec_data_collection_t *A,
+                 int nt, int world, int it)
+{
+    int k, increment, expected, checker;
+
+    for( k = 0; k < nt; k++ ) {
+        increment = increment_of(it, k);
+        expected = expected_of(it, k);
+        checker = (k + 1) % world;
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_update, 0, PARSEC_DEV_CPU, "Update_Task",
+                               sizeof(int), &increment, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_check, 0, PARSEC_DEV_CPU, "Check_Task",
+                               sizeof(int), &expected, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_INPUT | TILE_FULL,
+                               sizeof(int), &checker, PARSEC_VALUE | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, it, k;
+    int no_of_iterations = 10, expected_updates = 0;
+    parsec_tiled_matrix_t *dcA;
+    parsec_arena_datatype_t *adt;
+    parsec_dtd_graph_t *graph;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = 2 * world; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    for( k = 0; k < nt; k++ ) {
+        if( (int)A->rank_of_key(A, A->data_key(A, k, 0)) == rank ) {
+            expected_updates += no_of_iterations;
+        }
+    }
+
+    /* The first iteration is recorded while it executes */
+    rc = parsec_dtd_graph_record_begin( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_dtd_graph_record_begin");
+    insert_iteration(dtd_tp, A, nt, world, 0);
+    graph = parsec_dtd_graph_record_end( dtd_tp );
+    if( NULL == graph || parsec_dtd_graph_nb_tasks(graph) != 2 * nt ) {
+        parsec_fatal( "The graph recorded %d tasks instead of %d\n",
+                      NULL == graph ? 0 : parsec_dtd_graph_nb_tasks(graph), 2 * nt );
+    }
+
+    /* The other iterations are replayed, the data are flushed halfway
+     * to replay the graph on tiles that have to be looked up again */
+    for( it = 1; it < no_of_iterations; it++ ) {
+        rc = parsec_dtd_graph_replay( dtd_tp, graph, update_values, &it );
+        PARSEC_CHECK_ERROR(rc, "parsec_dtd_graph_replay");
+        if( it == no_of_iterations / 2 ) {
+            parsec_dtd_data_flush_all( dtd_tp, A );
+            rc = parsec_taskpool_wait( dtd_tp );
+            PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        }
+    }
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    parsec_dtd_graph_free( graph );
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = A->data_key(A, k, 0);
+        if( (int)A->rank_of_key(A, key) != rank ) continue;
+        int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        if( *data != expected_of(no_of_iterations - 1, k) ) {
+            parsec_fatal( "Tile %d holds %d instead of %d\n", k, *data, expected_of(no_of_iterations - 1, k) );
+        }
+    }
+    if( count_update != expected_updates ) {
+        parsec_fatal( "%d update tasks were executed instead of %d\n", count_update, expected_updates );
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d replayed tasks did not read the expected value\n\n", count_error );
+    }
+    parsec_output( 0, "Graph replay test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_error = 0;
+static volatile int32_t count_executed = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_step( parsec_execution_stream_t *es,
+                          parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, step;
+
+    parsec_dtd_unpack_args(this_task, &step, &data);
+    if( *data != step ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+    *data = step + 1;
+    (void)parsec_atomic_fetch_inc_int32(&count_executed);
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, i, k;
+    int no_of_steps = 200, expected = 0;
+    parsec_tiled_matrix_t *dcA;
+    parsec_arena_datatype_t *adt;
+    parsec_dtd_task_class_t *dtd_tc;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = 3 * world; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    if( 0 == parsec_dtd_inline_max_duration ) {
+        parsec_fatal( "The test expects a positive --mca dtd_inline_max_duration\n" );
+    }
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_dtd_data_collection_init(A);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* One class per hint, each updating its own chains of tiles */
+    parsec_task_class_t *tcs[3];
+    parsec_dtd_inline_hint_t hints[3] = { PARSEC_DTD_INLINE_MEASURED, PARSEC_DTD_INLINE_ALWAYS, PARSEC_DTD_INLINE_NEVER };
+    for( k = 0; k < 3; k++ ) {
+        tcs[k] = parsec_dtd_create_task_class(dtd_tp, "step",
+                                              sizeof(int), PARSEC_VALUE,
+                                              PASSED_BY_REF, PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                                              PARSEC_DTD_ARG_END);
+        parsec_dtd_task_class_add_chore(dtd_tp, tcs[k], PARSEC_DEV_CPU, call_to_kernel_type_step);
+        rc = parsec_dtd_task_class_set_inline(tcs[k], hints[k]);
+        PARSEC_CHECK_ERROR(rc, "parsec_dtd_task_class_set_inline");
+    }
+
+    for( i = 0; i < no_of_steps; i++ ) {
+        for( k = 0; k < nt; k++ ) {
+            parsec_dtd_insert_task_with_task_class(dtd_tp, tcs[k % 3], 0, PARSEC_DEV_CPU,
+                                                   PARSEC_DTD_EMPTY_FLAG, &i,
+                                                   PARSEC_DTD_EMPTY_FLAG, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)),
+                                                   PARSEC_DTD_ARG_END);
+        }
+    }
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = A->data_key(A, k, 0);
+        if( (int)A->rank_of_key(A, key) != rank ) continue;
+        int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        if( *data != no_of_steps ) {
+            parsec_fatal( "Tile %d of A holds %d instead of %d\n", k, *data, no_of_steps );
+        }
+        expected += no_of_steps;
+    }
+    if( count_executed != expected ) {
+        parsec_fatal( "%d tasks were executed instead of %d\n", count_executed, expected );
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d tasks did not read the expected value\n\n", count_error );
+    }
+    /* The duration of the bodies is measured whatever the hint */
+    for( k = 0; k < 3; k++ ) {
+        dtd_tc = (parsec_dtd_task_class_t *)tcs[k];
+        if( expected > 0 && (dtd_tc->nb_body_durations <= 0 || dtd_tc->body_duration < 0) ) {
+            parsec_fatal( "The duration of the bodies of class %d was not measured\n", k );
+        }
+    }
+    parsec_output( 0, "Inline tasks test passed\n\n" );
+
+    for( k = 0; k < 3; k++ ) {
+        parsec_dtd_task_class_release(dtd_tp, tcs[k]);
+    }
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    free_data(dcA);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_error = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_increment( parsec_execution_stream_t *es,
+                               parsec_task_t *this_task )
+{
+    (void)es;
+    int *data;
+
+    parsec_dtd_unpack_args(this_task, &data);
+    *data += 1;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_check( parsec_execution_stream_t *es,
+                           parsec_task_t *this_task )
+{
+    (void)es;
+    int *data, expected;
+
+    parsec_dtd_unpack_args(this_task, &expected, &data);
+    if( *data != expected ) {
+        (void)parsec_atomic_fetch_inc_int32(&count_error);
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+int
+call_to_kernel_type_accumulate( parsec_execution_stream_t *es,
+                                parsec_task_t *this_task )
+{
+    (void)es;
+    int *acc, *data;
+
+    parsec_dtd_unpack_args(this_task, &acc, &data);
+    *acc += *data;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* Every tile of A is updated twice and checked where it is owned, then
+ * accumulated in the next tile of B, owned by the next rank. The step is
+ * the number of iterations since A was last reset. */
+static void
+insert_iteration(parsec_taskpool_t *dtd_tp, parsec_data_collection_t *A,
+                 parsec_data_collection_t *B, int nt, int step)
+{
+    int k, expected = 2 * (step + 1);
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_increment, 0, PARSEC_DEV_CPU, "Increment_Task",
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_ATOMIC_WRITE | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_increment, 0, PARSEC_DEV_CPU, "Increment_Task",
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_ATOMIC_WRITE | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_check, 0, PARSEC_DEV_CPU, "Check_Task",
+                               sizeof(int), &expected, PARSEC_VALUE,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_INPUT | TILE_FULL | PARSEC_AFFINITY,
+                               PARSEC_DTD_ARG_END );
+    }
+    for( k = 0; k < nt; k++ ) {
+        parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_accumulate, 0, PARSEC_DEV_CPU, "Accumulate_Task",
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(B, B->data_key(B, (k + 1) % nt, 0)), PARSEC_ATOMIC_WRITE | TILE_FULL | PARSEC_AFFINITY,
+                               PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_INPUT | TILE_FULL,
+                               PARSEC_DTD_ARG_END );
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, it, k;
+    int no_of_iterations = 8, restart = no_of_iterations / 2 + 1;
+    int neighbors[2], expected = 0;
+    parsec_tiled_matrix_t *dcA, *dcB;
+    parsec_arena_datatype_t *adt;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    nt = 2 * world; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    dcB = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcB)->mat,
+            0,
+            (size_t)dcB->nb_local_tiles *
+            (size_t)dcB->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcB->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcB, "B");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_data_collection_t *B = (parsec_data_collection_t *)dcB;
+    parsec_dtd_data_collection_init(A);
+    parsec_dtd_data_collection_init(B);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+
+    /* The tiles are distributed cyclically: the tasks of this rank only
+     * access its own tiles and the tiles of the previous rank */
+    neighbors[0] = (rank + world - 1) % world;
+    neighbors[1] = (rank + 1) % world;
+    rc = parsec_dtd_taskpool_set_neighbors( dtd_tp, 2, neighbors );
+    PARSEC_CHECK_ERROR(rc, "parsec_dtd_taskpool_set_neighbors");
+
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* The data are flushed halfway, to prune the accesses to tiles
+     * that have to be looked up again */
+    for( it = 0; it < no_of_iterations; it++ ) {
+        insert_iteration(dtd_tp, A, B, nt, it < restart ? it : it - restart);
+        if( it == restart - 1 ) {
+            parsec_dtd_data_flush_all( dtd_tp, A );
+            parsec_dtd_data_flush_all( dtd_tp, B );
+            rc = parsec_taskpool_wait( dtd_tp );
+            PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+            /* A is reset where it is owned, to update it again from 0 */
+            for( k = 0; k < nt; k++ ) {
+                parsec_data_key_t key = A->data_key(A, k, 0);
+                if( (int)A->rank_of_key(A, key) != rank ) continue;
+                int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+                *data = 0;
+            }
+        }
+    }
+
+    parsec_dtd_data_flush_all( dtd_tp, A );
+    parsec_dtd_data_flush_all( dtd_tp, B );
+
+    rc = parsec_taskpool_wait( dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    /* Each tile of B accumulates 2 * (it + 1) at every iteration, the
+     * iterations restart from 0 after the reset of A */
+    for( it = 0; it < restart; it++ ) expected += 2 * (it + 1);
+    for( it = 0; it < no_of_iterations - restart; it++ ) expected += 2 * (it + 1);
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = B->data_key(B, k, 0);
+        if( (int)B->rank_of_key(B, key) != rank ) continue;
+        int *data = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(B->data_of_key(B, key), 0));
+        if( *data != expected ) {
+            parsec_fatal( "Tile %d of B holds %d instead of %d\n", k, *data, expected );
+        }
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d tasks did not read the expected value\n\n", count_error );
+    }
+    /* The ranks that are not neighbors of this one have their own tiles */
+    if( world > 3 && 0 == ((parsec_dtd_taskpool_t *)dtd_tp)->nb_pruned_tasks ) {
+        parsec_fatal( "No task was pruned\n" );
+    }
+    parsec_output( 0, "Remote task pruning test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    parsec_dtd_data_collection_fini( B );
+    free_data(dcA);
+    free_data(dcB);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
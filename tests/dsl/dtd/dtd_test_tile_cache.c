@@ -0,0 +1,214 @@
+/* parsec things */
+#include "parsec/runtime.h"
+
+/* system and io */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tests/tests_data.h"
+#include "parsec/interfaces/dtd/insert_function_internal.h"
+#include "parsec/utils/debug.h"
+#include "parsec/data_dist/matrix/two_dim_rectangle_cyclic.h"
+
+#if defined(PARSEC_HAVE_STRING_H)
+#include <string.h>
+#endif  /* defined(PARSEC_HAVE_STRING_H) */
+
+#if defined(PARSEC_HAVE_MPI)
+#include <mpi.h>
+#endif  /* defined(PARSEC_HAVE_MPI) */
+
+static volatile int32_t count_error = 0;
+
+/* IDs for the Arena Datatypes */
+static int TILE_FULL;
+
+int
+call_to_kernel_type_add( parsec_execution_stream_t *es,
+                         parsec_task_t *this_task )
+{
+    (void)es;
+    int *data;
+
+    parsec_dtd_unpack_args(this_task, &data);
+    *data += 1;
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+/* The workers look up the tiles the inserter used */
+int
+call_to_kernel_type_lookup( parsec_execution_stream_t *es,
+                            parsec_task_t *this_task )
+{
+    (void)es;
+    parsec_data_collection_t *dc;
+    parsec_dtd_tile_t *tile;
+    int k, i;
+
+    parsec_dtd_unpack_args(this_task, &dc, &k, &tile);
+    for( i = 0; i < 4; i++ ) {
+        if( parsec_dtd_tile_of(dc, dc->data_key(dc, k, 0)) != tile ) {
+            (void)parsec_atomic_fetch_inc_int32(&count_error);
+        }
+    }
+
+    return PARSEC_HOOK_RETURN_DONE;
+}
+
+static void
+check_tile(parsec_data_collection_t *dc, int k)
+{
+    parsec_data_key_t key = dc->data_key(dc, k, 0);
+    parsec_dtd_tile_t *tile = PARSEC_DTD_TILE_OF_KEY(dc, key);
+
+    if( tile != PARSEC_DTD_TILE_OF_KEY(dc, key) ) {
+        parsec_fatal( "Two lookups of tile %d returned different tiles\n", k );
+    }
+    if( tile->dc != dc || tile->key != (uint64_t)key || NOT_FLUSHED != tile->flushed ) {
+        parsec_fatal( "The lookup of tile %d returned another tile\n", k );
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    parsec_context_t* parsec;
+    int rank, world, cores = -1;
+    int nb, nt, rc, round, it, k;
+    int no_of_rounds = 3, no_of_iterations = 20;
+    parsec_tiled_matrix_t *dcA, *dcB;
+    parsec_arena_datatype_t *adt;
+
+#if defined(PARSEC_HAVE_MPI)
+    {
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &world);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    world = 1;
+    rank = 0;
+#endif
+
+    if(argv[1] != NULL){
+        cores = atoi(argv[1]);
+    }
+
+    nb = 1; /* tile_size */
+    /* Some tiles share a slot of the caches */
+    nt = 2 * PARSEC_DTD_TILE_CACHE_SIZE * world; /* total no. of tiles */
+
+    parsec = parsec_init( cores, &argc, &argv );
+
+    parsec_taskpool_t *dtd_tp = parsec_dtd_taskpool_new();
+
+    adt = parsec_dtd_create_arena_datatype(parsec, &TILE_FULL);
+    parsec_add2arena_rect( adt,
+                                  parsec_datatype_int32_t,
+                                  nb, 1, nb);
+
+    dcA = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcA)->mat,
+            0,
+            (size_t)dcA->nb_local_tiles *
+            (size_t)dcA->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcA->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcA, "A");
+    dcB = create_and_distribute_data(rank, world, nb, nt);
+    memset(((parsec_matrix_block_cyclic_t *)dcB)->mat,
+            0,
+            (size_t)dcB->nb_local_tiles *
+            (size_t)dcB->bsiz *
+            (size_t)parsec_datadist_getsizeoftype(dcB->mtype));
+    parsec_data_collection_set_key((parsec_data_collection_t *)dcB, "B");
+
+    parsec_data_collection_t *A = (parsec_data_collection_t *)dcA;
+    parsec_data_collection_t *B = (parsec_data_collection_t *)dcB;
+    parsec_dtd_data_collection_init(A);
+    parsec_dtd_data_collection_init(B);
+
+    /* Registering the dtd_taskpool with PARSEC context */
+    rc = parsec_context_add_taskpool( parsec, dtd_tp );
+    PARSEC_CHECK_ERROR(rc, "parsec_context_add_taskpool");
+    rc = parsec_context_start(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_start");
+
+    /* The tiles are flushed after each round, the next round creates new
+     * tiles for the same keys */
+    for( round = 0; round < no_of_rounds; round++ ) {
+        for( k = 0; k < nt; k++ ) {
+            check_tile(A, k);
+            check_tile(B, k);
+            if( PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)) == PARSEC_DTD_TILE_OF_KEY(B, B->data_key(B, k, 0)) ) {
+                parsec_fatal( "Tile %d of A and B are the same tile\n", k );
+            }
+        }
+        for( it = 0; it < no_of_iterations; it++ ) {
+            for( k = 0; k < nt; k++ ) {
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_add, 0, PARSEC_DEV_CPU, "Add",
+                                       PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                                       PARSEC_DTD_ARG_END);
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_add, 0, PARSEC_DEV_CPU, "Add",
+                                       PASSED_BY_REF, PARSEC_DTD_TILE_OF_KEY(B, B->data_key(B, k, 0)), PARSEC_INOUT | TILE_FULL | PARSEC_AFFINITY,
+                                       PARSEC_DTD_ARG_END);
+            }
+        }
+        /* The flush removes the tiles from their data collection, the
+         * lookups must be done before. A flush after a wait is only
+         * supported in shared memory. */
+        if( 1 == world ) {
+            for( k = 0; k < nt; k++ ) {
+                parsec_dtd_tile_t *tile = PARSEC_DTD_TILE_OF_KEY(A, A->data_key(A, k, 0));
+                parsec_dtd_insert_task(dtd_tp, call_to_kernel_type_lookup, 0, PARSEC_DEV_CPU, "Lookup",
+                                       sizeof(parsec_data_collection_t *), &A, PARSEC_VALUE,
+                                       sizeof(int), &k, PARSEC_VALUE,
+                                       sizeof(parsec_dtd_tile_t *), &tile, PARSEC_VALUE,
+                                       PARSEC_DTD_ARG_END);
+            }
+            rc = parsec_taskpool_wait( dtd_tp );
+            PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+        }
+        parsec_dtd_data_flush_all( dtd_tp, A );
+        parsec_dtd_data_flush_all( dtd_tp, B );
+        rc = parsec_taskpool_wait( dtd_tp );
+        PARSEC_CHECK_ERROR(rc, "parsec_taskpool_wait");
+    }
+
+    rc = parsec_context_wait(parsec);
+    PARSEC_CHECK_ERROR(rc, "parsec_context_wait");
+
+    for( k = 0; k < nt; k++ ) {
+        parsec_data_key_t key = A->data_key(A, k, 0);
+        if( (int)A->rank_of_key(A, key) != rank ) continue;
+        int *a = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(A->data_of_key(A, key), 0));
+        int *b = PARSEC_DATA_COPY_GET_PTR(parsec_data_get_copy(B->data_of_key(B, key), 0));
+        if( *a != no_of_rounds * no_of_iterations || *b != no_of_rounds * no_of_iterations ) {
+            parsec_fatal( "Tile %d holds %d in A and %d in B instead of %d\n", k, *a, *b,
+                          no_of_rounds * no_of_iterations );
+        }
+    }
+    if( count_error > 0 ) {
+        parsec_fatal( "%d lookups from the workers returned another tile\n\n", count_error );
+    }
+    parsec_output( 0, "Tile cache test passed\n\n" );
+
+    parsec_taskpool_free( dtd_tp );
+
+    parsec_dtd_data_collection_fini( A );
+    parsec_dtd_data_collection_fini( B );
+    free_data(dcA);
+    free_data(dcB);
+
+    parsec_del2arena(adt);
+    PARSEC_OBJ_RELEASE(adt->arena);
+    parsec_dtd_destroy_arena_datatype(parsec, TILE_FULL);
+
+    parsec_fini(&parsec);
+
+#ifdef PARSEC_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return 0;
+}
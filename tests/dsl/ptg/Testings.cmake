@@ -7,3 +7,38 @@ parsec_addtest_cmd(dsl/ptg/startup1 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=10 -
 parsec_addtest_cmd(dsl/ptg/startup2 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=10 -j=20 -k=30 -v=5)
 parsec_addtest_cmd(dsl/ptg/startup3 ${SHM_TEST_CMD_LIST} dsl/ptg/startup -i=30 -j=30 -k=30 -v=5)
 parsec_addtest_cmd(dsl/ptg/strange ${SHM_TEST_CMD_LIST} dsl/ptg/strange)
+parsec_addtest_cmd(dsl/ptg/recv_cache ${SHM_TEST_CMD_LIST} dsl/ptg/recv_cache)
+parsec_addtest_cmd(dsl/ptg/local_count ${SHM_TEST_CMD_LIST} dsl/ptg/local_count)
+parsec_addtest_cmd(dsl/ptg/startup_slices ${SHM_TEST_CMD_LIST} dsl/ptg/startup_slices)
+parsec_addtest_cmd(dsl/ptg/startup_slices3 ${SHM_TEST_CMD_LIST} dsl/ptg/startup_slices -n=20 -c=2)
+set_property(TEST dsl/ptg/startup_slices3 APPEND PROPERTY ENVIRONMENT
+             PARSEC_MCA_task_startup_slices=3;PARSEC_MCA_task_startup_chunk=4)
+parsec_addtest_cmd(dsl/ptg/coarsen ${SHM_TEST_CMD_LIST} dsl/ptg/coarsen -c=1)
+set_property(TEST dsl/ptg/coarsen APPEND PROPERTY ENVIRONMENT
+             PARSEC_MCA_mca_sched=gd;PARSEC_MCA_runtime_keep_highest_priority_task=0)
+parsec_addtest_cmd(dsl/ptg/hoisted_exprs ${SHM_TEST_CMD_LIST} dsl/ptg/hoisted_exprs)
+parsec_addtest_cmd(dsl/ptg/direct_calls ${SHM_TEST_CMD_LIST} dsl/ptg/direct_calls)
+parsec_addtest_cmd(dsl/ptg/single_input ${SHM_TEST_CMD_LIST} dsl/ptg/single_input)
+parsec_addtest_cmd(dsl/ptg/estimate_chain ${SHM_TEST_CMD_LIST} dsl/ptg/estimate_chain)
+parsec_addtest_cmd(dsl/ptg/dense_ranges ${SHM_TEST_CMD_LIST} dsl/ptg/dense_ranges)
+parsec_addtest_cmd(dsl/ptg/profile_guided ${SHM_TEST_CMD_LIST} dsl/ptg/profile_guided)
+parsec_addtest_cmd(dsl/ptg/lazy_dep_pages ${SHM_TEST_CMD_LIST} dsl/ptg/lazy_dep_pages)
+if( MPI_C_FOUND )
+  parsec_addtest_cmd(dsl/ptg/recv_cache:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/recv_cache)
+  set_property(TEST dsl/ptg/recv_cache:mp APPEND PROPERTY ENVIRONMENT
+               PARSEC_MCA_runtime_comm_recv_cache_size=16;PARSEC_MCA_runtime_comm_coll_bcast=0;PARSEC_MCA_runtime_comm_stats=1)
+  parsec_addtest_cmd(dsl/ptg/local_count:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/local_count)
+  parsec_addtest_cmd(dsl/ptg/startup_slices:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/startup_slices)
+  set_property(TEST dsl/ptg/startup_slices:mp APPEND PROPERTY ENVIRONMENT
+               PARSEC_MCA_task_startup_slices=3)
+  parsec_addtest_cmd(dsl/ptg/coarsen:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/coarsen -c=1)
+  set_property(TEST dsl/ptg/coarsen:mp APPEND PROPERTY ENVIRONMENT
+               PARSEC_MCA_mca_sched=gd;PARSEC_MCA_runtime_keep_highest_priority_task=0)
+  parsec_addtest_cmd(dsl/ptg/hoisted_exprs:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/hoisted_exprs)
+  parsec_addtest_cmd(dsl/ptg/direct_calls:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/direct_calls)
+  parsec_addtest_cmd(dsl/ptg/single_input:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/single_input)
+  parsec_addtest_cmd(dsl/ptg/estimate_chain:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/estimate_chain)
+  parsec_addtest_cmd(dsl/ptg/dense_ranges:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/dense_ranges)
+  parsec_addtest_cmd(dsl/ptg/profile_guided:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/profile_guided)
+  parsec_addtest_cmd(dsl/ptg/lazy_dep_pages:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/lazy_dep_pages)
+endif( MPI_C_FOUND )
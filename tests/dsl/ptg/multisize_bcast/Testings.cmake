@@ -1,4 +1,7 @@
 parsec_addtest_cmd(dsl/ptg/multisize_bcast ${SHM_TEST_CMD_LIST} dsl/ptg/multisize_bcast/check_multisize_bcast)
 if( MPI_C_FOUND )
   parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  parsec_addtest_cmd(dsl/ptg/multisize_bcast:mp:hierarchical ${MPI_TEST_CMD_LIST} 4 dsl/ptg/multisize_bcast/check_multisize_bcast)
+  set_property(TEST dsl/ptg/multisize_bcast:mp:hierarchical APPEND PROPERTY ENVIRONMENT
+               PARSEC_MCA_runtime_comm_coll_bcast=3;PARSEC_MCA_mpi_ranks_per_node=2)
 endif( MPI_C_FOUND)
@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+
+"""
+Summarize the tasks of a trace as a profile for parsec-ptgpp --profile.
+
+Each line of the profile gives the name of a task class, its number of
+executions and the mean duration of its tasks, in the time unit of the
+trace (ns by default):
+
+    dpotrf_L::GEMM 5456 1843.2
+
+Usage: ptgpp_profile.py TRACE... [OUTPUT.prof]
+  TRACE is a trace converted to HDF5, or the binary traces of the processes
+  of a run; the profile is printed if no OUTPUT.prof is given.
+"""
+
+import sys
+import parsec_trace_tables as ptt
+import pbt2ptt
+
+if __name__ == '__main__':
+    filenames = [arg for arg in sys.argv[1:] if not arg.endswith('.prof')]
+    outputs = [arg for arg in sys.argv[1:] if arg.endswith('.prof')]
+    if len(filenames) == 0 or len(outputs) > 1:
+        print(__doc__)
+        sys.exit(1)
+
+    if len(filenames) == 1 and ptt.is_ptt(filenames[0]):
+        trace = ptt.from_hdf(filenames[0])
+    else:
+        trace = ptt.from_hdf(pbt2ptt.convert(filenames))
+
+    events = trace.events[trace.events['end'] >= trace.events['begin']]
+    durations = (events['end'] - events['begin']).groupby(events['type'])
+
+    out = open(outputs[0], 'w') if len(outputs) == 1 else sys.stdout
+    out.write('# <task class> <executions> <mean duration>\n')
+    for event_type, duration in durations:
+        name = trace.event_names[event_type]
+        # The tasks of the PTG taskpools are named <taskpool>::<task class>
+        if '::' not in name or name.endswith('internal init'):
+            continue
+        out.write('{} {} {:.1f}\n'.format(name, duration.count(), duration.mean()))
+    if out is not sys.stdout:
+        out.close()